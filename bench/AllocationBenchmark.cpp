@@ -0,0 +1,113 @@
+/*
+ * AllocationBenchmark.cpp
+ * Project
+ * Albin Ågren
+ *
+ * Counts the heap allocations made while the event loop runs a scenario
+ * through the day at log level off, by replacing the global operator new.
+ * Loading and scheduling the first events may allocate. In the event loop
+ * only the event queue, the station pools, the queues of trains waiting
+ * for vehicles and the vehicle history journal may, when they grow past
+ * their largest size so far, which they count themselves. Exits with 1 if
+ * any other allocation is made.
+ *
+ * Usage: AllocationBenchmark [data directory]
+ */
+
+#include "Simulation.h"
+#include "Controller.h"
+#include "Station.h"
+#include "BenchScenario.h"
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <memory>
+#include <vector>
+#include <new>
+#include <cstdlib>
+#include <exception>
+
+namespace {
+
+unsigned long allocations = 0;
+
+}   // namespace
+
+void *operator new(std::size_t size) {
+    ++allocations;
+    if(void *memory = std::malloc(size ? size : 1)) {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void *memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete(void *memory, std::size_t) noexcept {
+    std::free(memory);
+}
+
+int main(int argc, char *argv[]) {
+    std::string directory = argc > 1 ? argv[1] : "../resources/Project/";
+
+    try {
+        Simulation sim;
+        std::unique_ptr<Controller> controller = loadQuiet(sim, directory);
+
+        unsigned long loading = allocations;
+        controller->scheduleAssemblyEvents();
+        unsigned long scheduling = allocations - loading;
+
+        // sum the storage growth the containers count themselves
+        std::vector<std::string> names = controller->getStationNames();
+        auto countGrowth = [&]() {
+            unsigned long growth = 0;
+            Station *station;
+            for(const std::string &name : names) {
+                controller->findStation(name, &station);
+                growth += station->getAllocations();
+            }
+            for(unsigned long day : sim.getAllocationsPerDay()) {
+                growth += day;
+            }
+            return growth + controller->getWaitAllocations() +
+                   controller->getHistoryJournal().getAllocations();
+        };
+        unsigned long growth = countGrowth();
+
+        // run the day the way the batch mode does
+        unsigned long start = allocations;
+        runDay(sim, *controller, Time(23, 59));
+        unsigned long running = allocations - start;
+        unsigned long events = sim.getEventsProcessed();
+        growth = countGrowth() - growth;
+        unsigned long other = running > growth ? running - growth : 0;
+
+        std::cout << std::fixed << std::setprecision(4);
+        std::cout << "Scenario " << directory << ": " << events
+                  << " events" << std::endl
+                  << "Allocations while loading: " << loading << std::endl
+                  << "Allocations while scheduling: " << scheduling
+                  << std::endl
+                  << "Allocations in the event loop: " << running << ", "
+                  << (events ? static_cast<double>(running) / events : 0)
+                  << " per event" << std::endl
+                  << "Growth of the event queue, station pools, wait "
+                  << "queues and history journal: " << growth << std::endl
+                  << "Other allocations: " << other << ", "
+                  << (events ? static_cast<double>(other) / events : 0)
+                  << " per event" << std::endl;
+
+        if(other > 0) {
+            return 1;
+        }
+    } catch(std::exception &e) {
+        std::cout << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,99 @@
+/*
+ * BenchScenario.h
+ * Project
+ * Albin Ågren
+ */
+
+#ifndef DT060G_PROJECT_BENCH_SCENARIO_H
+#define DT060G_PROJECT_BENCH_SCENARIO_H
+
+#include "Simulation.h"
+#include "Controller.h"
+#include "Train.h"
+#include "VehicleTable.h"
+
+#include <memory>
+#include <string>
+
+/**
+ * Function for loading the stations, distances and trains of a scenario
+ * into a controller that logs nothing
+ * Throws std::runtime_error if a data file can not be read
+ *
+ * @param sim, the simulation the controller schedules its events in
+ * @param directory, the directory holding the data files
+ * @return, the loaded controller
+ */
+inline std::unique_ptr<Controller> loadQuiet(Simulation &sim,
+                                             const std::string &directory) {
+    std::unique_ptr<Controller> controller(new Controller(&sim, directory));
+    controller->loadStations();
+    controller->loadDistances();
+    controller->loadTrains();
+    controller->setLogLevel(off);
+    controller->setLogSink(LogSink::none);
+    return controller;
+}
+
+/**
+ * Function for processing the events before a time and moving the
+ * simulation to it, as the simulation menu does
+ *
+ * @param sim, the simulation
+ * @param time, the time to run to
+ */
+inline void runUntil(Simulation &sim, const Time &time) {
+    while(!sim.done() && sim.getNextEventTime() < time) {
+        sim.processNextEvent();
+    }
+    sim.setTime(time);
+}
+
+/**
+ * Function for completing the day as the batch run does: the events before
+ * the end are processed, the running trains finish and the waiting trains
+ * get their last tries
+ *
+ * @param sim, the simulation
+ * @param controller, the controller of the simulation
+ * @param end, the time the day ends
+ */
+inline void runDay(Simulation &sim, Controller &controller, const Time &end) {
+    while(!sim.done() && sim.getNextEventTime() < end) {
+        sim.processNextEvent();
+    }
+    sim.finishRunningTrains();
+    controller.resumeRetries(end);
+}
+
+/**
+ * Function for summing the state of a run into one value, so that two runs
+ * can be checked to end alike
+ *
+ * @param sim, the simulation
+ * @param controller, the controller of the simulation
+ * @return, a hash of the events processed and of every train and vehicle
+ */
+inline unsigned long long fingerprint(const Simulation &sim,
+                                      const Controller &controller) {
+    unsigned long long hash = sim.getEventsProcessed();
+    auto add = [&hash](const long long &value) {
+        hash = (hash ^ static_cast<unsigned long long>(value)) *
+               0x100000001b3ull;
+    };
+    for(unsigned i = 0; i < controller.getNoOfTrains(); ++i) {
+        const Train *train = controller.getTrain(i);
+        add(train->getDelay().getTotalTime());
+        add(train->getCurrentArrival().getTotalTime());
+        add(train->getNoOfVehicles());
+        add(train->getStatus().size());
+    }
+    const VehicleTable &table = controller.getVehicleTable();
+    for(std::size_t row = 0; row < table.size(); ++row) {
+        add(table.getStation(row));
+        add(table.getTrain(row));
+    }
+    return hash;
+}
+
+#endif  // DT060G_PROJECT_BENCH_SCENARIO_H
@@ -0,0 +1,25 @@
+/*
+ * BenchTimer.h
+ * Project
+ * Albin Ågren
+ */
+
+#ifndef DT060G_PROJECT_BENCH_TIMER_H
+#define DT060G_PROJECT_BENCH_TIMER_H
+
+#include <chrono>
+
+// Clock timing the benchmarks
+using Clock = std::chrono::steady_clock;
+
+/**
+ * Function for getting the time passed since a point in time
+ *
+ * @param start, the point in time
+ * @return, the seconds passed since start
+ */
+inline double secondsSince(const Clock::time_point &start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+#endif  // DT060G_PROJECT_BENCH_TIMER_H
@@ -0,0 +1,90 @@
+/*
+ * CheckpointBenchmark.cpp
+ * Project
+ * Albin Ågren
+ *
+ * Times checkpoints of a running simulation. The day is run to a time and
+ * a checkpoint is written, timing how long the run is held up and how long
+ * the file takes in the background. The run is completed, then a second
+ * simulation of the same scenario loads the checkpoint and completes the
+ * day, checking that it ends exactly as the first run did. Generate a
+ * large timetable, e.g. ScenarioGenerator dir --stations 200 --trains
+ * 1000000, to see the costs at scale.
+ *
+ * Usage: CheckpointBenchmark [data directory] [time HH:MM] [file]
+ */
+
+#include "Simulation.h"
+#include "Controller.h"
+#include "BenchTimer.h"
+#include "BenchScenario.h"
+
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <string>
+#include <memory>
+#include <exception>
+
+int main(int argc, char *argv[]) {
+    std::string directory = argc > 1 ? argv[1] : "../resources/Project/";
+    std::string at = argc > 2 ? argv[2] : "12:00";
+    std::string path = argc > 3 ? argv[3] : "checkpoint.bin";
+    Time time(std::stoi(at.substr(0, 2)), std::stoi(at.substr(3, 2)));
+
+    try {
+        Simulation sim;
+        std::unique_ptr<Controller> controller = loadQuiet(sim, directory);
+        controller->scheduleAssemblyEvents();
+        runUntil(sim, time);
+
+        // the run is held up while the snapshot is saved, not while written
+        Clock::time_point start = Clock::now();
+        controller->saveCheckpoint(path);
+        double held = secondsSince(start);
+        start = Clock::now();
+        if(!controller->waitForCheckpoint()) {
+            std::cout << "Error: "
+                      << controller->getCheckpointWriter().getError()
+                      << std::endl;
+            return 1;
+        }
+        double written = secondsSince(start);
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        long long bytes = static_cast<long long>(file.tellg());
+
+        start = Clock::now();
+        runDay(sim, *controller, Time(23, 59));
+        double rest = secondsSince(start);
+        unsigned long long expected = fingerprint(sim, *controller);
+
+        // a second run continues from the file
+        Simulation resumedSim;
+        std::unique_ptr<Controller> resumed = loadQuiet(resumedSim, directory);
+        start = Clock::now();
+        resumed->loadCheckpoint(path);
+        double loaded = secondsSince(start);
+        runDay(resumedSim, *resumed, Time(23, 59));
+        bool matches = fingerprint(resumedSim, *resumed) == expected;
+
+        std::cout << std::fixed << std::setprecision(4)
+                  << "Scenario " << directory << ": "
+                  << controller->getNoOfTrains() << " trains, "
+                  << controller->getVehicleTable().size() << " vehicles"
+                  << std::endl
+                  << "Checkpoint at " << time << ": " << bytes << " bytes"
+                  << std::endl
+                  << "Run held up: " << held << " s" << std::endl
+                  << "Written in background: " << written << " s"
+                  << std::endl
+                  << "Loaded: " << loaded << " s" << std::endl
+                  << "Rest of the day: " << rest << " s" << std::endl
+                  << "Checked: resumed run "
+                  << (matches ? "ends" : "does NOT end")
+                  << " as the first run" << std::endl;
+        return matches ? 0 : 1;
+    } catch(std::exception &e) {
+        std::cout << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,251 @@
+/*
+ * EventBenchmark.cpp
+ * Project
+ * Albin Ågren
+ *
+ * Times the stages of a simulation run on one or more scenarios: loading
+ * the data files, scheduling the assembly events, the event loop at every
+ * log level, every event handler and printing the statistics. Reports mean,
+ * median and 99th percentile over the repetitions and writes the results as
+ * JSON so runs can be compared over time. Generated scenarios can be made
+ * with the ScenarioGenerator tool.
+ *
+ * Usage: EventBenchmark [--repetitions N] [--json FILE] [data directory...]
+ */
+
+#include "Simulation.h"
+#include "Controller.h"
+#include "Event.h"
+#include "MyTime.h"
+#include "BenchTimer.h"
+#include "BenchScenario.h"
+
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <memory>
+#include <vector>
+#include <map>
+#include <algorithm>
+#include <stdexcept>
+
+namespace {
+
+const char *const EVENT_NAMES[] = {
+    "assembly", "ready", "departure", "arrival", "disassembly"
+};
+
+const char *const LOG_LEVEL_NAMES[] = { "off", "low", "high" };
+
+/*
+ * Samples of a single measurement, one per repetition
+ */
+struct Samples {
+    std::string unit;
+    std::vector<double> values;
+
+    double mean() const {
+        double sum = 0;
+        for(const double &value : values) {
+            sum += value;
+        }
+        return values.empty() ? 0 : sum / values.size();
+    }
+
+    double percentile(const double &share) const {
+        if(values.empty()) {
+            return 0;
+        }
+        std::vector<double> sorted = values;
+        std::sort(sorted.begin(), sorted.end());
+        std::size_t index = static_cast<std::size_t>(share *
+                                                     (sorted.size() - 1) + 0.5);
+        return sorted[index];
+    }
+};
+
+// Measurements of a scenario by name, in the order they were first taken
+struct Results {
+    std::vector<std::string> order;
+    std::map<std::string, Samples> samples;
+
+    void add(const std::string &name, const std::string &unit,
+             const double &value) {
+        if(samples.count(name) == 0) {
+            order.push_back(name);
+            samples[name].unit = unit;
+        }
+        samples[name].values.push_back(value);
+    }
+};
+
+/*
+ * Runs the simulation of a scenario once at a log level and adds the
+ * timings, the log is written to a discarded stream
+ */
+void runOnce(const std::string &directory, const LogLevel &logLevel,
+             Results &results) {
+    std::ostringstream discarded;
+    std::streambuf *coutBuffer = std::cout.rdbuf(discarded.rdbuf());
+
+    Simulation sim;
+    Controller controller(&sim, directory);
+
+    // startup
+    Clock::time_point start = Clock::now();
+    controller.loadStations();
+    double stations = secondsSince(start);
+    start = Clock::now();
+    controller.loadDistances();
+    double distances = secondsSince(start);
+    start = Clock::now();
+    controller.loadTrains();
+    double trains = secondsSince(start);
+    start = Clock::now();
+    controller.scheduleAssemblyEvents();
+    double schedule = secondsSince(start);
+    controller.setLogLevel(logLevel);
+
+    // event loop
+    Time endTime(23, 59);
+    start = Clock::now();
+    runDay(sim, controller, endTime);
+    double loop = secondsSince(start);
+    unsigned long events = sim.getEventsProcessed();
+
+    start = Clock::now();
+    controller.printStatistics(endTime);
+    double statistics = secondsSince(start);
+
+    std::cout.rdbuf(coutBuffer);
+
+    // the startup does not depend on the log level, time it once per run
+    if(logLevel == off) {
+        results.add("loadStations", "ms", stations * 1e3);
+        results.add("loadDistances", "ms", distances * 1e3);
+        results.add("loadTrains", "ms", trains * 1e3);
+        results.add("scheduleAssemblyEvents", "ms", schedule * 1e3);
+        results.add("printStatistics", "ms", statistics * 1e3);
+    }
+    std::string level = LOG_LEVEL_NAMES[logLevel];
+    results.add("eventLoop." + level, "ms", loop * 1e3);
+    results.add("eventRate." + level, "events/s",
+                loop > 0 ? events / loop : 0);
+}
+
+/*
+ * Runs the simulation of a scenario once without logging, timing every
+ * event separately, and adds the mean time per event type
+ */
+void runHandlers(const std::string &directory, Results &results) {
+    Simulation sim;
+    std::unique_ptr<Controller> controller = loadQuiet(sim, directory);
+    controller->scheduleAssemblyEvents();
+
+    double seconds[5] = { 0, 0, 0, 0, 0 };
+    unsigned long counts[5] = { 0, 0, 0, 0, 0 };
+    Time endTime(23, 59);
+    while(!sim.done() && sim.getNextEventTime() < endTime) {
+        int type = static_cast<int>(sim.getNextEvent().type);
+        Clock::time_point start = Clock::now();
+        sim.processNextEvent();
+        seconds[type] += secondsSince(start);
+        ++counts[type];
+    }
+
+    for(int type = 0; type < 5; ++type) {
+        results.add(std::string("handler.") + EVENT_NAMES[type], "ns/event",
+                    counts[type] > 0 ? seconds[type] / counts[type] * 1e9
+                                     : 0);
+    }
+}
+
+std::string escape(const std::string &str) {
+    std::string escaped;
+    for(const char &c : str) {
+        if(c == '"' || c == '\\') {
+            escaped += '\\';
+        }
+        escaped += c;
+    }
+    return escaped;
+}
+
+}   // namespace
+
+int main(int argc, char *argv[]) {
+    int repetitions = 10;
+    std::string jsonFile = "EventBenchmark.json";
+    std::vector<std::string> directories;
+    for(int i = 1; i < argc; ++i) {
+        std::string argument = argv[i];
+        if(argument == "--repetitions" && i + 1 < argc) {
+            repetitions = std::max(1, std::stoi(argv[++i]));
+        } else if(argument == "--json" && i + 1 < argc) {
+            jsonFile = argv[++i];
+        } else {
+            directories.push_back(argument);
+        }
+    }
+    if(directories.empty()) {
+        directories.push_back("../resources/Project/");
+    }
+
+    std::ofstream json(jsonFile);
+    if(json.fail()) {
+        std::cout << "Error: " << jsonFile << " failed to open" << std::endl;
+        return 1;
+    }
+    json << std::setprecision(6) << "{\"repetitions\": " << repetitions
+         << ", \"scenarios\": [";
+
+    std::cout << std::fixed << std::setprecision(3);
+    try {
+        for(std::size_t d = 0; d < directories.size(); ++d) {
+            const std::string &directory = directories[d];
+            Results results;
+
+            for(int i = 0; i < repetitions; ++i) {
+                runOnce(directory, off, results);
+                runOnce(directory, low, results);
+                runOnce(directory, high, results);
+                runHandlers(directory, results);
+            }
+
+            std::cout << "Scenario " << directory << ", " << repetitions
+                      << " repetitions" << std::endl
+                      << std::setw(26) << "" << std::setw(14) << "mean"
+                      << std::setw(14) << "p50" << std::setw(14) << "p99"
+                      << std::endl;
+            json << (d > 0 ? ", " : "") << "{\"directory\": \""
+                 << escape(directory) << "\", \"results\": {";
+
+            for(std::size_t i = 0; i < results.order.size(); ++i) {
+                const std::string &name = results.order[i];
+                const Samples &samples = results.samples[name];
+                std::cout << std::setw(26) << name
+                          << std::setw(14) << samples.mean()
+                          << std::setw(14) << samples.percentile(0.5)
+                          << std::setw(14) << samples.percentile(0.99)
+                          << " " << samples.unit << std::endl;
+                json << (i > 0 ? ", " : "") << "\"" << name
+                     << "\": {\"unit\": \"" << samples.unit
+                     << "\", \"mean\": " << samples.mean()
+                     << ", \"p50\": " << samples.percentile(0.5)
+                     << ", \"p99\": " << samples.percentile(0.99) << "}";
+            }
+            json << "}}";
+            std::cout << std::endl;
+        }
+    } catch(std::runtime_error &re) {
+        std::cout << "Error: " << re.what() << std::endl;
+        return 1;
+    }
+
+    json << "]}" << std::endl;
+    std::cout << "Results written to " << jsonFile << std::endl;
+
+    return 0;
+}
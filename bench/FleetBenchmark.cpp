@@ -0,0 +1,170 @@
+/*
+ * FleetBenchmark.cpp
+ * Project
+ * Albin Ågren
+ *
+ * Times sums of vehicle attributes over the fleet and per station, reading
+ * the columns of the controller's vehicle table compared with calling the
+ * virtual getters through a pointer per vehicle, and checks that both give
+ * the same totals. Use a generated scenario to see the difference at scale.
+ *
+ * Usage: FleetBenchmark [data directory] [repetitions]
+ */
+
+#include "Simulation.h"
+#include "Controller.h"
+#include "Station.h"
+#include "Vehicle.h"
+#include "VehicleTable.h"
+#include "BenchTimer.h"
+#include "BenchScenario.h"
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <memory>
+#include <vector>
+#include <exception>
+
+namespace {
+
+// Sum the attributes of a vehicle through its virtual getters
+void addVehicle(FleetTotals &totals, const Vehicle *vehicle) {
+    ++totals.vehicles;
+    totals.seats += vehicle->getNoOfSeats();
+    totals.beds += vehicle->getNoOfBeds();
+    totals.cargoCapacity += vehicle->getCargoCapacity();
+    totals.cargoArea += vehicle->getCargoArea();
+    totals.cargoVolume += vehicle->getCargoVolume();
+    totals.power += vehicle->getPower();
+}
+
+bool operator==(const FleetTotals &left, const FleetTotals &right) {
+    return left.vehicles == right.vehicles && left.seats == right.seats &&
+           left.beds == right.beds &&
+           left.cargoCapacity == right.cargoCapacity &&
+           left.cargoArea == right.cargoArea &&
+           left.cargoVolume == right.cargoVolume &&
+           left.power == right.power;
+}
+
+}   // namespace
+
+int main(int argc, char *argv[]) {
+    std::string directory = argc > 1 ? argv[1] : "../resources/Project/";
+    int repetitions = argc > 2 ? std::stoi(argv[2]) : 100;
+
+    try {
+        Simulation sim;
+        std::unique_ptr<Controller> controller = loadQuiet(sim, directory);
+
+        // gather the vehicles through the station pools, as the objects
+        // would be reached without the table
+        std::vector<const Vehicle *> vehicles;
+        std::vector<std::string> names = controller->getStationNames();
+        Station *station;
+        for(const std::string &name : names) {
+            controller->findStation(name, &station);
+            for(const Vehicle *vehicle : station->getVehicles()) {
+                vehicles.push_back(vehicle);
+            }
+        }
+        const VehicleTable &table = controller->getVehicleTable();
+        unsigned stations = names.size();
+
+        FleetTotals objectFleet = { }, tableFleet = { };
+        Clock::time_point start = Clock::now();
+        for(int r = 0; r < repetitions; ++r) {
+            objectFleet = { };
+            for(const Vehicle *vehicle : vehicles) {
+                addVehicle(objectFleet, vehicle);
+            }
+        }
+        double objectFleetTime = secondsSince(start);
+
+        start = Clock::now();
+        for(int r = 0; r < repetitions; ++r) {
+            tableFleet = table.getTotals();
+        }
+        double tableFleetTime = secondsSince(start);
+
+        // totals of every station pool
+        std::vector<FleetTotals> objectPools, tablePools;
+        start = Clock::now();
+        for(int r = 0; r < repetitions; ++r) {
+            objectPools.assign(stations, { });
+            for(const Vehicle *vehicle : vehicles) {
+                addVehicle(objectPools[vehicle->getStation()->getId()],
+                           vehicle);
+            }
+        }
+        double objectPoolTime = secondsSince(start);
+
+        start = Clock::now();
+        for(int r = 0; r < repetitions; ++r) {
+            tablePools = table.getTotalsPerStation(stations);
+        }
+        double tablePoolTime = secondsSince(start);
+
+        // a single station pool, masked over the whole table
+        FleetTotals objectPool = { }, tablePool = { };
+        unsigned last = stations - 1;
+        start = Clock::now();
+        for(int r = 0; r < repetitions; ++r) {
+            objectPool = { };
+            for(const Vehicle *vehicle : vehicles) {
+                if(vehicle->getStation()->getId() == last) {
+                    addVehicle(objectPool, vehicle);
+                }
+            }
+        }
+        double objectStationTime = secondsSince(start);
+
+        start = Clock::now();
+        for(int r = 0; r < repetitions; ++r) {
+            tablePool = table.getStationTotals(last);
+        }
+        double tableStationTime = secondsSince(start);
+
+        bool identical = objectFleet == tableFleet &&
+                         objectPool == tablePool &&
+                         objectPools.size() == tablePools.size();
+        for(unsigned i = 0; identical && i < stations; ++i) {
+            identical = objectPools[i] == tablePools[i];
+        }
+
+        std::cout << std::fixed << std::setprecision(3);
+        std::cout << "Scenario " << directory << ": " << vehicles.size()
+                  << " vehicles at " << stations << " stations, "
+                  << tableFleet.seats << " seats, "
+                  << tableFleet.cargoCapacity << " tons" << std::endl
+                  << "Table memory: "
+                  << table.getMemoryUsage() / 1048576.0 << " MiB"
+                  << std::endl
+                  << std::setw(16) << "" << std::setw(14) << "objects (ms)"
+                  << std::setw(14) << "table (ms)" << std::endl
+                  << std::setw(16) << "Fleet totals"
+                  << std::setw(14) << objectFleetTime * 1e3 / repetitions
+                  << std::setw(14) << tableFleetTime * 1e3 / repetitions
+                  << std::endl
+                  << std::setw(16) << "Per station"
+                  << std::setw(14) << objectPoolTime * 1e3 / repetitions
+                  << std::setw(14) << tablePoolTime * 1e3 / repetitions
+                  << std::endl
+                  << std::setw(16) << "One station"
+                  << std::setw(14) << objectStationTime * 1e3 / repetitions
+                  << std::setw(14) << tableStationTime * 1e3 / repetitions
+                  << std::endl
+                  << "Totals " << (identical ? "identical" : "differ")
+                  << std::endl;
+
+        if(!identical) {
+            return 1;
+        }
+    } catch(std::exception &e) {
+        std::cout << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
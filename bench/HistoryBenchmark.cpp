@@ -0,0 +1,112 @@
+/*
+ * HistoryBenchmark.cpp
+ * Project
+ * Albin Ågren
+ *
+ * Runs a scenario through the day and reports the memory held by the
+ * vehicle history journal per event, compared with the memory the same
+ * history takes as one string per event in a vector per vehicle, as history
+ * used to be kept. Also times rendering the history of every vehicle.
+ *
+ * Usage: HistoryBenchmark [data directory]
+ */
+
+#include "Simulation.h"
+#include "Controller.h"
+#include "Station.h"
+#include "Train.h"
+#include "Vehicle.h"
+#include "HistoryJournal.h"
+#include "BenchTimer.h"
+#include "BenchScenario.h"
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <memory>
+#include <vector>
+#include <exception>
+
+namespace {
+
+// Bytes held by a string, counting the heap buffer beyond the small string
+std::size_t stringBytes(const std::string &text) {
+    std::size_t bytes = sizeof(std::string);
+    if(text.capacity() > std::string().capacity()) {
+        bytes += text.capacity() + 1;
+    }
+    return bytes;
+}
+
+}   // namespace
+
+int main(int argc, char *argv[]) {
+    std::string directory = argc > 1 ? argv[1] : "../resources/Project/";
+
+    try {
+        Simulation sim;
+        std::unique_ptr<Controller> controller = loadQuiet(sim, directory);
+        controller->scheduleAssemblyEvents();
+
+        Clock::time_point start = Clock::now();
+        runDay(sim, *controller, Time(23, 59));
+        double runTime = secondsSince(start);
+
+        // gather the vehicles from the station pools and the trains
+        std::vector<const Vehicle *> vehicles;
+        Station *station;
+        for(const std::string &name : controller->getStationNames()) {
+            controller->findStation(name, &station);
+            for(const Vehicle *vehicle : station->getVehicles()) {
+                vehicles.push_back(vehicle);
+            }
+        }
+        for(unsigned i = 0; i < controller->getNoOfTrains(); ++i) {
+            for(const Vehicle *vehicle :
+                                controller->getTrain(i)->getVehicles()) {
+                vehicles.push_back(vehicle);
+            }
+        }
+
+        // render every history, keeping it as the strings held before
+        std::size_t events = 0, stringTotal = 0;
+        start = Clock::now();
+        for(const Vehicle *vehicle : vehicles) {
+            std::vector<std::string> history = vehicle->getHistory();
+            events += history.size();
+            stringTotal += sizeof(std::vector<std::string>) +
+                           (history.capacity() - history.size()) *
+                           sizeof(std::string);
+            for(const std::string &event : history) {
+                stringTotal += stringBytes(event);
+            }
+        }
+        double renderTime = secondsSince(start);
+
+        const HistoryJournal &journal = controller->getHistoryJournal();
+        std::size_t journalTotal = journal.getMemoryUsage();
+        std::size_t journalHeld = journal.getMemoryHeld();
+        double perEvent = events ? 1.0 / events : 0;
+
+        std::cout << std::fixed << std::setprecision(1);
+        std::cout << "Scenario " << directory << ": " << vehicles.size()
+                  << " vehicles, " << events << " events in "
+                  << runTime << " s" << std::endl
+                  << "Strings: " << stringTotal / 1048576.0 << " MiB, "
+                  << stringTotal * perEvent << " bytes per event"
+                  << std::endl
+                  << "Journal: " << journalTotal / 1048576.0 << " MiB, "
+                  << journalTotal * perEvent << " bytes per event, "
+                  << journal.size() << " records, "
+                  << journalHeld / 1048576.0 << " MiB held with room to grow"
+                  << std::endl
+                  << "Rendering all history: " << renderTime * 1e3 << " ms, "
+                  << renderTime * 1e9 * perEvent << " ns per event"
+                  << std::endl;
+    } catch(std::exception &e) {
+        std::cout << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
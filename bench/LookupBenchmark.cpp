@@ -0,0 +1,151 @@
+/*
+ * LookupBenchmark.cpp
+ * Project
+ * Albin Ågren
+ *
+ * Times loading a scenario, finding stations, trains and vehicles through
+ * the controller's indices, compared with scanning the trains in load order
+ * as the lookups used to, and looking up the distance each train travels.
+ * Use a generated scenario to see the difference at scale.
+ *
+ * Usage: LookupBenchmark [data directory] [lookups]
+ */
+
+#include "Simulation.h"
+#include "Controller.h"
+#include "Station.h"
+#include "Train.h"
+#include "Vehicle.h"
+#include "DistanceTable.h"
+#include "BenchTimer.h"
+#include "BenchScenario.h"
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <memory>
+#include <vector>
+#include <random>
+#include <stdexcept>
+#include <exception>
+
+namespace {
+
+}   // namespace
+
+int main(int argc, char *argv[]) {
+    std::string directory = argc > 1 ? argv[1] : "../resources/Project/";
+    std::size_t lookups = argc > 2 ? std::stoul(argv[2]) : 1000000;
+
+    try {
+        Simulation sim;
+        Clock::time_point start = Clock::now();
+        std::unique_ptr<Controller> controller = loadQuiet(sim, directory);
+        double load = secondsSince(start);
+
+        // pick the keys to look up at random from the loaded system
+        std::vector<std::string> names = controller->getStationNames();
+        std::vector<int> trainNumbers, vehicleIds;
+        for(unsigned i = 0; i < controller->getNoOfTrains(); ++i) {
+            trainNumbers.push_back(controller->getTrain(i)->getTrainNumber());
+        }
+        Station *station;
+        for(const std::string &name : names) {
+            controller->findStation(name, &station);
+            for(const Vehicle *vehicle : station->getVehicles()) {
+                vehicleIds.push_back(vehicle->getId());
+            }
+        }
+        if(names.empty() || trainNumbers.empty() || vehicleIds.empty()) {
+            throw std::runtime_error("scenario has no stations, trains "
+                                     "or vehicles");
+        }
+
+        std::mt19937 generator(42);
+        std::vector<std::size_t> stationKeys(lookups), trainKeys(lookups),
+                                 vehicleKeys(lookups);
+        for(std::size_t i = 0; i < lookups; ++i) {
+            stationKeys[i] = generator() % names.size();
+            trainKeys[i] = generator() % trainNumbers.size();
+            vehicleKeys[i] = generator() % vehicleIds.size();
+        }
+
+        unsigned long found = 0;
+        Train *train;
+        Vehicle *vehicle;
+
+        start = Clock::now();
+        for(const std::size_t &key : stationKeys) {
+            found += controller->findStation(names[key], &station);
+        }
+        double stationTime = secondsSince(start);
+
+        start = Clock::now();
+        for(const std::size_t &key : trainKeys) {
+            found += controller->findTrain(trainNumbers[key], &train);
+        }
+        double trainTime = secondsSince(start);
+
+        start = Clock::now();
+        for(const std::size_t &key : vehicleKeys) {
+            found += controller->findVehicle(vehicleIds[key], &vehicle);
+        }
+        double vehicleTime = secondsSince(start);
+
+        const DistanceTable &distances = controller->getDistanceTable();
+        std::vector<const Train *> trains;
+        for(const std::size_t &key : trainKeys) {
+            trains.push_back(controller->getTrain(key));
+        }
+        double distanceSum = 0;
+        start = Clock::now();
+        for(const Train *trainPtr : trains) {
+            distanceSum += controller->getDistance(trainPtr->getOrigin(),
+                                                  trainPtr->getDestination());
+        }
+        double distanceTime = secondsSince(start);
+        found += distanceSum > 0;
+
+        // the earlier linear scan over the trains, on fewer lookups
+        std::size_t scans = std::min<std::size_t>(lookups, 10000);
+        start = Clock::now();
+        for(std::size_t i = 0; i < scans; ++i) {
+            for(unsigned j = 0; j < controller->getNoOfTrains(); ++j) {
+                if(controller->getTrain(j)->getTrainNumber() ==
+                   trainNumbers[trainKeys[i]]) {
+                    ++found;
+                    break;
+                }
+            }
+        }
+        double scanTime = secondsSince(start);
+
+        std::cout << std::fixed << std::setprecision(1);
+        std::cout << "Scenario " << directory << ": " << names.size()
+                  << " stations, " << trainNumbers.size() << " trains, "
+                  << vehicleIds.size() << " vehicles" << std::endl
+                  << "Loading: " << load * 1e3 << " ms" << std::endl
+                  << "Distance table: " << (distances.isDense() ? "matrix"
+                                                                : "rows")
+                  << ", " << distances.getNoOfDistances() << " distances in "
+                  << distances.getMemoryUsage() / 1024.0 << " KiB"
+                  << std::endl
+                  << "getDistance: " << distanceTime * 1e9 / lookups << " ns"
+                  << std::endl
+                  << "findStation: " << stationTime * 1e9 / lookups
+                  << " ns" << std::endl
+                  << "findTrain: " << trainTime * 1e9 / lookups << " ns"
+                  << std::endl
+                  << "findVehicle: " << vehicleTime * 1e9 / lookups
+                  << " ns" << std::endl
+                  << "Linear train scan: " << scanTime * 1e9 / scans
+                  << " ns" << std::endl
+                  << "Found " << found << " of " << 3 * lookups + scans + 1
+                  << std::endl;
+    } catch(std::exception &e) {
+        std::cout << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
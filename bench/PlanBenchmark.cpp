@@ -0,0 +1,107 @@
+/*
+ * PlanBenchmark.cpp
+ * Project
+ * Albin Ågren
+ *
+ * Runs a scenario through the day once with trains taking the first
+ * vehicles they find and once with the vehicles planned for the whole
+ * timetable beforehand. Reports the time spent planning, the trains planned
+ * and the rounds and solver phases it took, and for each run the trains on
+ * time, delayed and never assembled and their total delays.
+ *
+ * Usage: PlanBenchmark [data directory] [end time HH:MM]
+ */
+
+#include "Simulation.h"
+#include "Controller.h"
+#include "VehiclePlan.h"
+#include "MyTime.h"
+#include "BenchTimer.h"
+#include "BenchScenario.h"
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <memory>
+#include <exception>
+
+namespace {
+
+// Struct holding what one run measured
+struct Result {
+    double planSeconds;
+    double runSeconds;
+    unsigned planned;
+    unsigned rounds;
+    unsigned long phases;
+    unsigned trains;
+    TrainStatistics statistics;
+};
+
+Result measureDay(const std::string &directory, const bool &plan,
+                  const Time &endTime) {
+    Simulation sim;
+    std::unique_ptr<Controller> controller = loadQuiet(sim, directory);
+
+    Result result = { 0, 0, 0, 0, 0, controller->getNoOfTrains(), {} };
+    Clock::time_point start = Clock::now();
+    if(plan) {
+        controller->planVehicles();
+        controller->setFollowPlan(true);
+        result.planSeconds = secondsSince(start);
+        result.planned = controller->getVehiclePlan().getNoOfPlannedTrains();
+        result.rounds = controller->getVehiclePlan().getRounds();
+        result.phases = controller->getVehiclePlan().getPhases();
+    }
+    controller->scheduleAssemblyEvents();
+
+    start = Clock::now();
+    runDay(sim, *controller, endTime);
+    result.runSeconds = secondsSince(start);
+    result.statistics = controller->getStatistics(endTime);
+    return result;
+}
+
+void printRun(const std::string &name, const Result &result) {
+    const TrainStatistics &statistics = result.statistics;
+    std::cout << std::left << std::setw(8) << name << std::right
+              << statistics.onTime << " on time, " << statistics.delayed
+              << " delayed, " << statistics.failed << " failed, delays "
+              << statistics.departureDelay.getTotalTime()
+              << " min departing, "
+              << statistics.arrivalDelay.getTotalTime()
+              << " min arriving, " << result.runSeconds << " s"
+              << std::endl;
+}
+
+}   // namespace
+
+int main(int argc, char *argv[]) {
+    std::string directory = argc > 1 ? argv[1] : "../resources/Project/";
+    Time endTime(23, 59);
+    if(argc > 2) {
+        std::string end = argv[2];
+        std::size_t colon = end.find(':');
+        endTime = Time(std::stoi(end.substr(0, colon)),
+                       std::stoi(end.substr(colon + 1)));
+    }
+
+    try {
+        Result greedy = measureDay(directory, false, endTime);
+        Result planned = measureDay(directory, true, endTime);
+
+        std::cout << std::fixed << std::setprecision(4)
+                  << "Scenario " << directory << " until " << endTime
+                  << ": " << greedy.trains << " trains" << std::endl
+                  << "Plan: " << planned.planned << " trains planned in "
+                  << planned.rounds << " rounds, " << planned.phases
+                  << " phases, " << planned.planSeconds << " s" << std::endl;
+        printRun("Greedy", greedy);
+        printRun("Planned", planned);
+    } catch(std::exception &e) {
+        std::cout << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,214 @@
+/*
+ * QueueBenchmark.cpp
+ * Project
+ * Albin Ågren
+ *
+ * Compares the event queue implementations, first by running the complete
+ * simulation on the shipped scenario and then by replaying the train event
+ * lifecycle for large generated timetables directly against the queues.
+ *
+ * Usage: QueueBenchmark [data directory] [repetitions]
+ */
+
+#include "Simulation.h"
+#include "Controller.h"
+#include "EventQueue.h"
+#include "MyTime.h"
+#include "BenchTimer.h"
+#include "BenchScenario.h"
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <memory>
+#include <random>
+#include <stdexcept>
+
+namespace {
+
+struct QueueCase {
+    QueueType type;
+    std::string name;
+};
+
+const std::vector<QueueCase> QUEUE_CASES = {
+    { binaryHeap, "binary heap" },
+    { quaternaryHeap, "4-ary heap" },
+    { calendar, "calendar" }
+};
+
+std::unique_ptr<EventQueue> makeQueue(const QueueType &type) {
+    switch(type) {
+        case quaternaryHeap:
+            return std::make_unique<HeapEventQueue<4>>();
+        case calendar:
+            return std::make_unique<CalendarEventQueue>();
+        case binaryHeap:
+        default:
+            return std::make_unique<HeapEventQueue<2>>();
+    }
+}
+
+/*
+ * Runs the complete simulation once and returns the printed statistics,
+ * the elapsed time and the number of processed events
+ */
+std::string runScenario(const QueueType &type, const std::string &directory,
+                        double &seconds, unsigned long &events) {
+    Simulation sim(type);
+    std::unique_ptr<Controller> controller = loadQuiet(sim, directory);
+
+    auto start = Clock::now();
+    controller->scheduleAssemblyEvents();
+    Time endTime(23, 59);
+    runDay(sim, *controller, endTime);
+    seconds = secondsSince(start);
+    events = sim.getEventsProcessed();
+
+    // capture the statistics so the queues can be checked against each other
+    std::ostringstream statistics;
+    std::streambuf *coutBuffer = std::cout.rdbuf(statistics.rdbuf());
+    controller->printStatistics(endTime);
+    std::cout.rdbuf(coutBuffer);
+
+    return statistics.str();
+}
+
+Event makeEvent(const EventType &type, const int &time, const int &train) {
+    Event event;
+    event.type = type;
+    event.time = time;
+    event.trainNumber = train;
+    event.train = train;
+    return event;
+}
+
+/*
+ * Replays the assembly, ready, departure, arrival and disassembly events of
+ * a generated timetable, returns a checksum of the order events were popped
+ */
+unsigned long replayTimetable(EventQueue &queue,
+                              const std::vector<int> &departures,
+                              const std::vector<int> &travelTimes,
+                              unsigned long &events) {
+    for(std::size_t train = 0; train < departures.size(); ++train) {
+        queue.push(makeEvent(EventType::assembly, departures[train] - 30,
+                             train));
+    }
+
+    unsigned long checksum = 0;
+    events = 0;
+    while(!queue.empty()) {
+        Event event = queue.top();
+        queue.pop();
+        ++events;
+        checksum = checksum * 31 + event.train;
+
+        switch(event.type) {
+            case EventType::assembly:
+                queue.push(makeEvent(EventType::ready, event.time + 20,
+                                     event.train));
+                break;
+            case EventType::ready:
+                queue.push(makeEvent(EventType::departure, event.time + 10,
+                                     event.train));
+                break;
+            case EventType::departure:
+                queue.push(makeEvent(EventType::arrival,
+                                     event.time + travelTimes[event.train],
+                                     event.train));
+                break;
+            case EventType::arrival:
+                queue.push(makeEvent(EventType::disassembly, event.time + 20,
+                                     event.train));
+                break;
+            case EventType::disassembly:
+                break;
+        }
+    }
+    return checksum;
+}
+
+}   // namespace
+
+int main(int argc, char *argv[]) {
+    std::string directory = argc > 1 ? argv[1] : "../resources/";
+    int repetitions = argc > 2 ? std::stoi(argv[2]) : 5;
+
+    std::cout << std::fixed << std::setprecision(3);
+
+    // complete simulation of the shipped scenario
+    std::cout << "Shipped scenario (" << directory << "), best of "
+              << repetitions << " runs" << std::endl;
+    std::string reference;
+    for(const QueueCase &queueCase : QUEUE_CASES) {
+        double best = 0, seconds;
+        unsigned long events = 0;
+        std::string statistics;
+        try {
+            for(int i = 0; i < repetitions; ++i) {
+                statistics = runScenario(queueCase.type, directory, seconds,
+                                         events);
+                if(i == 0 || seconds < best) {
+                    best = seconds;
+                }
+            }
+        } catch(std::runtime_error &re) {
+            std::cout << "Error: " << re.what() << std::endl;
+            return 1;
+        }
+
+        if(reference.empty()) {
+            reference = statistics;
+        }
+        std::cout << std::setw(12) << queueCase.name << ": "
+                  << best * 1e3 << " ms, " << events << " events, "
+                  << events / best / 1e6 << " Mevents/s, statistics "
+                  << (statistics == reference ? "identical" : "DIFFER")
+                  << std::endl;
+    }
+
+    // replay of generated timetables of increasing size
+    std::mt19937 generator(2024);
+    std::uniform_int_distribution<int> departure(30, 23 * 60);
+    std::uniform_int_distribution<int> travel(15, 240);
+    for(std::size_t trains : { 10000, 100000, 1000000 }) {
+        std::vector<int> departures(trains), travelTimes(trains);
+        for(std::size_t train = 0; train < trains; ++train) {
+            departures[train] = departure(generator);
+            travelTimes[train] = travel(generator);
+        }
+
+        std::cout << std::endl << "Generated timetable, " << trains
+                  << " trains" << std::endl;
+        unsigned long referenceChecksum = 0;
+        for(const QueueCase &queueCase : QUEUE_CASES) {
+            double best = 0;
+            unsigned long events = 0, checksum = 0;
+            for(int i = 0; i < repetitions; ++i) {
+                std::unique_ptr<EventQueue> queue = makeQueue(queueCase.type);
+                auto start = Clock::now();
+                checksum = replayTimetable(*queue, departures, travelTimes,
+                                           events);
+                double seconds = secondsSince(start);
+                if(i == 0 || seconds < best) {
+                    best = seconds;
+                }
+            }
+
+            if(queueCase.type == binaryHeap) {
+                referenceChecksum = checksum;
+            }
+            std::cout << std::setw(12) << queueCase.name << ": "
+                      << best * 1e3 << " ms, " << events << " events, "
+                      << events / best / 1e6 << " Mevents/s, order "
+                      << (checksum == referenceChecksum ? "identical"
+                                                        : "DIFFERS")
+                      << std::endl;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,120 @@
+/*
+ * RecordBenchmark.cpp
+ * Project
+ * Albin Ågren
+ *
+ * Runs a scenario through the day once with no output, then with the text
+ * log at the low and high levels written to the log file only, then with the
+ * event records as JSON Lines and as CSV. Reports the time of each run, the
+ * bytes written and the cost of the output per train transition over the run
+ * without output. The records are written next to the log file.
+ *
+ * Usage: RecordBenchmark [data directory]
+ */
+
+#include "Simulation.h"
+#include "Controller.h"
+#include "RecordWriter.h"
+#include "Logger.h"
+#include "BenchTimer.h"
+#include "BenchScenario.h"
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <memory>
+#include <vector>
+#include <filesystem>
+#include <exception>
+#include <stdexcept>
+
+namespace {
+
+// Struct describing the output of one run
+struct Output {
+    std::string name;
+    LogLevel logLevel;
+    bool records;
+    RecordFormat format;
+    std::string file;
+};
+
+// Struct holding what one run measured
+struct Result {
+    double seconds;
+    unsigned long transitions;
+    unsigned long long bytes;
+};
+
+Result measureDay(const std::string &directory, const Output &output) {
+    Result result = { 0, 0, 0 };
+    {
+        Simulation sim;
+        std::unique_ptr<Controller> controller = loadQuiet(sim, directory);
+        controller->scheduleAssemblyEvents();
+        controller->setLogLevel(output.logLevel);
+        controller->setLogSink(LogSink::file);
+        if(output.records &&
+           !controller->openRecords(directory + output.file, output.format)) {
+            throw std::runtime_error("record file failed to open");
+        }
+
+        Clock::time_point start = Clock::now();
+        runDay(sim, *controller, Time(23, 59));
+        controller->flushLog();
+        controller->closeRecords();
+        result.seconds = secondsSince(start);
+        result.transitions = controller->getRecordWriter().getRecords();
+    }
+    if(!output.file.empty()) {
+        result.bytes = std::filesystem::file_size(directory + output.file);
+    }
+    return result;
+}
+
+}   // namespace
+
+int main(int argc, char *argv[]) {
+    std::string directory = argc > 1 ? argv[1] : "../resources/Project/";
+
+    const std::vector<Output> outputs = {
+        { "none", off, false, RecordFormat::jsonl, "" },
+        { "text low", low, false, RecordFormat::jsonl, "Trainsim.log" },
+        { "text high", high, false, RecordFormat::jsonl, "Trainsim.log" },
+        { "jsonl", off, true, RecordFormat::jsonl, "Trainsim.jsonl" },
+        { "csv", off, true, RecordFormat::csv, "Trainsim.csv" }
+    };
+
+    try {
+        std::vector<Result> results;
+        for(const Output &output : outputs) {
+            results.push_back(measureDay(directory, output));
+        }
+
+        // every run makes the same transitions, the record runs count them
+        unsigned long transitions = results.back().transitions;
+        double baseline = results.front().seconds;
+
+        std::cout << std::fixed << std::setprecision(4)
+                  << "Scenario " << directory << ": " << transitions
+                  << " train transitions" << std::endl;
+        for(std::size_t i = 0; i < outputs.size(); ++i) {
+            const Result &result = results[i];
+            double extra = result.seconds > baseline
+                         ? result.seconds - baseline : 0;
+            std::cout << std::left << std::setw(10) << outputs[i].name
+                      << std::right << " " << result.seconds << " s, "
+                      << result.bytes << " bytes, "
+                      << (result.seconds > 0
+                          ? result.bytes / result.seconds / 1e6 : 0)
+                      << " MB/s, "
+                      << (transitions ? extra * 1e9 / transitions : 0)
+                      << " ns per transition over none" << std::endl;
+        }
+    } catch(std::exception &e) {
+        std::cout << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
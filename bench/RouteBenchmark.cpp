@@ -0,0 +1,140 @@
+/*
+ * RouteBenchmark.cpp
+ * Project
+ * Albin Ågren
+ *
+ * Times the router on the map of a scenario: loading the scenario with the
+ * route of every train resolved, shortest route searches from stations not
+ * in the cache, queries answered from the cache and following a route back
+ * station by station. Generate a large network with remote trains, e.g.
+ * ScenarioGenerator dir --stations 5000 --density 0.001 --remote 0.5, to see
+ * the costs at scale.
+ *
+ * Usage: RouteBenchmark [data directory] [queries]
+ */
+
+#include "Simulation.h"
+#include "Controller.h"
+#include "Router.h"
+#include "Station.h"
+#include "Train.h"
+#include "BenchTimer.h"
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <random>
+#include <cmath>
+#include <exception>
+
+namespace {
+
+}   // namespace
+
+int main(int argc, char *argv[]) {
+    std::string directory = argc > 1 ? argv[1] : "../resources/Project/";
+    std::size_t queries = argc > 2 ? std::stoul(argv[2]) : 1000000;
+
+    try {
+        Simulation sim;
+        Controller controller(&sim, directory);
+
+        Clock::time_point start = Clock::now();
+        controller.loadStations();
+        controller.loadDistances();
+        double mapLoad = secondsSince(start);
+        start = Clock::now();
+        controller.loadTrains();
+        double trainLoad = secondsSince(start);
+
+        Router &router = controller.getRouter();
+        unsigned long loadSearches = router.getSearches();
+        unsigned stations = controller.getStationNames().size();
+
+        // count the trains that needed a route
+        unsigned long routed = 0, unreachable = 0;
+        for(unsigned i = 0; i < controller.getNoOfTrains(); ++i) {
+            const Train *train = controller.getTrain(i);
+            if(std::isnan(train->getDistance())) {
+                ++unreachable;
+            } else if(!controller.getDistanceTable().hasDistance(
+                            train->getOrigin()->getId(),
+                            train->getDestination()->getId())) {
+                ++routed;
+            }
+        }
+
+        std::mt19937 generator(42);
+        std::vector<unsigned> origins(queries), destinations(queries);
+        for(std::size_t i = 0; i < queries; ++i) {
+            origins[i] = generator() % stations;
+            destinations[i] = generator() % stations;
+        }
+
+        // searches from the first stations, starting from an empty cache
+        std::size_t searches = std::min<std::size_t>(stations, 1000);
+        const DistanceTable &table = controller.getDistanceTable();
+        std::vector<Link> links;
+        for(unsigned i = 0; i < stations; ++i) {
+            for(unsigned j = i + 1; j < stations; ++j) {
+                if(table.hasDistance(i, j)) {
+                    links.push_back({ i, j, table.getDistance(i, j) });
+                }
+            }
+        }
+        Router cold;
+        cold.build(stations, links);
+        double sum = 0;
+        start = Clock::now();
+        for(std::size_t i = 0; i < searches; ++i) {
+            double distance = cold.getDistance(i, (i + 1) % stations);
+            sum += std::isnan(distance) ? 0 : distance;
+        }
+        double searchTime = secondsSince(start);
+
+        // queries from the cached stations
+        start = Clock::now();
+        for(std::size_t i = 0; i < queries; ++i) {
+            double distance = cold.getDistance(origins[i] % searches,
+                                               destinations[i]);
+            sum += std::isnan(distance) ? 0 : distance;
+        }
+        double queryTime = secondsSince(start);
+
+        std::size_t routes = std::min<std::size_t>(queries, 100000);
+        std::size_t hops = 0;
+        start = Clock::now();
+        for(std::size_t i = 0; i < routes; ++i) {
+            hops += cold.getRoute(origins[i] % searches,
+                                  destinations[i]).size();
+        }
+        double routeTime = secondsSince(start);
+
+        std::cout << std::fixed << std::setprecision(1);
+        std::cout << "Scenario " << directory << ": " << stations
+                  << " stations, " << links.size() << " links, "
+                  << controller.getNoOfTrains() << " trains, " << routed
+                  << " routed, " << unreachable << " unreachable" << std::endl
+                  << "Loading stations and map: " << mapLoad * 1e3 << " ms"
+                  << std::endl
+                  << "Loading trains with routes: " << trainLoad * 1e3
+                  << " ms, " << loadSearches << " searches" << std::endl
+                  << "Search from an uncached station: "
+                  << searchTime * 1e6 / searches << " us" << std::endl
+                  << "Cached distance query: " << queryTime * 1e9 / queries
+                  << " ns" << std::endl
+                  << "Cached route query: " << routeTime * 1e9 / routes
+                  << " ns, " << static_cast<double>(hops) / routes
+                  << " stations per route" << std::endl
+                  << "Router memory: " << cold.getMemoryUsage() / 1048576.0
+                  << " MiB for " << searches << " cached stations"
+                  << std::endl
+                  << "Checksum " << sum << std::endl;
+    } catch(std::exception &e) {
+        std::cout << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
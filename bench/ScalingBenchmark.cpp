@@ -0,0 +1,187 @@
+/*
+ * ScalingBenchmark.cpp
+ * Project
+ * Albin Ågren
+ *
+ * Runs the complete simulation of a scenario on an increasing number of
+ * threads, conservatively and optimistically, checks that the log and
+ * statistics match the sequential run and reports the speedup over it.
+ * The optimistic runs are then repeated logging only new vehicle history,
+ * whose log cursors are rolled back with the vehicles, counting the runs
+ * that match the sequential log.
+ *
+ * Usage: ScalingBenchmark [data directory] [max threads] [repetitions]
+ */
+
+#include "Simulation.h"
+#include "ParallelSimulation.h"
+#include "TimeWarpSimulation.h"
+#include "Controller.h"
+#include "MyTime.h"
+#include "BenchTimer.h"
+#include "BenchScenario.h"
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <memory>
+#include <thread>
+#include <stdexcept>
+
+namespace {
+
+enum Mode { sequential, conservative, optimistic };
+
+struct RunResult {
+    double seconds;
+    unsigned partitions;
+    int lookahead;
+    unsigned long windows;
+    double rollbackRate, efficiency;
+    std::string output;
+};
+
+/*
+ * Runs the complete simulation once and returns the timing together with
+ * the log and the statistics
+ */
+RunResult runScenario(const std::string &directory, const Mode &mode,
+                      const unsigned &threads, const LogLevel &logLevel,
+                      const HistoryDetail &detail = HistoryDetail::full) {
+    Simulation sim;
+    std::unique_ptr<Controller> controller = loadQuiet(sim, directory);
+    controller->setLogLevel(logLevel);
+    controller->setLogSink(LogSink::both);
+    controller->setHistoryDetail(detail);
+    controller->scheduleAssemblyEvents();
+
+    // capture the log and statistics so runs can be checked against each other
+    std::ostringstream output;
+    std::streambuf *coutBuffer = std::cout.rdbuf(output.rdbuf());
+
+    RunResult result = { 0, 1, 0, 0, 0, 1, "" };
+    Time endTime(23, 59);
+    auto start = Clock::now();
+    if(mode == conservative) {
+        ParallelSimulation parallel(&sim, controller.get(), threads);
+        parallel.run(endTime);
+        controller->resumeRetries(endTime);
+        result.partitions = parallel.getNoOfPartitions();
+        result.lookahead = parallel.getLookahead();
+        result.windows = parallel.getWindows();
+    } else if(mode == optimistic) {
+        TimeWarpSimulation timeWarp(&sim, controller.get(), threads);
+        timeWarp.run(endTime);
+        controller->resumeRetries(endTime);
+        result.partitions = timeWarp.getNoOfPartitions();
+        result.windows = timeWarp.getGvtRounds();
+        result.rollbackRate = timeWarp.getRollbackRate();
+        result.efficiency = timeWarp.getEfficiency();
+    } else {
+        runDay(sim, *controller, endTime);
+    }
+    result.seconds = secondsSince(start);
+
+    controller->printStatistics(endTime);
+    std::cout << "Finished at " << sim.getTime() << std::endl;
+    std::cout.rdbuf(coutBuffer);
+
+    result.output = output.str();
+    return result;
+}
+
+/*
+ * Returns the best time of several runs without logging
+ */
+double best(const std::string &directory, const Mode &mode,
+            const unsigned &threads, const int &repetitions) {
+    double best = 0;
+    for(int i = 0; i < repetitions; ++i) {
+        double seconds = runScenario(directory, mode, threads, off).seconds;
+        if(i == 0 || seconds < best) {
+            best = seconds;
+        }
+    }
+    return best;
+}
+
+}   // namespace
+
+int main(int argc, char *argv[]) {
+    std::string directory = argc > 1 ? argv[1] : "../resources/";
+    unsigned maxThreads = argc > 2 ? std::stoi(argv[2])
+                                   : std::thread::hardware_concurrency();
+    int repetitions = argc > 3 ? std::stoi(argv[3]) : 5;
+    if(maxThreads == 0) {
+        maxThreads = 1;
+    }
+
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "Scenario " << directory << ", best of " << repetitions
+              << " runs without logging" << std::endl;
+
+    try {
+        // the sequential run is the reference for output and timing
+        std::string reference = runScenario(directory, sequential, 0,
+                                            high).output;
+        double sequentialTime = best(directory, sequential, 0, repetitions);
+        std::cout << std::setw(12) << "sequential" << ": "
+                  << sequentialTime * 1e3 << " ms" << std::endl;
+
+        for(unsigned threads = 1; threads <= maxThreads; ++threads) {
+            RunResult check = runScenario(directory, conservative, threads,
+                                          high);
+            double seconds = best(directory, conservative, threads,
+                                  repetitions);
+            std::cout << std::setw(4) << threads << " threads: "
+                      << seconds * 1e3 << " ms, speedup "
+                      << sequentialTime / seconds << ", " << check.partitions
+                      << " partitions, lookahead " << check.lookahead
+                      << " min, " << check.windows << " windows, output "
+                      << (check.output == reference ? "identical" : "DIFFERS")
+                      << std::endl;
+        }
+
+        std::cout << std::endl << "Optimistic (time warp)" << std::endl;
+        for(unsigned threads = 1; threads <= maxThreads; ++threads) {
+            RunResult check = runScenario(directory, optimistic, threads,
+                                          high);
+            double seconds = best(directory, optimistic, threads,
+                                  repetitions);
+            std::cout << std::setw(4) << threads << " threads: "
+                      << seconds * 1e3 << " ms, speedup "
+                      << sequentialTime / seconds << ", " << check.partitions
+                      << " partitions, " << check.windows << " GVT rounds, "
+                      << "rollback rate " << check.rollbackRate
+                      << ", efficiency " << check.efficiency << ", output "
+                      << (check.output == reference ? "identical" : "DIFFERS")
+                      << std::endl;
+        }
+
+        // the interleaving of the processes differs between runs, so each
+        // thread count is run several times
+        std::cout << std::endl << "Optimistic, new vehicle history only"
+                  << std::endl;
+        std::string incremental = runScenario(directory, sequential, 0, high,
+                                              HistoryDetail::incremental)
+                                                                .output;
+        for(unsigned threads = 1; threads <= maxThreads; ++threads) {
+            int matches = 0;
+            for(int i = 0; i < repetitions; ++i) {
+                matches += runScenario(directory, optimistic, threads, high,
+                                       HistoryDetail::incremental).output ==
+                           incremental;
+            }
+            std::cout << std::setw(4) << threads << " threads: " << matches
+                      << " of " << repetitions << " runs, output "
+                      << (matches == repetitions ? "identical" : "DIFFERS")
+                      << std::endl;
+        }
+    } catch(std::runtime_error &re) {
+        std::cout << "Error: " << re.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,106 @@
+/*
+ * SnapshotBenchmark.cpp
+ * Project
+ * Albin Ågren
+ *
+ * Times snapshots of a running simulation against running it again from
+ * the start. The day is run to a time, a snapshot is saved and then one
+ * more after each of a number of short steps, counting the chunks each
+ * copies. The run is completed, and every snapshot is then returned to and
+ * completed again, checking that each ends exactly as the first run did.
+ * Generate a large timetable, e.g. ScenarioGenerator dir --stations 200
+ * --trains 1000000, to see the costs at scale.
+ *
+ * Usage: SnapshotBenchmark [data directory] [time HH:MM] [steps]
+ */
+
+#include "Simulation.h"
+#include "Controller.h"
+#include "BenchTimer.h"
+#include "BenchScenario.h"
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <memory>
+#include <vector>
+#include <exception>
+
+namespace {
+
+// Minutes the simulation runs between the snapshots
+constexpr int STEP = 10;
+
+// Counts the chunks a snapshot copied that the one before did not
+unsigned long copiedSince(const Snapshot &snapshot, const Snapshot &before) {
+    return snapshot.trains.getCopies() - before.trains.getCopies() +
+           snapshot.stations.getCopies() - before.stations.getCopies() +
+           snapshot.vehicles.getCopies() - before.vehicles.getCopies();
+}
+
+}   // namespace
+
+int main(int argc, char *argv[]) {
+    std::string directory = argc > 1 ? argv[1] : "../resources/Project/";
+    std::string at = argc > 2 ? argv[2] : "08:00";
+    int steps = argc > 3 ? std::stoi(argv[3]) : 5;
+    Time time(std::stoi(at.substr(0, 2)), std::stoi(at.substr(3, 2)));
+
+    try {
+        // the cost of getting back to the time without a snapshot
+        Clock::time_point start = Clock::now();
+        Simulation sim;
+        std::unique_ptr<Controller> controller = loadQuiet(sim, directory);
+        controller->scheduleAssemblyEvents();
+        runUntil(sim, time);
+        double replay = secondsSince(start);
+
+        std::vector<Snapshot> snapshots;
+        std::vector<double> taken;
+        for(int step = 0; step <= steps; ++step) {
+            if(step > 0) {
+                runUntil(sim, sim.getTime() + Time(0, STEP));
+            }
+            start = Clock::now();
+            snapshots.push_back(controller->saveSnapshot());
+            taken.push_back(secondsSince(start));
+        }
+
+        runDay(sim, *controller, Time(23, 59));
+        unsigned long long expected = fingerprint(sim, *controller);
+
+        // return to each snapshot, latest first, and complete the day again
+        std::vector<double> restored(snapshots.size());
+        unsigned matches = 0;
+        for(std::size_t i = snapshots.size(); i-- > 0; ) {
+            start = Clock::now();
+            controller->restoreSnapshot(snapshots[i]);
+            restored[i] = secondsSince(start);
+            runDay(sim, *controller, Time(23, 59));
+            matches += fingerprint(sim, *controller) == expected;
+        }
+
+        std::cout << std::fixed << std::setprecision(4)
+                  << "Scenario " << directory << ": "
+                  << controller->getNoOfTrains() << " trains, "
+                  << controller->getVehicleTable().size() << " vehicles"
+                  << std::endl
+                  << "Replay to " << time << ": " << replay << " s"
+                  << std::endl;
+        for(std::size_t i = 0; i < snapshots.size(); ++i) {
+            std::cout << "Snapshot at " << snapshots[i].simulation.time
+                      << ": taken in " << taken[i] << " s, "
+                      << (i == 0 ? 0 : copiedSince(snapshots[i],
+                                                   snapshots[i - 1]))
+                      << " chunks copied, restored in " << restored[i]
+                      << " s" << std::endl;
+        }
+        std::cout << "Checked: " << matches << " of " << snapshots.size()
+                  << " restored runs end as the first run" << std::endl;
+    } catch(std::exception &e) {
+        std::cout << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
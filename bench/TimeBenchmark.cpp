@@ -0,0 +1,207 @@
+/*
+ * TimeBenchmark.cpp
+ * Project
+ * Albin Ågren
+ *
+ * Compares the Time class with the earlier day, hours and minutes
+ * representation on the operations of the simulation hot path: sorting
+ * (comparisons), addition and subtraction, += and the travel time
+ * calculation made on every departure.
+ *
+ * Usage: TimeBenchmark [operations] [repetitions]
+ */
+
+#include "MyTime.h"
+#include "BenchTimer.h"
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+/*
+ * The earlier representation, three ints normalized on every operation
+ */
+class LegacyTime {
+public:
+    LegacyTime() = default;
+    LegacyTime(const int &hours, const int &minutes);
+    explicit LegacyTime(const double &timeAsDouble);
+
+    int getTotalTime() const;
+    double getTimeAsDouble() const;
+
+    LegacyTime operator+(const LegacyTime &time) const;
+    LegacyTime operator-(const LegacyTime &time) const;
+    bool operator<(const LegacyTime &time) const;
+    LegacyTime &operator+=(const LegacyTime &time);
+
+private:
+    int mDay = 0, mHours = 0, mMinutes = 0;
+};
+
+LegacyTime::LegacyTime(const int &hours, const int &minutes) {
+    mMinutes += minutes;
+    mHours += hours;
+    if(mHours > 23) {
+        mHours -= 24;
+        ++mDay;
+    }
+    mHours += mMinutes / 60;
+    mMinutes %= 60;
+}
+
+LegacyTime::LegacyTime(const double &timeAsDouble) {
+    double hours, minutes;
+    minutes = std::modf(timeAsDouble, &hours);
+    mMinutes = static_cast<int>(minutes * 60);
+    mHours = static_cast<int>(hours);
+}
+
+int LegacyTime::getTotalTime() const {
+    return mMinutes + mHours * 60 + mDay * 24 * 60;
+}
+
+double LegacyTime::getTimeAsDouble() const {
+    return mMinutes / 60.0 + mHours;
+}
+
+LegacyTime LegacyTime::operator+(const LegacyTime &time) const {
+    int totalTime = getTotalTime() + time.getTotalTime();
+    return LegacyTime(totalTime / 60, totalTime % 60);
+}
+
+LegacyTime LegacyTime::operator-(const LegacyTime &time) const {
+    int totalTime = getTotalTime() - time.getTotalTime();
+    return LegacyTime(totalTime / 60, totalTime % 60);
+}
+
+bool LegacyTime::operator<(const LegacyTime &time) const {
+    return getTotalTime() < time.getTotalTime();
+}
+
+LegacyTime &LegacyTime::operator+=(const LegacyTime &time) {
+    mMinutes += time.mMinutes;
+    mHours += time.mHours;
+    mDay += time.mDay;
+    mHours += mMinutes / 60;
+    mMinutes %= 60;
+    while(mHours > 23) {
+        mHours -= 24;
+        ++mDay;
+    }
+    return *this;
+}
+
+/*
+ * Runs the operations on times of type T, returns the elapsed seconds of
+ * each and adds a checksum so the work is not optimized away
+ */
+template<typename T>
+std::vector<double> runOperations(const std::vector<int> &minutes,
+                                  const std::vector<double> &distances,
+                                  long long &checksum) {
+    std::vector<T> times;
+    for(const int &m : minutes) {
+        times.push_back(T(m / 60, m % 60));
+    }
+    std::vector<double> seconds;
+
+    // comparisons
+    std::vector<T> sorted = times;
+    Clock::time_point start = Clock::now();
+    std::sort(sorted.begin(), sorted.end());
+    seconds.push_back(secondsSince(start));
+    checksum += sorted.front().getTotalTime() + sorted.back().getTotalTime();
+
+    // addition and subtraction
+    start = Clock::now();
+    T sum(0, 0);
+    for(std::size_t i = 1; i < times.size(); ++i) {
+        sum = sum + (times[i] - times[i - 1]);
+    }
+    seconds.push_back(secondsSince(start));
+    checksum += sum.getTotalTime();
+
+    // +=
+    start = Clock::now();
+    T total(0, 0);
+    for(const T &time : times) {
+        total += time;
+    }
+    seconds.push_back(secondsSince(start));
+    checksum += total.getTotalTime();
+
+    // travel time at departure, as in Controller::depart
+    start = Clock::now();
+    double speeds = 0;
+    for(std::size_t i = 1; i < times.size(); ++i) {
+        T travelTime = times[i] - times[i - 1] + T(1, 0);
+        speeds += distances[i] / travelTime.getTimeAsDouble();
+        T arrival = times[i - 1] + T(distances[i] / 180.0);
+        checksum += arrival.getTotalTime();
+    }
+    seconds.push_back(secondsSince(start));
+    checksum += static_cast<long long>(speeds);
+
+    return seconds;
+}
+
+}   // namespace
+
+int main(int argc, char *argv[]) {
+    std::size_t operations = argc > 1 ? std::stoul(argv[1]) : 2000000;
+    int repetitions = argc > 2 ? std::stoi(argv[2]) : 5;
+
+    // random times over two days and distances like the shipped scenario
+    std::mt19937 generator(42);
+    std::uniform_int_distribution<int> minuteDistribution(0, 2 * 24 * 60);
+    std::uniform_real_distribution<double> distanceDistribution(30, 230);
+    std::vector<int> minutes(operations);
+    std::vector<double> distances(operations);
+    for(std::size_t i = 0; i < operations; ++i) {
+        minutes[i] = minuteDistribution(generator);
+        distances[i] = distanceDistribution(generator);
+    }
+
+    const char *names[] = { "sort", "add/subtract", "+=", "depart" };
+    std::vector<double> legacyBest(4, 0), timeBest(4, 0);
+    long long legacyChecksum = 0, timeChecksum = 0;
+    for(int r = 0; r < repetitions; ++r) {
+        std::vector<double> legacy = runOperations<LegacyTime>(
+                                        minutes, distances, legacyChecksum);
+        std::vector<double> current = runOperations<Time>(
+                                        minutes, distances, timeChecksum);
+        for(int i = 0; i < 4; ++i) {
+            if(r == 0 || legacy[i] < legacyBest[i]) {
+                legacyBest[i] = legacy[i];
+            }
+            if(r == 0 || current[i] < timeBest[i]) {
+                timeBest[i] = current[i];
+            }
+        }
+    }
+
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << operations << " times, best of " << repetitions << " runs"
+              << std::endl << std::setw(14) << "" << std::setw(16)
+              << "three ints" << std::setw(16) << "minute count"
+              << std::setw(10) << "speedup" << std::endl;
+    for(int i = 0; i < 4; ++i) {
+        std::cout << std::setw(14) << names[i]
+                  << std::setw(13) << legacyBest[i] * 1e9 / operations
+                  << " ns" << std::setw(13) << timeBest[i] * 1e9 / operations
+                  << " ns" << std::setw(9) << legacyBest[i] / timeBest[i]
+                  << "x" << std::endl;
+    }
+    std::cout << "Checksums " << (legacyChecksum == timeChecksum ? "match"
+                                                                 : "DIFFER")
+              << std::endl;
+
+    return 0;
+}
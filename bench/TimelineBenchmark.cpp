@@ -0,0 +1,157 @@
+/*
+ * TimelineBenchmark.cpp
+ * Project
+ * Albin Ågren
+ *
+ * Times the supply timeline of a scenario: building it from the loaded
+ * stations and trains, counts at random stations, types and times and the
+ * earliest shortage of every station and type. A sample of the counts is
+ * checked against a walk over every train, and the full simulation of the
+ * day is timed for comparison. Generate a large timetable, e.g.
+ * ScenarioGenerator dir --stations 200 --trains 1000000, to see the costs
+ * at scale.
+ *
+ * Usage: TimelineBenchmark [data directory] [queries]
+ */
+
+#include "Simulation.h"
+#include "Controller.h"
+#include "SupplyTimeline.h"
+#include "Station.h"
+#include "Train.h"
+#include "BenchTimer.h"
+#include "BenchScenario.h"
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <memory>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <exception>
+
+namespace {
+
+// Number of counts checked against a walk over every train
+constexpr std::size_t CHECKS = 100;
+
+// Counts the vehicles of a type at a station after a time by walking every
+// train, taking before leaving as the timeline does
+int walkTrains(const Controller &controller, const unsigned &station,
+               const int &type, const int &initial, const Time &time) {
+    int inventory = initial;
+    for(unsigned i = 0; i < controller.getNoOfTrains(); ++i) {
+        const Train *train = controller.getTrain(i);
+        int vehicles = 0;
+        for(const int &required : train->getRequiredVehicles()) {
+            vehicles += required == type;
+        }
+        if(train->getOrigin()->getId() == station &&
+           train->getOrigDeparture() - Time(0, 30) <= time) {
+            inventory -= vehicles;
+        }
+        if(train->getDestination()->getId() == station &&
+           train->getOrigArrival() + Time(0, 20) <= time) {
+            inventory += vehicles;
+        }
+    }
+    return inventory;
+}
+
+}   // namespace
+
+int main(int argc, char *argv[]) {
+    std::string directory = argc > 1 ? argv[1] : "../resources/Project/";
+    std::size_t queries = argc > 2 ? std::stoul(argv[2]) : 1000000;
+
+    try {
+        Simulation sim;
+        std::unique_ptr<Controller> controller = loadQuiet(sim, directory);
+
+        Clock::time_point start = Clock::now();
+        controller->buildSupplyTimeline();
+        double build = secondsSince(start);
+        const SupplyTimeline &timeline = controller->getSupplyTimeline();
+        unsigned stations = timeline.getNoOfStations();
+
+        // the initial pools, a day before any train takes from them
+        std::vector<int> initial(stations * Station::VEHICLE_TYPES);
+        for(unsigned station = 0; station < stations; ++station) {
+            for(int type = 0; type < Station::VEHICLE_TYPES; ++type) {
+                initial[station * Station::VEHICLE_TYPES + type] =
+                            timeline.getInventory(station, type, Time(-24, 0));
+            }
+        }
+
+        std::mt19937 generator(42);
+        std::vector<unsigned> picks(queries);
+        std::vector<Time> times(queries);
+        for(std::size_t i = 0; i < queries; ++i) {
+            picks[i] = generator() % (stations * Station::VEHICLE_TYPES);
+            times[i] = Time::fromMinutes(generator() % Time::MINUTES_PER_DAY);
+        }
+
+        start = Clock::now();
+        long long total = 0;
+        for(std::size_t i = 0; i < queries; ++i) {
+            total += timeline.getInventory(picks[i] / Station::VEHICLE_TYPES,
+                                           picks[i] % Station::VEHICLE_TYPES,
+                                           times[i]);
+        }
+        double inventory = secondsSince(start);
+
+        start = Clock::now();
+        unsigned shortages = 0;
+        Time earliest(24, 0);
+        for(unsigned station = 0; station < stations; ++station) {
+            for(int type = 0; type < Station::VEHICLE_TYPES; ++type) {
+                Time time;
+                if(timeline.getEarliestShortage(station, type, time)) {
+                    ++shortages;
+                    earliest = time < earliest ? time : earliest;
+                }
+            }
+        }
+        double shortage = secondsSince(start);
+
+        unsigned matches = 0;
+        std::size_t checks = std::min(CHECKS, queries);
+        for(std::size_t i = 0; i < checks; ++i) {
+            unsigned station = picks[i] / Station::VEHICLE_TYPES;
+            int type = picks[i] % Station::VEHICLE_TYPES;
+            matches += timeline.getInventory(station, type, times[i]) ==
+                       walkTrains(*controller, station, type,
+                                  initial[picks[i]], times[i]);
+        }
+
+        controller->scheduleAssemblyEvents();
+        start = Clock::now();
+        runDay(sim, *controller, Time(23, 59));
+        double simulation = secondsSince(start);
+
+        std::cout << std::fixed << std::setprecision(4)
+                  << "Scenario " << directory << ": " << stations
+                  << " stations, " << controller->getNoOfTrains()
+                  << " trains" << std::endl
+                  << "Build: " << timeline.getNoOfChanges() << " changes in "
+                  << build << " s" << std::endl
+                  << "Inventory: " << queries << " queries in " << inventory
+                  << " s, " << std::setprecision(1)
+                  << inventory / queries * 1e9 << " ns each (sum "
+                  << total << ")" << std::endl << std::setprecision(4)
+                  << "Shortages: " << shortages << " of "
+                  << stations * Station::VEHICLE_TYPES
+                  << " stations and types, earliest "
+                  << (shortages > 0 ? earliest.getFormattedTime() : "none")
+                  << ", found in " << shortage << " s" << std::endl
+                  << "Checked: " << matches << " of " << checks
+                  << " counts match a walk over every train" << std::endl
+                  << "Simulation: " << simulation << " s" << std::endl;
+    } catch(std::exception &e) {
+        std::cout << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,124 @@
+/*
+ * WaitBenchmark.cpp
+ * Project
+ * Albin Ågren
+ *
+ * Runs a scenario through the day at log level off, once with trains that
+ * fail assembly retrying every 10 minutes and once with them waiting for the
+ * vehicle types they miss. Checks that every train ends with the same
+ * status, times and delays and every vehicle in the same place with the
+ * same history, and reports the events processed and the time of each run.
+ * Exits with 1 if the runs differ.
+ *
+ * Usage: WaitBenchmark [data directory] [end time HH:MM]
+ */
+
+#include "Simulation.h"
+#include "Controller.h"
+#include "Train.h"
+#include "Vehicle.h"
+#include "Station.h"
+#include "MyTime.h"
+#include "BenchTimer.h"
+#include "BenchScenario.h"
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <memory>
+#include <vector>
+#include <exception>
+
+namespace {
+
+// Struct holding what one run measured
+struct Result {
+    double seconds;
+    unsigned long events;
+    std::vector<std::string> trains;
+    std::vector<std::string> vehicles;
+};
+
+Result measureDay(const std::string &directory, const bool &wait,
+                  const Time &endTime) {
+    Simulation sim;
+    std::unique_ptr<Controller> controller = loadQuiet(sim, directory);
+    controller->setWaitForVehicles(wait);
+    controller->scheduleAssemblyEvents();
+
+    Clock::time_point start = Clock::now();
+    runDay(sim, *controller, endTime);
+
+    Result result;
+    result.seconds = secondsSince(start);
+    result.events = sim.getEventsProcessed();
+
+    // describe the end state of every train and vehicle
+    for(unsigned i = 0; i < controller->getNoOfTrains(); ++i) {
+        const Train *train = controller->getTrain(i);
+        std::ostringstream ss;
+        ss << train->getTrainNumber() << " " << train->getStatus() << " "
+           << train->getCurrentDeparture() << " "
+           << train->getCurrentArrival() << " " << train->getDelay() << " "
+           << train->getDepartureDelay();
+        for(const Vehicle *vehicle : train->getVehicles()) {
+            ss << " " << vehicle->getId();
+        }
+        result.trains.push_back(ss.str());
+    }
+    for(const std::string &name : controller->getStationNames()) {
+        Station *station;
+        controller->findStation(name, &station);
+        station->forEachVehicle([&result, &name](const Vehicle *vehicle) {
+            std::ostringstream ss;
+            ss << vehicle->getId() << " " << name << " ";
+            vehicle->writeHistory(ss);
+            result.vehicles.push_back(ss.str());
+        });
+    }
+    return result;
+}
+
+}   // namespace
+
+int main(int argc, char *argv[]) {
+    std::string directory = argc > 1 ? argv[1] : "../resources/Project/";
+    Time endTime(23, 59);
+    if(argc > 2) {
+        std::string end = argv[2];
+        std::size_t colon = end.find(':');
+        endTime = Time(std::stoi(end.substr(0, colon)),
+                       std::stoi(end.substr(colon + 1)));
+    }
+
+    try {
+        Result polling = measureDay(directory, false, endTime);
+        Result waiting = measureDay(directory, true, endTime);
+        bool identical = polling.trains == waiting.trains &&
+                         polling.vehicles == waiting.vehicles;
+        unsigned long saved = polling.events - waiting.events;
+        double share = polling.events
+                     ? 100.0 * saved / polling.events : 0;
+
+        std::cout << std::fixed << std::setprecision(4)
+                  << "Scenario " << directory << " until " << endTime
+                  << std::endl
+                  << "Polling: " << polling.events << " events, "
+                  << polling.seconds << " s" << std::endl
+                  << "Waiting: " << waiting.events << " events, "
+                  << waiting.seconds << " s" << std::endl
+                  << "Events saved: " << saved << " (" << share
+                  << "%), end state "
+                  << (identical ? "identical" : "DIFFERS") << std::endl;
+
+        if(!identical) {
+            return 1;
+        }
+    } catch(std::exception &e) {
+        std::cout << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
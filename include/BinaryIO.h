@@ -0,0 +1,142 @@
+/*
+ * BinaryIO.h
+ * Project
+ * Albin Ågren
+ */
+
+#ifndef DT060G_PROJECT_BINARY_IO_H
+#define DT060G_PROJECT_BINARY_IO_H
+
+#include <vector>
+#include <string>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <type_traits>
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+
+// Functions for writing values to checkpoints as their bytes, in the byte
+// order of the machine, and reading them back. Reading throws
+// std::runtime_error if the stream ends early
+
+/**
+ * Function for writing a value of a trivially copyable type
+ *
+ * @param os, the stream to write to
+ * @param value, the value
+ */
+template<typename T>
+void writeBinary(std::ostream &os, const T &value) {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "only trivially copyable values are written as bytes");
+    os.write(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+/**
+ * Function for reading a value of a trivially copyable type
+ * Throws std::runtime_error if the stream ends early
+ *
+ * @param is, the stream to read from
+ * @param value, the value read
+ */
+template<typename T>
+void readBinary(std::istream &is, T &value) {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "only trivially copyable values are read as bytes");
+    if(!is.read(reinterpret_cast<char *>(&value), sizeof(T))) {
+        throw std::runtime_error("checkpoint ends early");
+    }
+}
+
+/**
+ * Function for writing a vector of a trivially copyable type, its size
+ * first
+ *
+ * @param os, the stream to write to
+ * @param values, the vector
+ */
+template<typename T>
+void writeBinaryVector(std::ostream &os, const std::vector<T> &values) {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "only trivially copyable values are written as bytes");
+    writeBinary(os, static_cast<std::uint64_t>(values.size()));
+    os.write(reinterpret_cast<const char *>(values.data()),
+             values.size() * sizeof(T));
+}
+
+/**
+ * Function for reading a vector of a trivially copyable type
+ * Throws std::runtime_error if the stream ends early
+ *
+ * @param is, the stream to read from
+ * @param values, the vector read
+ */
+template<typename T>
+void readBinaryVector(std::istream &is, std::vector<T> &values) {
+    std::uint64_t size;
+    readBinary(is, size);
+
+    // grow a block at a time, so a damaged size fails at the end of the
+    // stream rather than allocating it all
+    constexpr std::size_t BLOCK = 1 << 16;
+    values.clear();
+    while(values.size() < size) {
+        std::size_t first = values.size();
+        std::size_t count = static_cast<std::size_t>(
+                                    std::min<std::uint64_t>(size - first,
+                                                            BLOCK));
+        values.resize(first + count);
+        if(!is.read(reinterpret_cast<char *>(values.data() + first),
+                    count * sizeof(T))) {
+            throw std::runtime_error("checkpoint ends early");
+        }
+    }
+}
+
+/**
+ * Function for reading a time in minutes, which a checkpoint holds from the
+ * start of the simulation up to a year after it, so later arithmetic on it
+ * can not overflow
+ * Throws std::runtime_error if the stream ends early or the time is out of
+ * that range
+ *
+ * @param is, the stream to read from
+ * @return, the minutes
+ */
+inline int readBinaryMinutes(std::istream &is) {
+    constexpr int MAX_MINUTES = 366 * 24 * 60;
+    int minutes;
+    readBinary(is, minutes);
+    if(minutes < 0 || minutes > MAX_MINUTES) {
+        throw std::runtime_error("checkpoint holds a damaged time");
+    }
+    return minutes;
+}
+
+/**
+ * Function for writing a string, its length first
+ *
+ * @param os, the stream to write to
+ * @param str, the string
+ */
+inline void writeBinaryString(std::ostream &os, const std::string &str) {
+    writeBinary(os, static_cast<std::uint64_t>(str.size()));
+    os.write(str.data(), str.size());
+}
+
+/**
+ * Function for reading a string
+ * Throws std::runtime_error if the stream ends early
+ *
+ * @param is, the stream to read from
+ * @param str, the string read
+ */
+inline void readBinaryString(std::istream &is, std::string &str) {
+    std::vector<char> chars;
+    readBinaryVector(is, chars);
+    str.assign(chars.begin(), chars.end());
+}
+
+#endif  // DT060G_PROJECT_BINARY_IO_H
@@ -0,0 +1,93 @@
+/*
+ * CheckpointWriter.h
+ * Project
+ * Albin Ågren
+ */
+
+#ifndef DT060G_PROJECT_CHECKPOINT_WRITER_H
+#define DT060G_PROJECT_CHECKPOINT_WRITER_H
+
+#include <string>
+#include <thread>
+#include <functional>
+#include <atomic>
+#include <ostream>
+
+/**
+ * Class for writing checkpoint files on a thread of their own
+ * A file is written beside its path and renamed over it once complete, so
+ * a crash while writing leaves the last complete checkpoint in place. One
+ * file is written at a time, starting another waits for the one before
+ */
+class CheckpointWriter {
+public:
+    // Type of the tasks writing the contents of a file
+    using Task = std::function<void(std::ostream &)>;
+
+    /**
+     * Constructor
+     */
+    CheckpointWriter(): mFailed(false), mWritten(0) { }
+
+    // Destructor, waits for the file being written
+    ~CheckpointWriter() { wait(); }
+
+    // A writer owns a thread and is not copied
+    CheckpointWriter(const CheckpointWriter &) = delete;
+    CheckpointWriter &operator=(const CheckpointWriter &) = delete;
+
+    /**
+     * Function for writing a file in the background, after the file before
+     * is written
+     *
+     * @param path, the path of the file
+     * @param task, the task writing the contents, run on the writer thread
+     */
+    void write(const std::string &path, Task task);
+
+    /**
+     * Function for waiting until the file being written is complete
+     *
+     * @return, a bool indicating if the last file was written
+     */
+    bool wait();
+
+    /**
+     * Function for getting why the last file was not written
+     *
+     * @return, the error message, empty if it was written
+     */
+    const std::string &getError() const { return mError; }
+
+    /**
+     * Function for getting the number of files written, not counting one
+     * being written
+     *
+     * @return, the number of files
+     */
+    unsigned long getWritten() const { return mWritten; }
+
+// Private member functions
+private:
+    /**
+     * Function run by the writer thread, writes and renames the file
+     */
+    void run();
+
+// Private data members
+private:
+    std::thread mThread;
+
+    // The file being written, read by the writer thread until joined
+    std::string mPath;
+
+    Task mTask;
+
+    bool mFailed;
+
+    std::string mError;
+
+    std::atomic<unsigned long> mWritten;
+};
+
+#endif  // DT060G_PROJECT_CHECKPOINT_WRITER_H
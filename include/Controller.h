@@ -7,42 +7,181 @@
 #ifndef DT060G_PROJECT_CONTROLLER_H
 #define DT060G_PROJECT_CONTROLLER_H
 
+#include "MyTime.h"
 #include "Train.h"
 #include "Station.h"
 #include "Vehicle.h"
+#include "DistanceTable.h"
+#include "Router.h"
+#include "VehicleTable.h"
+#include "HistoryJournal.h"
+#include "Logger.h"
+#include "RecordWriter.h"
+#include "VehiclePlan.h"
+#include "SupplyTimeline.h"
+#include "Simulation.h"
+#include "CowArray.h"
+#include "CheckpointWriter.h"
 
 #include <vector>
+#include <array>
+#include <unordered_map>
 #include <memory>
 #include <fstream>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <cstdint>
 
-// Forward declaration
+// Forward declarations
 class Simulation;
+class Scenario;
+struct VehicleData;
+struct StationData;
+struct DistanceData;
+struct TrainData;
 
 // Enum representing the different levels of log detail
 enum LogLevel { off, low, high };
 
+// Enum class for how much vehicle history the high log level writes, all of
+// it or only the events added since the vehicle was last logged
+enum class HistoryDetail { full, incremental };
+
+// Struct representing a train that failed assembly and waits for vehicles
+// instead of retrying, nextTry is the time in minutes polling would retry at
+// next, or NOT_WAITING, and ticket tells the train's current queue entries
+// from those of earlier waits
+struct AssemblyWait {
+    static constexpr int NOT_WAITING = -1;
+
+    int nextTry;
+    unsigned ticket;
+    bool queued;    // in the queues, not yet woken
+};
+
+// Struct representing a waiting train in the queue of a vehicle type
+struct WaitEntry {
+    unsigned train;
+    unsigned ticket;
+};
+
+// Struct representing the trains waiting for each vehicle type at a station
+struct StationWaits {
+    std::array<std::vector<WaitEntry>, Station::VEHICLE_TYPES> queues;
+
+    unsigned long allocations;  // times a queue grew its storage
+};
+
+// Struct representing the state of a train kept by a snapshot
+struct TrainSnapshot {
+    Train train;
+    AssemblyWait wait;
+};
+
+// Struct representing the state of a station kept by a snapshot
+struct StationSnapshot {
+    Station station;
+    StationWaits waits;
+};
+
+// Struct representing the state of a vehicle kept by a snapshot, the
+// history is its latest record in the journal and the number of events
+struct VehicleSnapshot {
+    Station *station;
+    Train *train;
+    unsigned lastRecord;
+    std::size_t historySize;
+    std::size_t loggedHistory;
+    unsigned planCursor;
+};
+
+// Struct representing the state of a simulation and its controller at one
+// time. Trains are kept in order of departure, so the trains an interval
+// changes share few chunks, stations by id and vehicles by table row, in
+// chunks shared with the other snapshots of the same controller until one
+// of them changes. The pointers are to the controller's own objects, so
+// only the controller that saved a snapshot can return to it, a snapshot
+// can not start a second, independent simulation
+struct Snapshot {
+    const Controller *owner = nullptr;
+    SimulationState simulation;
+    CowArray<TrainSnapshot> trains;
+    CowArray<StationSnapshot> stations;
+    CowArray<VehicleSnapshot> vehicles;
+};
+
+// Struct representing the indices of the trains, stations or vehicles
+// changed since the last snapshot, each listed once
+struct ChangeSet {
+    std::vector<char> marked;
+    std::vector<unsigned> indices;
+
+    void mark(const unsigned &index) {
+        if(!marked[index]) {
+            marked[index] = 1;
+            indices.push_back(index);
+        }
+    }
+};
+
+// Struct representing the outcome of the trains within the time window
+struct TrainStatistics {
+    unsigned onTime;
+    unsigned delayed;
+    unsigned failed;
+    Time departureDelay;
+    Time arrivalDelay;
+};
+
 /**
  * Class for controlling the train system, owns all trains, vehicles
  * and stations
  */
 class Controller {
 public:
+    // Version of the checkpoint format written
+    static constexpr std::uint32_t CHECKPOINT_VERSION = 1;
+
     /**
      * Constructor
      *
      * @param sim, a pointer to a Simulation object
+     * @param directory, the directory holding the data files and the log
      */
-    explicit Controller(Simulation *sim);
+    explicit Controller(Simulation *sim,
+                        const std::string &directory = "../resources/Project/");
+
+    /**
+     * Constructor, builds the system from an already parsed scenario
+     * Used for replicas of a scenario, no log file is opened and log entries
+     * are only written to the console
+     *
+     * @param sim, a pointer to a Simulation object
+     * @param scenario, the parsed scenario
+     */
+    Controller(Simulation *sim, const Scenario &scenario);
+
+    // Default destructor, the logger writes the remaining entries
+    ~Controller() = default;
 
-    // Destructor
-    ~Controller() { mLogFile.close(); }
+    /**
+     * Function for enabling random departure delays, each train is delayed
+     * at ready up with the given probability by 1 to maxDelay minutes
+     *
+     * @param probability, the probability a train is delayed
+     * @param maxDelay, the longest delay in minutes
+     * @param seed, the seed deciding which trains are delayed and how much
+     */
+    void setDisturbances(const double &probability, const int &maxDelay,
+                         const unsigned long long &seed);
 
     /**
      * Function for setting level of log detail
      *
      * @param logLevel, the desired log level
      */
-    void setLogLevel(const LogLevel &logLevel) { mLogLevel = logLevel; }
+    void setLogLevel(const LogLevel &logLevel);
 
     /**
      * Function for getting current log level
@@ -51,6 +190,33 @@ public:
      */
     LogLevel getLogLevel() const { return mLogLevel; }
 
+    /**
+     * Function for setting how much vehicle history the high log level
+     * writes
+     *
+     * @param detail, full history or only the events not yet logged
+     */
+    void setHistoryDetail(const HistoryDetail &detail)
+        { mHistoryDetail = detail; }
+
+    /**
+     * Function for getting how much vehicle history the high log level
+     * writes
+     *
+     * @return, the history detail
+     */
+    HistoryDetail getHistoryDetail() const { return mHistoryDetail; }
+
+    /**
+     * Function for discerning if logging moves the log cursors of the
+     * vehicles, which is then part of the state an event changes
+     *
+     * @return, a bool indicating if only new history is logged
+     */
+    bool isLoggingNewHistory() const
+        { return mLogLevel == high &&
+                 mHistoryDetail == HistoryDetail::incremental; }
+
     /**
      * Function for getting current log level as string
      *
@@ -58,6 +224,242 @@ public:
      */
     std::string getLogLevelAsString() const;
 
+    /**
+     * Function for setting where log entries are written
+     *
+     * @param sink, the console, the log file, both or none
+     */
+    void setLogSink(const LogSink &sink) { mLogger.setSink(sink); }
+
+    /**
+     * Function for setting what happens to log entries the writer can not
+     * keep up with
+     *
+     * @param backpressure, block to wait for the writer or drop the entries
+     */
+    void setLogBackpressure(const Backpressure &backpressure)
+        { mLogger.setBackpressure(backpressure); }
+
+    /**
+     * Function for waiting until the log entries so far are written, call
+     * before writing anything else to the console
+     */
+    void flushLog() { mLogger.flush(); }
+
+    /**
+     * Function for getting the logger writing the log entries
+     *
+     * @return, a reference to the logger
+     */
+    const Logger &getLogger() const { return mLogger; }
+
+    /**
+     * Function for writing a record of every train transition from now on
+     * to a file, alongside the log
+     *
+     * @param path, the path of the record file
+     * @param format, JSON Lines or CSV
+     * @return, a bool indicating if the file was opened
+     */
+    bool openRecords(const std::string &path, const RecordFormat &format);
+
+    /**
+     * Function for writing the remaining records and closing the record file
+     */
+    void closeRecords() { mRecords.close(); }
+
+    /**
+     * Function for getting the writer of the event records
+     *
+     * @return, a reference to the record writer
+     */
+    const RecordWriter &getRecordWriter() const { return mRecords; }
+
+    /**
+     * Function for letting trains that fail assembly wait for the vehicle
+     * types they miss, instead of retrying every 10 minutes
+     * A waiting train is woken when one of those types is returned to its
+     * station and retries at the time polling would next have retried at.
+     * The retries skipped meanwhile would have failed without a change, so
+     * their delay is added when the train is woken. Trains only wait while
+     * no retry is written to the log or the records. Turning waiting off
+     * puts the waiting trains back on the retry schedule
+     *
+     * @param wait, a bool indicating if trains may wait
+     */
+    void setWaitForVehicles(const bool &wait);
+
+    /**
+     * Function for discerning if trains that fail assembly may wait
+     *
+     * @return, a bool indicating if trains may wait
+     */
+    bool isWaitingForVehicles() const { return mWaitForVehicles; }
+
+    /**
+     * Function for putting a train that failed assembly in the queues of the
+     * vehicle types it misses at its origin, if trains may wait
+     *
+     * @param index, the index of the train
+     * @param nextTry, a Time object with the time polling would retry at
+     * @return, a bool indicating if the train waits, otherwise the caller
+     * schedules the retry
+     */
+    bool waitForVehicles(const unsigned &index, const Time &nextTry);
+
+    /**
+     * Function for ending the wait of a train at its assembly event, adds
+     * the delay of the retries it skipped
+     *
+     * @param index, the index of the train
+     * @param time, a Time object with the time of the assembly event
+     */
+    void endWait(const unsigned &index, const Time &time);
+
+    /**
+     * Function for putting the waiting trains back on the retry schedule,
+     * after the events before a time are processed
+     * Adds the delay of the retries before the time and schedules the next
+     * retry of the trains not already woken. Call before reading the trains
+     * where a run stops
+     *
+     * @param until, a Time object with the time the run has reached
+     */
+    void resumeRetries(const Time &until);
+
+    /**
+     * Function for getting the number of times a wait queue grew its storage
+     *
+     * @return, the number of allocations
+     */
+    unsigned long getWaitAllocations() const;
+
+    /**
+     * Function for planning the vehicles of every train over the timetable,
+     * call after loading and before scheduling the assembly events
+     */
+    void planVehicles();
+
+    /**
+     * Function for letting assembly follow the vehicle plan
+     * A planned train first takes its planned vehicles that are at its
+     * origin. Any train then only takes vehicles not kept for the next
+     * train planned for them at the same station, so trains that miss the
+     * plan do not take the vehicles of trains that keep to it
+     *
+     * @param follow, a bool indicating if the plan is followed
+     */
+    void setFollowPlan(const bool &follow) { mFollowPlan = follow; }
+
+    /**
+     * Function for discerning if assembly follows the vehicle plan
+     *
+     * @return, a bool indicating if the plan is followed
+     */
+    bool isFollowingPlan() const { return mFollowPlan; }
+
+    /**
+     * Function for getting the vehicle plan
+     *
+     * @return, a reference to the plan
+     */
+    const VehiclePlan &getVehiclePlan() const { return mPlan; }
+
+    /**
+     * Function for predicting the vehicles at each station over the
+     * timetable, call after loading and before scheduling the assembly
+     * events
+     */
+    void buildSupplyTimeline() { mTimeline.build(mStations, mTrains); }
+
+    /**
+     * Function for getting the predicted vehicles at each station
+     *
+     * @return, a reference to the timeline
+     */
+    const SupplyTimeline &getSupplyTimeline() const { return mTimeline; }
+
+    /**
+     * Function for saving a snapshot of the simulation and the trains,
+     * stations and vehicles, for this controller to return to later
+     * The first snapshot copies all state. Changes are then tracked, so a
+     * later snapshot only copies the chunks of the trains, stations and
+     * vehicles changed since and shares the rest. The event queue is copied
+     * whole every time. The log, the records and the journal are not part
+     * of a snapshot, history stays in the journal and is only pointed at
+     *
+     * @return, the snapshot
+     */
+    Snapshot saveSnapshot();
+
+    /**
+     * Function for returning the simulation and the trains, stations and
+     * vehicles to a snapshot, which can be returned to again
+     * Only what has changed since the last snapshot saved or returned to,
+     * and what differs between that one and the snapshot, is written back,
+     * unless changes were not tracked
+     * Throws std::invalid_argument if another controller saved the snapshot
+     *
+     * @param snapshot, the snapshot
+     */
+    void restoreSnapshot(const Snapshot &snapshot);
+
+    /**
+     * Function for no longer tracking changes for snapshots, call before
+     * events are processed on more than one thread. The next snapshot saved
+     * or returned to copies all state
+     */
+    void stopTrackingChanges() { mTracking = false; }
+
+    /**
+     * Function for writing a checkpoint of the simulation and the trains,
+     * stations, vehicles and vehicle history to a file, to continue the run
+     * from in another process
+     * The state is taken as a snapshot and written on a thread of its own,
+     * so the run goes on meanwhile. The checkpoint before is written first.
+     * The data files, the vehicle plan and the settings are not part of a
+     * checkpoint, the run continuing loads and sets them as the first did
+     *
+     * @param path, the path of the checkpoint file
+     */
+    void saveCheckpoint(const std::string &path);
+
+    /**
+     * Function for waiting until the last checkpoint is written
+     *
+     * @return, a bool indicating if it was written, otherwise
+     * getCheckpointWriter().getError() tells why
+     */
+    bool waitForCheckpoint() { return mCheckpoints.wait(); }
+
+    /**
+     * Function for getting the writer of the checkpoint files
+     *
+     * @return, a reference to the checkpoint writer
+     */
+    const CheckpointWriter &getCheckpointWriter() const
+        { return mCheckpoints; }
+
+    /**
+     * Function for returning the simulation and the trains, stations,
+     * vehicles and vehicle history to a checkpoint, call after loading the
+     * same data files and planning the vehicles as the run that wrote it
+     * Throws std::runtime_error if the file can not be read, is of another
+     * version or scenario or is damaged, the run can then not continue
+     *
+     * @param path, the path of the checkpoint file
+     */
+    void loadCheckpoint(const std::string &path);
+
+    /**
+     * Function for noting that a train is changed by an event, for the next
+     * snapshot
+     *
+     * @param index, the index of the train
+     */
+    void markTrain(const unsigned &index)
+        { if(mTracking) { mTrainChanges.mark(mTrainSlots[index]); } }
+
     /**
      * Function for getting the names of all stations in the system
      *
@@ -118,6 +520,62 @@ public:
      */
     bool findVehicle(const int &id, Vehicle **vehicle);
 
+    /**
+     * Function for getting the distance between two stations
+     * Throws std::out_of_range if the stations are not linked
+     *
+     * @param from, a pointer to the first station
+     * @param to, a pointer to the second station
+     * @return, the distance
+     */
+    double getDistance(const Station *from, const Station *to) const
+        { return mDistances.getDistance(from->getId(), to->getId()); }
+
+    /**
+     * Function for getting the table of distances between stations
+     *
+     * @return, a reference to the distance table
+     */
+    const DistanceTable &getDistanceTable() const { return mDistances; }
+
+    /**
+     * Function for getting the router finding routes over the station links
+     *
+     * @return, a reference to the router
+     */
+    Router &getRouter() { return mRouter; }
+
+    /**
+     * Function for getting the columns of vehicle attributes and locations,
+     * for sums over the fleet, a station or a train
+     *
+     * @return, a reference to the vehicle table
+     */
+    const VehicleTable &getVehicleTable() const { return mVehicleTable; }
+
+    /**
+     * Function for getting the journal holding the history of the vehicles
+     *
+     * @return, a reference to the history journal
+     */
+    const HistoryJournal &getHistoryJournal() const { return mJournal; }
+
+    /**
+     * Function for getting the number of trains in the system
+     *
+     * @return, the number of trains
+     */
+    unsigned getNoOfTrains() const { return mTrains.size(); }
+
+    /**
+     * Function for getting a train by its index
+     *
+     * @param index, the index of the train in load order
+     * @return, a pointer to the train
+     */
+    Train *getTrain(const unsigned &index) const
+        { return mTrains[index].get(); }
+
     /**
      * Function for scheduling the initial events for all trains, based on
      * their departure time
@@ -129,40 +587,65 @@ public:
      * as well as logging the event
      *
      * @param train, a pointer to the train to be assembled
+     * @param index, the index of the train
+     * @param sim, a pointer to the simulation processing the event
      * @return, a bool indicating if train could be assembled
      */
-    bool attemptAssembly(Train *train);
+    bool attemptAssembly(Train *train, const unsigned &index,
+                         Simulation *sim);
 
     /**
      * Function for changing train status to ready and logging the event
      *
      * @param train, a pointer to the train to be readied
+     * @param sim, a pointer to the simulation processing the event
      */
-    void readyUp(Train *train);
+    void readyUp(Train *train, Simulation *sim);
 
     /**
      * Function for managing train departure, calculates train speed and
      * attempts to mitigate any delays, logs the event
      *
      * @param train, a pointer to the train to depart
+     * @param sim, a pointer to the simulation processing the event
      */
-    void depart(Train *train);
+    void depart(Train *train, Simulation *sim);
 
     /**
      * Function for managing train arrival, changes train status and
      * logs the event
      *
      * @param train, a pointer to the train to arrive
+     * @param sim, a pointer to the simulation processing the event
      */
-    void arrive(Train *train);
+    void arrive(Train *train, Simulation *sim);
 
     /**
      * Function for managing train disassembly, transfers train vehicles
      * to the destination vehicle pool and logs the event
      *
      * @param train, a pointer to the train to disassemble
+     * @param sim, a pointer to the simulation processing the event
+     */
+    void disassemble(Train *train, Simulation *sim);
+
+    /**
+     * Function for handing an entry to the logger, or to the simulation if
+     * it is capturing its log
+     *
+     * @param sim, a pointer to the simulation that produced the entry
+     * @param entry, the formatted log entry
      */
-    void disassemble(Train *train);
+    void writeLog(Simulation *sim, std::string entry);
+
+    /**
+     * Function for handing an event record to the record writer, or to the
+     * simulation if it is capturing its log
+     *
+     * @param sim, a pointer to the simulation that produced the record
+     * @param record, the formatted event record
+     */
+    void writeRecord(Simulation *sim, std::string record);
 
     /**
      * Function for setting ignore flag for already departed trains
@@ -173,25 +656,287 @@ public:
 
     /**
      * Function for compiling and printing statistics from the trains in the
-     * system
+     * system, after the log entries so far
+     *
+     * @param endTime, the user specified end time of the simulation
+     */
+    void printStatistics(const Time &endTime);
+
+    /**
+     * Function for counting the on time, delayed and failed trains and
+     * summing their delays, as in the printed statistics
      *
      * @param endTime, the user specified end time of the simulation
+     * @return, the statistics of the trains
+     */
+    TrainStatistics getStatistics(const Time &endTime) const;
+
+// Private member functions
+private:
+    /**
+     * Function for building stations and their vehicle pools
+     *
+     * @param stations, the parsed stations
+     */
+    void buildStations(const std::vector<StationData> &stations);
+
+    /**
+     * Function for setting the distances between stations
+     *
+     * @param distances, the parsed distances
+     */
+    void buildDistances(const std::vector<DistanceData> &distances);
+
+    /**
+     * Function for building trains, the distance of each train is the
+     * direct link between its stations or otherwise the shortest route
+     *
+     * @param trains, the parsed trains
+     */
+    void buildTrains(const std::vector<TrainData> &trains);
+
+    /**
+     * Function for making a vehicle of the type described
+     *
+     * @param vehicle, the parsed vehicle
+     * @return, a unique_ptr to the new vehicle
+     */
+    static std::unique_ptr<Vehicle> makeVehicle(const VehicleData &vehicle);
+
+    /**
+     * Function for moving a vehicle from the pool of a train's origin to
+     * the train and logging the event in the vehicle history
+     *
+     * @param train, a pointer to the train
+     * @param vehicle, a pointer to the vehicle, already detached
+     * @param sim, a pointer to the simulation processing the event
+     */
+    void connectVehicle(Train *train, Vehicle *vehicle, Simulation *sim);
+
+    /**
+     * Function for discerning if a vehicle is kept for the next train
+     * planned for it, which is another train at the vehicle's station not
+     * yet assembled
+     *
+     * @param vehicle, a pointer to the vehicle, in a station pool
+     * @param index, the index of the train being assembled
+     * @param time, a Time object with the time of the assembly
+     * @return, a bool indicating if the vehicle is kept
+     */
+    bool isReserved(const Vehicle *vehicle, const unsigned &index,
+                    const Time &time);
+
+    /**
+     * Function for recording a train transition if records are written
+     *
+     * @param train, a pointer to the train
+     * @param sim, a pointer to the simulation processing the event
+     * @param event, the name of the transition
+     */
+    void recordEvent(const Train *train, Simulation *sim, const char *event);
+
+    /**
+     * Function for writing the history of a vehicle to a log entry, in full
+     * or only the events not yet logged
+     *
+     * @param os, the stream to write to
+     * @param vehicle, a pointer to the vehicle
+     */
+    void writeHistory(std::ostream &os, Vehicle *vehicle);
+
+    /**
+     * Function for waking the trains waiting at a station for the vehicle
+     * types just returned to it, each retries at the first time polling
+     * would after the current event
+     *
+     * @param station, a pointer to the station
+     * @param types, a bit set of the returned vehicle types
+     * @param train, a pointer to the train returning the vehicles
+     * @param sim, a pointer to the simulation processing the event
+     */
+    void wakeWaitingTrains(const Station *station, const unsigned &types,
+                           const Train *train, Simulation *sim);
+
+    /**
+     * Function for noting that a station is changed, for the next snapshot
+     *
+     * @param station, a pointer to the station
+     */
+    void markStation(const Station *station)
+        { if(mTracking) { mStationChanges.mark(station->getId()); } }
+
+    /**
+     * Function for noting that a vehicle is changed, for the next snapshot
+     *
+     * @param vehicle, a pointer to the vehicle
+     */
+    void markVehicle(const Vehicle *vehicle) {
+        if(mTracking) {
+            mVehicleChanges.mark(static_cast<unsigned>(
+                                                    vehicle->getTableRow()));
+        }
+    }
+
+    /**
+     * Function for copying the state of a train for a snapshot
+     *
+     * @param index, the index of the train
+     * @return, the state of the train
+     */
+    TrainSnapshot saveTrain(const unsigned &index) const
+        { return { *mTrains[index], mWaits[index] }; }
+
+    /**
+     * Function for copying the state of a station for a snapshot
+     *
+     * @param id, the id of the station
+     * @return, the state of the station
+     */
+    StationSnapshot saveStation(const unsigned &id) const
+        { return { *mStations[id], mStationWaits[id] }; }
+
+    /**
+     * Function for copying the state of a vehicle for a snapshot
+     *
+     * @param row, the table row of the vehicle
+     * @return, the state of the vehicle
+     */
+    VehicleSnapshot saveVehicle(const unsigned &row) const;
+
+    /**
+     * Function for returning a train to its state in a snapshot
+     *
+     * @param index, the index of the train
+     * @param state, the state of the train
+     */
+    void restoreTrain(const unsigned &index, const TrainSnapshot &state);
+
+    /**
+     * Function for returning a station to its state in a snapshot
+     *
+     * @param id, the id of the station
+     * @param state, the state of the station
+     */
+    void restoreStation(const unsigned &id, const StationSnapshot &state);
+
+    /**
+     * Function for returning a vehicle to its state in a snapshot
+     *
+     * @param row, the table row of the vehicle
+     * @param state, the state of the vehicle
+     */
+    void restoreVehicle(const unsigned &row, const VehicleSnapshot &state);
+
+    /**
+     * Function for writing a snapshot to a checkpoint, called on the
+     * checkpoint writer thread so it only reads the snapshot, the counts
+     * and table rows that do not change and the first records of the
+     * journal
+     *
+     * @param os, the stream to write to
+     * @param snapshot, the snapshot
+     * @param records, the number of journal records when it was taken
+     * @param hash, the hash of the scenario
+     */
+    void writeCheckpoint(std::ostream &os, const Snapshot &snapshot,
+                         const std::size_t &records,
+                         const std::uint64_t &hash) const;
+
+    /**
+     * Function for hashing the loaded data a checkpoint depends on, so one
+     * is not read into another scenario
+     *
+     * @return, the hash
      */
-    void printStatistics(const Time &endTime) const;
+    std::uint64_t getScenarioHash() const;
+
+    /**
+     * Function for forgetting the changes noted since the last snapshot
+     */
+    void clearChanges();
+
+    /**
+     * Function for scrambling the bits of a value, used to draw disturbances
+     *
+     * @param value, the value to scramble
+     * @return, the scrambled value
+     */
+    static unsigned long long mixBits(unsigned long long value);
 
 // Private data members
 private:
     Simulation *mSim;
 
+    std::string mDirectory;
+
     std::vector<std::unique_ptr<Vehicle>> mVehicles;
 
+    VehicleTable mVehicleTable;
+
+    HistoryJournal mJournal;
+
     std::vector<std::unique_ptr<Station>> mStations;
 
     std::vector<std::unique_ptr<Train>> mTrains;
 
-    std::ofstream mLogFile;
+    DistanceTable mDistances;
+
+    Router mRouter;
+
+    // Indices for finding stations by name, trains by number and vehicles
+    // by id, built while loading
+    std::unordered_map<std::string, Station*> mStationIndex;
+
+    std::unordered_map<int, Train*> mTrainIndex;
+
+    std::unordered_map<int, Vehicle*> mVehicleIndex;
+
+    Logger mLogger;
+
+    RecordWriter mRecords;
 
     LogLevel mLogLevel;
+
+    HistoryDetail mHistoryDetail;
+
+    // Trains waiting for vehicles, by train index and by origin station id
+    std::vector<AssemblyWait> mWaits;
+
+    std::vector<StationWaits> mStationWaits;
+
+    bool mWaitForVehicles;
+
+    // The vehicle plan and, by table row, the position of each vehicle's
+    // next planned train
+    VehiclePlan mPlan;
+
+    std::vector<unsigned> mPlanCursors;
+
+    bool mFollowPlan;
+
+    SupplyTimeline mTimeline;
+
+    // The state at the last snapshot saved or returned to, sharing chunks
+    // with the snapshots, and what has changed since if tracked
+    Snapshot mSynced;
+
+    bool mTracking;
+
+    ChangeSet mTrainChanges, mStationChanges, mVehicleChanges;
+
+    // The index of the train at each position of the snapshots, in order of
+    // departure, and the position of each train
+    std::vector<unsigned> mTrainOrder, mTrainSlots;
+
+    // Writes the checkpoints, declared last so it is stopped before the
+    // state it reads is destroyed
+    CheckpointWriter mCheckpoints;
+
+    double mDisturbance;
+
+    int mMaxDisturbance;
+
+    unsigned long long mSeed;
 };
 
 #endif  // DT060G_PROJECT_CONTROLLER_H
@@ -0,0 +1,123 @@
+/*
+ * CowArray.h
+ * Project
+ * Albin Ågren
+ */
+
+#ifndef DT060G_PROJECT_COW_ARRAY_H
+#define DT060G_PROJECT_COW_ARRAY_H
+
+#include <vector>
+#include <memory>
+#include <cstddef>
+
+/**
+ * Class template for an array of values stored in chunks shared between
+ * copies of the array
+ * Copying the array only copies a pointer per chunk. Writing an element
+ * first copies its chunk if another array shares it, so a copy costs what
+ * is later written to it, a chunk at a time
+ */
+template<typename T>
+class CowArray {
+public:
+    // Number of elements in a chunk
+    static constexpr std::size_t CHUNK = 64;
+
+    /**
+     * Constructor, makes an empty array
+     */
+    CowArray(): mSize(0), mCopies(0) { }
+
+    // Default destructor
+    ~CowArray() = default;
+
+    /**
+     * Function for adding an element last
+     *
+     * @param value, the element
+     */
+    void append(const T &value);
+
+    /**
+     * Function for reading an element
+     *
+     * @param index, the index of the element
+     * @return, a reference to the element
+     */
+    const T &operator[](const std::size_t &index) const
+        { return (*mChunks[index / CHUNK])[index % CHUNK]; }
+
+    /**
+     * Function for writing an element, copies its chunk if it is shared
+     *
+     * @param index, the index of the element
+     * @return, a reference to the element
+     */
+    T &write(const std::size_t &index);
+
+    /**
+     * Function for discerning if the chunk holding an element is the same
+     * in another array, in which case both hold the same element
+     *
+     * @param other, the other array
+     * @param index, the index of the element
+     * @return, a bool indicating if the chunk is shared
+     */
+    bool sharesChunk(const CowArray &other, const std::size_t &index) const
+        { return mChunks[index / CHUNK] == other.mChunks[index / CHUNK]; }
+
+    /**
+     * Function for getting the number of elements
+     *
+     * @return, the number of elements
+     */
+    std::size_t size() const { return mSize; }
+
+    /**
+     * Function for getting the number of chunks copied by writes, a copy
+     * of the array starts from the count of the original
+     *
+     * @return, the number of copied chunks
+     */
+    unsigned long getCopies() const { return mCopies; }
+
+    /**
+     * Function for no longer counting the chunks copied so far
+     */
+    void resetCopies() { mCopies = 0; }
+
+// Private data members
+private:
+    std::vector<std::shared_ptr<std::vector<T>>> mChunks;
+
+    std::size_t mSize;
+
+    unsigned long mCopies;
+};
+
+template<typename T>
+void CowArray<T>::append(const T &value) {
+    // start a chunk when the last one is full or shared
+    if(mSize % CHUNK == 0) {
+        mChunks.push_back(std::make_shared<std::vector<T>>());
+        mChunks.back()->reserve(CHUNK);
+    } else if(mChunks.back().use_count() > 1) {
+        mChunks.back() = std::make_shared<std::vector<T>>(*mChunks.back());
+        ++mCopies;
+    }
+    mChunks.back()->push_back(value);
+    ++mSize;
+}
+
+template<typename T>
+T &CowArray<T>::write(const std::size_t &index) {
+    std::shared_ptr<std::vector<T>> &chunk = mChunks[index / CHUNK];
+    if(chunk.use_count() > 1) {
+        chunk = std::make_shared<std::vector<T>>(*chunk);
+        ++mCopies;
+    }
+    return (*chunk)[index % CHUNK];
+}
+
+#endif  // DT060G_PROJECT_COW_ARRAY_H
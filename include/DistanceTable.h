@@ -0,0 +1,130 @@
+/*
+ * DistanceTable.h
+ * Project
+ * Albin Ågren
+ */
+
+#ifndef DT060G_PROJECT_DISTANCE_TABLE_H
+#define DT060G_PROJECT_DISTANCE_TABLE_H
+
+#include <vector>
+#include <cstddef>
+#include <cmath>
+
+// Struct representing the distance between two stations by station id
+struct Link {
+    unsigned station0;
+    unsigned station1;
+    double distance;
+};
+
+/**
+ * Class holding the distances between stations, indexed by station id
+ * Networks of up to DENSE_LIMIT stations are held in a flat matrix, so a
+ * lookup is a single load. Larger networks, where a matrix would mostly hold
+ * missing distances, are held as sorted rows of neighbours (CSR) and a lookup
+ * searches the row of the origin
+ */
+class DistanceTable {
+public:
+    // Largest number of stations held in a matrix
+    static constexpr unsigned DENSE_LIMIT = 2048;
+
+    /**
+     * Default constructor, makes an empty table
+     */
+    DistanceTable(): mStations(0), mDense(true) { }
+
+    // Default destructor
+    ~DistanceTable() = default;
+
+    /**
+     * Function for building the table, distances apply in both directions
+     * and the first distance given for a pair of stations is kept
+     *
+     * @param stations, the number of stations
+     * @param links, the distances between pairs of stations
+     */
+    void build(const unsigned &stations, const std::vector<Link> &links);
+
+    /**
+     * Function for getting the distance between two stations
+     * Throws std::out_of_range if the stations are not linked
+     *
+     * @param from, the id of the first station
+     * @param to, the id of the second station
+     * @return, the distance
+     */
+    double getDistance(const unsigned &from, const unsigned &to) const {
+        if(mDense) {
+            double distance = mMatrix[from * mStations + to];
+            if(!std::isnan(distance)) {
+                return distance;
+            }
+        }
+        return findDistance(from, to);
+    }
+
+    /**
+     * Function for discerning if two stations are linked
+     *
+     * @param from, the id of the first station
+     * @param to, the id of the second station
+     * @return, a bool indicating if there is a distance
+     */
+    bool hasDistance(const unsigned &from, const unsigned &to) const;
+
+    /**
+     * Function for discerning if the table is held as a matrix
+     *
+     * @return, a bool indicating if the table is a matrix
+     */
+    bool isDense() const { return mDense; }
+
+    /**
+     * Function for getting the number of station pairs with a distance
+     *
+     * @return, the number of distances, counting each direction
+     */
+    std::size_t getNoOfDistances() const { return mNoOfDistances; }
+
+    /**
+     * Function for getting the memory held by the table
+     *
+     * @return, the number of bytes allocated
+     */
+    std::size_t getMemoryUsage() const;
+
+// Private member functions
+private:
+    /**
+     * Function for searching the row of a station for a distance
+     * Throws std::out_of_range if the stations are not linked
+     *
+     * @param from, the id of the first station
+     * @param to, the id of the second station
+     * @return, the distance
+     */
+    double findDistance(const unsigned &from, const unsigned &to) const;
+
+// Private data members
+private:
+    unsigned mStations;
+
+    bool mDense;
+
+    std::size_t mNoOfDistances = 0;
+
+    // Matrix of distances, NaN where stations are not linked
+    std::vector<double> mMatrix;
+
+    // Rows of neighbours, the neighbours of station i are at
+    // mOffsets[i] to mOffsets[i + 1] sorted by id
+    std::vector<std::size_t> mOffsets;
+
+    std::vector<unsigned> mNeighbours;
+
+    std::vector<double> mDistances;
+};
+
+#endif  // DT060G_PROJECT_DISTANCE_TABLE_H
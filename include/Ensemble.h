@@ -0,0 +1,168 @@
+/*
+ * Ensemble.h
+ * Project
+ * Albin Ågren
+ */
+
+#ifndef DT060G_PROJECT_ENSEMBLE_H
+#define DT060G_PROJECT_ENSEMBLE_H
+
+#include "MyTime.h"
+#include "Scenario.h"
+
+#include <vector>
+#include <string>
+
+/**
+ * Class for collecting a distribution of delays in whole minutes
+ * Delays up to a day get one bin each, longer delays share an overflow bin
+ */
+class DelayHistogram {
+public:
+    // Default constructor
+    DelayHistogram(): mBins(MAX_MINUTES + 2, 0), mCount(0), mSum(0),
+                      mMax(0) { }
+
+    /**
+     * Function for adding a delay to the distribution
+     *
+     * @param minutes, the delay in minutes
+     */
+    void add(const int &minutes);
+
+    /**
+     * Function for adding all delays of another distribution
+     *
+     * @param histogram, the distribution to add
+     */
+    void merge(const DelayHistogram &histogram);
+
+    /**
+     * Function for getting the number of delays added
+     *
+     * @return, the number of delays
+     */
+    unsigned long getCount() const { return mCount; }
+
+    /**
+     * Function for getting the mean delay
+     *
+     * @return, the mean delay in minutes
+     */
+    double getMean() const;
+
+    /**
+     * Function for getting the longest delay
+     *
+     * @return, the longest delay in minutes
+     */
+    int getMax() const { return mMax; }
+
+    /**
+     * Function for getting the delay a share of all delays do not exceed
+     *
+     * @param share, the share between 0 and 1
+     * @return, the delay in minutes, or the longest delay if it falls in the
+     * overflow bin
+     */
+    int getPercentile(const double &share) const;
+
+// Private data members
+private:
+    static constexpr int MAX_MINUTES = 24 * 60;
+
+    std::vector<unsigned long> mBins;
+
+    unsigned long mCount;
+
+    long long mSum;
+
+    int mMax;
+};
+
+/**
+ * Class for running many replicas of a scenario with random departure delays
+ * Every replica has its own simulation and controller built from the same
+ * parsed scenario, replicas run on a work-stealing thread pool and their
+ * delays are added to per-worker distributions as soon as they finish, so no
+ * replica is kept after it has run
+ */
+class Ensemble {
+public:
+    /**
+     * Constructor
+     *
+     * @param scenario, the parsed scenario shared by all replicas
+     * @param probability, the probability a train is delayed at ready up
+     * @param maxDelay, the longest random delay in minutes
+     */
+    Ensemble(const Scenario &scenario, const double &probability,
+             const int &maxDelay);
+
+    // Default destructor
+    ~Ensemble() = default;
+
+    /**
+     * Function for running the replicas to the end time
+     *
+     * @param replicas, the number of replicas
+     * @param threads, the number of worker threads
+     * @param seed, the seed of the first replica, the others use the
+     * following seeds
+     * @param endTime, the end time of each replica
+     */
+    void run(const unsigned &replicas, const unsigned &threads,
+             const unsigned long long &seed, const Time &endTime);
+
+    /**
+     * Function for printing the delay distributions of the last run
+     */
+    void printResults() const;
+
+// Private member functions
+private:
+    // Struct representing the results of a worker or a whole run
+    struct Results {
+        DelayHistogram departureDelays, arrivalDelays;
+
+        // Per train: replicas delayed, total arrival delay, replicas unfinished
+        std::vector<unsigned long> delayed, delaySum, unfinished;
+
+        unsigned long replicas;
+    };
+
+    /**
+     * Function for running a single replica and adding its delays
+     *
+     * @param seed, the seed of the replica
+     * @param endTime, the end time of the replica
+     * @param results, the results to add the delays to
+     */
+    void runReplica(const unsigned long long &seed, const Time &endTime,
+                    Results &results) const;
+
+    /**
+     * Function for making empty results sized for the scenario
+     *
+     * @return, the empty results
+     */
+    Results makeResults() const;
+
+// Private data members
+private:
+    const Scenario &mScenario;
+
+    double mProbability;
+
+    int mMaxDelay;
+
+    Results mResults;
+
+    unsigned mThreads;
+
+    unsigned long mSteals;
+
+    double mSeconds;
+};
+
+#endif  // DT060G_PROJECT_ENSEMBLE_H
@@ -9,269 +9,97 @@
 
 #include "MyTime.h"
 
-#include <memory>
+#include <istream>
+#include <ostream>
+#include <cstddef>
 
 // Forward declarations
 class Simulation;
 class Controller;
 class Train;
 
+// Enum representing the stages of a train's lifecycle, in processing order
+enum class EventType : unsigned char {
+    assembly, ready, departure, arrival, disassembly
+};
+
 /**
- * Virtual base class representing simulation events
+ * Struct representing a single simulation event, stored by value in the
+ * event queue and dispatched on its type
  */
-class Event {
-public:
-    /**
-     * Constructor
-     *
-     * @param time, the event time
-     */
-    explicit Event(const Time &time): mTime(time) { }
-
-    // Virtual destructor
-    virtual ~Event() { }
-
+struct Event {
     /**
-     * Function for processing the event, pure virtual
+     * Default constructor
      */
-    virtual void processEvent() = 0;
+    Event() = default;
 
     /**
-     * Function for getting event type, pure virtual
+     * Constructor
      *
-     * @return, an int representing the event type
+     * @param eventType, the event type
+     * @param eventTime, the event time
+     * @param eventTrain, a pointer to the train participating in the event
+     * @param index, the index of the train in the controller
      */
-    virtual int getType() const = 0;
+    Event(const EventType &eventType, const Time &eventTime,
+          const Train *const eventTrain, const unsigned &index);
 
     /**
      * Function for getting event time
      *
      * @return, a Time object with the event time
      */
-    Time getTime() const { return mTime; }
+    Time getTime() const { return Time::fromMinutes(time); }
 
-// Protected data members
-protected:
-    Time mTime;
+    int time;           // event time in minutes
+    int trainNumber;    // breaks ties between simultaneous events
+    unsigned train;     // index of the train in the controller
+    EventType type;
 };
 
-// Class for compairing events by their time, for use with std::priority_queue
+static_assert(sizeof(Event) <= 16, "events should fit in 16 bytes");
+
+// Class for compairing events by time and then train number, for use with
+// the event queues. The train number decides which of the trains
+// assembling in the same minute takes the vehicles first, so it is part of
+// the result wherever trains compete for vehicles
 class EventComparison {
 public:
-    bool operator()(const std::shared_ptr<Event> &left,
-                    const std::shared_ptr<Event> &right) {
-        return left->getTime() > right->getTime();
+    bool operator()(const Event &left, const Event &right) const {
+        return left.time > right.time ||
+               (left.time == right.time &&
+                left.trainNumber > right.trainNumber);
     }
 };
 
 /**
- * Class representing train assembly
- */
-class AssemblyEvent : public Event {
-public:
-    /**
-     * Constructor
-     *
-     * @param time, the event time
-     * @param sim, a pointer to the simulation object
-     * @param controller, a pointer to the controller object
-     * @ train, a pointer to the train participating in the event
-     */
-    AssemblyEvent(const Time &time, Simulation *const sim,
-                  Controller *const controller, Train *const train):
-                                                     Event(time),
-                                                     mSim(sim),
-                                                     mController(controller),
-                                                     mTrain(train) { }
-
-    // Virtual destructor
-    virtual ~AssemblyEvent() { }
-
-    /**
-     * Function for processing the event
-     */
-    void processEvent() override;
-
-    /**
-     * Function for getting event type
-     *
-     * @return, an int representing the event type
-     */
-    int getType() const override { return 0; }
-
-// Private data members
-private:
-    Simulation *mSim;
-    Controller *mController;
-    Train *mTrain;
-};
-
-/**
- * Class representing the train arriving at the platform, ready to depart
- */
-class ReadyEvent : public Event {
-public:
-    /**
-     * Constructor
-     *
-     * @param time, the event time
-     * @param sim, a pointer to the simulation object
-     * @param controller, a pointer to the controller object
-     * @ train, a pointer to the train participating in the event
-     */
-    ReadyEvent(const Time time, Simulation *const sim,
-               Controller *const controller, Train *const train):
-                                                     Event(time),
-                                                     mSim(sim),
-                                                     mController(controller),
-                                                     mTrain(train) { }
-
-    // Virtual destructor
-    virtual ~ReadyEvent() { }
-
-    /**
-     * Function for processing the event
-     */
-    void processEvent() override;
-
-    /**
-     * Function for getting event type
-     *
-     * @return, an int representing the event type
-     */
-    int getType() const override { return 1; }
-
-// Private data members
-private:
-    Simulation *mSim;
-    Controller *mController;
-    Train *mTrain;
-};
-
-/**
- * Class representing train departure event
+ * Function for processing an event, calls the controller handler for the
+ * event type and schedules the next event in the train's lifecycle
+ *
+ * @param event, the event to process
+ * @param sim, a pointer to the simulation the event belongs to
+ * @param controller, a pointer to the controller owning the train
  */
-class DepartureEvent : public Event {
-public:
-    /**
-     * Constructor
-     *
-     * @param time, the event time
-     * @param sim, a pointer to the simulation object
-     * @param controller, a pointer to the controller object
-     * @ train, a pointer to the train participating in the event
-     */
-    DepartureEvent(const Time time, Simulation *const sim,
-                   Controller *const controller, Train *const train):
-                                                     Event(time),
-                                                     mSim(sim),
-                                                     mController(controller),
-                                                     mTrain(train) { }
-
-    // Virtual destructor
-    virtual ~DepartureEvent() { }
-
-    /**
-     * Function for processing the event
-     */
-    void processEvent() override;
-
-    /**
-     * Function for getting event type
-     *
-     * @return, an int representing the event type
-     */
-    int getType() const override { return 2; }
-
-// Private data members
-private:
-    Simulation *mSim;
-    Controller *mController;
-    Train *mTrain;
-};
+void processEvent(const Event &event, Simulation *sim, Controller *controller);
 
 /**
- * Class representing train arrival at the destination
+ * Function for writing an event to a checkpoint, field by field
+ *
+ * @param os, the stream to write to
+ * @param event, the event
  */
-class ArrivalEvent : public Event {
-public:
-    /**
-     * Constructor
-     *
-     * @param time, the event time
-     * @param sim, a pointer to the simulation object
-     * @param controller, a pointer to the controller object
-     * @ train, a pointer to the train participating in the event
-     */
-    ArrivalEvent(const Time time, Simulation *const sim,
-                 Controller *const controller, Train *const train):
-                                                     Event(time),
-                                                     mSim(sim),
-                                                     mController(controller),
-                                                     mTrain(train) { }
-
-    // Virtual destructor
-    virtual ~ArrivalEvent() { }
-
-    /**
-     * Function for processing the event
-     */
-    void processEvent() override;
-
-    /**
-     * Function for getting event type
-     *
-     * @return, an int representing the event type
-     */
-    int getType() const override { return 3; }
-
-// Private data members
-private:
-    Simulation *mSim;
-    Controller *mController;
-    Train *mTrain;
-};
+void writeEvent(std::ostream &os, const Event &event);
 
 /**
- * Class representing train disassembly event
+ * Function for reading an event from a checkpoint
+ * Throws std::runtime_error if the stream ends early or the event is
+ * damaged, i.e. its time is out of range, its train is not one of the
+ * trains or its type is unknown
+ *
+ * @param is, the stream to read from
+ * @param trains, the number of trains the event can refer to
+ * @return, the event
  */
-class DisassemblyEvent : public Event {
-public:
-    /**
-     * Constructor
-     *
-     * @param time, the event time
-     * @param sim, a pointer to the simulation object
-     * @param controller, a pointer to the controller object
-     * @ train, a pointer to the train participating in the event
-     */
-    DisassemblyEvent(const Time time, Simulation *const sim,
-                     Controller *const controller, Train *const train):
-                                                     Event(time),
-                                                     mSim(sim),
-                                                     mController(controller),
-                                                     mTrain(train) { }
-
-    // Virtual destructor
-    virtual ~DisassemblyEvent() { }
-
-    /**
-     * Function for processing the event
-     */
-    void processEvent() override;
-
-    /**
-     * Function for getting event type
-     *
-     * @return, an int representing the event type
-     */
-    int getType() const override { return 4; }
-
-// Private data members
-private:
-    Simulation *mSim;
-    Controller *mController;
-    Train *mTrain;
-};
+Event readEvent(std::istream &is, const std::size_t &trains);
 
 #endif  // DT060G_PROJECT_EVENT_H
@@ -0,0 +1,306 @@
+/*
+ * EventQueue.h
+ * Project
+ * Albin Ågren
+ */
+
+#ifndef DT060G_PROJECT_EVENT_QUEUE_H
+#define DT060G_PROJECT_EVENT_QUEUE_H
+
+#include "Event.h"
+#include "BinaryIO.h"
+
+#include <vector>
+#include <memory>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <cstdint>
+#include <cstddef>
+
+// Enum representing the available event queue implementations
+enum QueueType { binaryHeap, quaternaryHeap, calendar };
+
+/**
+ * Virtual base class for the priority queues holding scheduled events
+ * Events are ordered by time, ties are broken by train number so every
+ * implementation processes events in exactly the same order
+ */
+class EventQueue {
+public:
+    // Virtual destructor
+    virtual ~EventQueue() { }
+
+    /**
+     * Function for adding an event to the queue
+     *
+     * @param event, the queued event
+     */
+    virtual void push(const Event &event) = 0;
+
+    /**
+     * Function for getting the earliest event in the queue
+     *
+     * @return, the earliest event
+     */
+    virtual const Event &top() = 0;
+
+    /**
+     * Function for removing the earliest event from the queue
+     */
+    virtual void pop() = 0;
+
+    /**
+     * Function for getting the number of queued events
+     *
+     * @return, the number of events in the queue
+     */
+    virtual std::size_t size() const = 0;
+
+    /**
+     * Function for discerning if the queue is empty
+     *
+     * @return, a bool indicating if the queue is empty
+     */
+    bool empty() const { return size() == 0; }
+
+    /**
+     * Function for copying the queue with its events, for snapshots
+     *
+     * @return, a unique_ptr to the copy
+     */
+    virtual std::unique_ptr<EventQueue> clone() const = 0;
+
+    /**
+     * Function for getting which implementation the queue is
+     *
+     * @return, the queue type
+     */
+    virtual QueueType getType() const = 0;
+
+    /**
+     * Function for writing the queued events to a checkpoint as they are
+     * laid out, with the storage they use, so the queue read back processes
+     * them in the same order and grows its storage at the same points
+     *
+     * @param os, the stream to write to
+     */
+    virtual void writeState(std::ostream &os) const = 0;
+
+    /**
+     * Function for reading the queued events from a checkpoint into an
+     * empty queue of the type that wrote them
+     * Throws std::runtime_error if the checkpoint is damaged
+     *
+     * @param is, the stream to read from
+     * @param trains, the number of trains the events can refer to
+     */
+    virtual void readState(std::istream &is, const std::size_t &trains) = 0;
+
+    /**
+     * Function for getting the number of times the queue storage has grown
+     *
+     * @return, the number of storage allocations since construction
+     */
+    virtual unsigned long getAllocations() const { return mAllocations; }
+
+// Protected data members
+protected:
+    unsigned long mAllocations = 0;
+};
+
+/**
+ * Class implementing an implicit d-ary min heap of queued events
+ */
+template<std::size_t ARITY>
+class HeapEventQueue : public EventQueue {
+public:
+    // Virtual destructor
+    virtual ~HeapEventQueue() { }
+
+    void push(const Event &event) override;
+
+    const Event &top() override { return mHeap.front(); }
+
+    void pop() override;
+
+    std::size_t size() const override { return mHeap.size(); }
+
+    std::unique_ptr<EventQueue> clone() const override
+        { return std::make_unique<HeapEventQueue>(*this); }
+
+    QueueType getType() const override
+        { return ARITY == 4 ? quaternaryHeap : binaryHeap; }
+
+    void writeState(std::ostream &os) const override;
+
+    void readState(std::istream &is, const std::size_t &trains) override;
+
+// Private data members
+private:
+    std::vector<Event> mHeap;
+
+    EventComparison mCompare;
+};
+
+/**
+ * Class implementing a calendar queue with one bucket per simulated minute
+ * Buckets form a ring covering a fixed horizon, events outside the horizon
+ * are kept in an overflow heap until the ring reaches them
+ */
+class CalendarEventQueue : public EventQueue {
+public:
+    // Number of minutes covered by the bucket ring, must be a power of two
+    static constexpr int HORIZON = 4096;
+
+    /**
+     * Constructor
+     */
+    CalendarEventQueue(): mBuckets(HORIZON), mBase(0), mCursor(0),
+                          mRingSize(0) { }
+
+    // Virtual destructor
+    virtual ~CalendarEventQueue() { }
+
+    void push(const Event &event) override;
+
+    const Event &top() override;
+
+    void pop() override;
+
+    std::size_t size() const override
+        { return mRingSize + mOverflow.size(); }
+
+    std::unique_ptr<EventQueue> clone() const override
+        { return std::make_unique<CalendarEventQueue>(*this); }
+
+    QueueType getType() const override { return calendar; }
+
+    void writeState(std::ostream &os) const override;
+
+    void readState(std::istream &is, const std::size_t &trains) override;
+
+    unsigned long getAllocations() const override
+        { return mAllocations + mOverflow.getAllocations(); }
+
+// Private member functions
+private:
+    /**
+     * Function for advancing the cursor to the first non-empty bucket,
+     * moves the ring forward when only overflow events remain
+     */
+    void advance();
+
+    /**
+     * Function for discerning if the earliest event is in the overflow heap
+     *
+     * @return, a bool indicating if the overflow heap holds the earliest event
+     */
+    bool overflowFirst();
+
+    /**
+     * Function for adding an event within the horizon to its bucket
+     *
+     * @param event, the queued event
+     */
+    void pushBucket(const Event &event);
+
+// Private data members
+private:
+    // Each bucket is a heap of the events in one minute, earliest first
+    std::vector<std::vector<Event>> mBuckets;
+
+    HeapEventQueue<2> mOverflow;
+
+    int mBase;      // the minute represented by the cursor bucket
+
+    int mCursor;    // index of the bucket holding the earliest ring events
+
+    std::size_t mRingSize;
+};
+
+template<std::size_t ARITY>
+void HeapEventQueue<ARITY>::push(const Event &event) {
+    // add event last and sift it up towards the root
+    std::size_t child = mHeap.size();
+    if(child == mHeap.capacity()) {
+        ++mAllocations;
+    }
+    mHeap.push_back(event);
+
+    while(child > 0) {
+        std::size_t parent = (child - 1) / ARITY;
+        if(!mCompare(mHeap[parent], event)) {
+            break;
+        }
+        mHeap[child] = mHeap[parent];
+        child = parent;
+    }
+    mHeap[child] = event;
+}
+
+template<std::size_t ARITY>
+void HeapEventQueue<ARITY>::pop() {
+    // move the last event to the root and sift it down
+    Event last = mHeap.back();
+    mHeap.pop_back();
+    if(mHeap.empty()) {
+        return;
+    }
+
+    std::size_t parent = 0, size = mHeap.size();
+    while(true) {
+        std::size_t first = parent * ARITY + 1;
+        if(first >= size) {
+            break;
+        }
+
+        // find the earliest of the children
+        std::size_t best = first;
+        std::size_t end = first + ARITY < size ? first + ARITY : size;
+        for(std::size_t child = first + 1; child < end; ++child) {
+            if(mCompare(mHeap[best], mHeap[child])) {
+                best = child;
+            }
+        }
+
+        if(!mCompare(last, mHeap[best])) {
+            break;
+        }
+        mHeap[parent] = mHeap[best];
+        parent = best;
+    }
+    mHeap[parent] = last;
+}
+
+template<std::size_t ARITY>
+void HeapEventQueue<ARITY>::writeState(std::ostream &os) const {
+    writeBinary(os, static_cast<std::uint64_t>(mAllocations));
+    writeBinary(os, static_cast<std::uint64_t>(mHeap.capacity()));
+    writeBinary(os, static_cast<std::uint64_t>(mHeap.size()));
+    for(const Event &event : mHeap) {
+        writeEvent(os, event);
+    }
+}
+
+template<std::size_t ARITY>
+void HeapEventQueue<ARITY>::readState(std::istream &is,
+                                      const std::size_t &trains) {
+    std::uint64_t allocations, capacity, size;
+    readBinary(is, allocations);
+    readBinary(is, capacity);
+    readBinary(is, size);
+    if(capacity < size) {
+        throw std::runtime_error("checkpoint holds a damaged event queue");
+    }
+
+    // the events are read in heap order, so the layout is the one written,
+    // the storage grows as they are read rather than by a size from the file
+    mAllocations = allocations;
+    mHeap.clear();
+    for(std::uint64_t i = 0; i < size; ++i) {
+        mHeap.push_back(readEvent(is, trains));
+    }
+}
+
+#endif  // DT060G_PROJECT_EVENT_QUEUE_H
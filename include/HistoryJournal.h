@@ -0,0 +1,172 @@
+/*
+ * HistoryJournal.h
+ * Project
+ * Albin Ågren
+ */
+
+#ifndef DT060G_PROJECT_HISTORY_JOURNAL_H
+#define DT060G_PROJECT_HISTORY_JOURNAL_H
+
+#include "MyTime.h"
+
+#include <vector>
+#include <string>
+#include <mutex>
+#include <istream>
+#include <ostream>
+#include <cstddef>
+
+// Enum class for the events recorded in vehicle history
+enum class HistoryAction : unsigned char {
+    poolConnected, poolDisconnected, trainConnected, trainDisconnected
+};
+
+// Struct representing one event in the history of a vehicle, the subject is
+// the station id or train number and previous is the vehicle's record before
+struct HistoryRecord {
+    int time;
+    int subject;
+    unsigned previous;
+    HistoryAction action;
+};
+
+/**
+ * Class holding the history of every vehicle as fixed size records in one
+ * append-only journal
+ * The records of a vehicle are chained from its latest record backwards, so
+ * a vehicle only holds the index of its latest record and its number of
+ * records. Text is rendered when history is read. Records are never removed,
+ * a vehicle that forgets its latest records leaves them unreachable. The
+ * journal is safe to use from several threads at once
+ */
+class HistoryJournal {
+public:
+    // Index of the record before the first record of a vehicle
+    static constexpr unsigned NONE = ~0u;
+
+    /**
+     * Default constructor, makes an empty journal
+     */
+    HistoryJournal() = default;
+
+    // Default destructor
+    ~HistoryJournal() = default;
+
+    /**
+     * Function for adding the name of the next station, in station id order
+     *
+     * @param name, the station name
+     */
+    void addStation(const std::string &name);
+
+    /**
+     * Function for appending a record
+     * Throws std::length_error if the journal is full
+     *
+     * @param previous, the vehicle's latest record, or NONE
+     * @param action, the event
+     * @param subject, the station id or train number
+     * @param time, a Time object with the event time
+     * @return, the index of the new record
+     */
+    unsigned append(const unsigned &previous, const HistoryAction &action,
+                    const int &subject, const Time &time);
+
+    /**
+     * Function for walking back along the records of a vehicle
+     *
+     * @param record, the record to start from
+     * @param steps, the number of records to step back
+     * @return, the index of the record reached, or NONE
+     */
+    unsigned getPrevious(unsigned record, std::size_t steps) const;
+
+    /**
+     * Function for rendering the records of a vehicle as text
+     *
+     * @param last, the vehicle's latest record
+     * @param count, the number of records of the vehicle
+     * @return, a vector of strings with the events, oldest first
+     */
+    std::vector<std::string> render(unsigned last,
+                                    const std::size_t &count) const;
+
+    /**
+     * Function for writing the records of a vehicle as text, one event per
+     * line, without keeping the text
+     *
+     * @param os, the stream to write to
+     * @param last, the vehicle's latest record
+     * @param count, the number of records of the vehicle
+     */
+    void write(std::ostream &os, unsigned last,
+               const std::size_t &count) const;
+
+    /**
+     * Function for getting the number of records
+     *
+     * @return, the number of records, including unreachable ones
+     */
+    std::size_t size() const;
+
+    /**
+     * Function for getting the memory used by the records
+     *
+     * @return, the number of bytes
+     */
+    std::size_t getMemoryUsage() const;
+
+    /**
+     * Function for getting the memory held for the records, including room
+     * for records not yet appended
+     *
+     * @return, the number of bytes
+     */
+    std::size_t getMemoryHeld() const;
+
+    /**
+     * Function for getting the number of times the record storage has grown
+     *
+     * @return, the number of reallocations
+     */
+    unsigned long getAllocations() const;
+
+    /**
+     * Function for writing the first records to a checkpoint, a block at a
+     * time so records can be appended meanwhile
+     *
+     * @param os, the stream to write to
+     * @param count, the number of records to write
+     */
+    void writeRecords(std::ostream &os, const std::size_t &count) const;
+
+    /**
+     * Function for replacing the records with those of a checkpoint
+     * Throws std::runtime_error if the checkpoint is damaged
+     *
+     * @param is, the stream to read from
+     */
+    void readRecords(std::istream &is);
+
+// Private member functions
+private:
+    /**
+     * Function for rendering a record as text
+     *
+     * @param record, the record
+     * @return, a string with the timestamp and the event
+     */
+    std::string render(const HistoryRecord &record) const;
+
+// Private data members
+private:
+    mutable std::mutex mMutex;
+
+    std::vector<HistoryRecord> mRecords;
+
+    unsigned long mAllocations = 0;
+
+    std::vector<std::string> mStationNames;
+};
+
+#endif  // DT060G_PROJECT_HISTORY_JOURNAL_H
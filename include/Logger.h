@@ -0,0 +1,173 @@
+/*
+ * Logger.h
+ * Project
+ * Albin Ågren
+ */
+
+#ifndef DT060G_PROJECT_LOGGER_H
+#define DT060G_PROJECT_LOGGER_H
+
+#include <vector>
+#include <string>
+#include <fstream>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <cstddef>
+
+// Enum class for where log entries are written
+enum class LogSink { none, console, file, both };
+
+// Enum class for what a full ring buffer does to a new entry
+enum class Backpressure { block, drop };
+
+/**
+ * Class for writing log entries to the console and a log file on a
+ * background thread
+ * The simulation thread moves finished entries into a single producer,
+ * single consumer ring buffer without taking a lock. The writer thread takes
+ * every entry waiting, joins them and writes them with one call per sink.
+ * When the ring is full the producer waits for room, or drops the entry if
+ * asked to. The writer is started with the first entry, flush waits until
+ * every entry so far is written and the destructor writes what is left.
+ * On a machine with a single hardware thread entries are written directly
+ * by the caller. Entries must be written from one thread at a time
+ */
+class Logger {
+public:
+    // Number of entries the ring buffer holds by default
+    static constexpr std::size_t DEFAULT_CAPACITY = 4096;
+
+    /**
+     * Constructor, writes to the console and the log file once one is
+     * opened
+     *
+     * @param capacity, the number of entries the ring buffer holds, rounded
+     * up to a power of two
+     */
+    explicit Logger(const std::size_t &capacity = DEFAULT_CAPACITY);
+
+    // Destructor, writes the remaining entries and stops the writer
+    ~Logger();
+
+    // A logger owns a thread and is not copied
+    Logger(const Logger &) = delete;
+    Logger &operator=(const Logger &) = delete;
+
+    /**
+     * Function for opening the log file, truncating it
+     *
+     * @param path, the path of the file
+     * @return, a bool indicating if the file was opened
+     */
+    bool openFile(const std::string &path);
+
+    /**
+     * Function for setting where entries are written, entries already
+     * written keep their sinks
+     *
+     * @param sink, the sinks to write to
+     */
+    void setSink(const LogSink &sink);
+
+    /**
+     * Function for getting where entries are written
+     *
+     * @return, the sinks written to
+     */
+    LogSink getSink() const { return mSink; }
+
+    /**
+     * Function for setting what happens to an entry when the ring is full
+     *
+     * @param backpressure, block to wait for room or drop to lose the entry
+     */
+    void setBackpressure(const Backpressure &backpressure)
+        { mBackpressure = backpressure; }
+
+    /**
+     * Function for handing an entry to the writer
+     *
+     * @param entry, the formatted entry, moved into the ring
+     */
+    void write(std::string entry);
+
+    /**
+     * Function for waiting until every entry so far is written and flushing
+     * the sinks
+     */
+    void flush();
+
+    /**
+     * Function for getting the number of entries dropped on a full ring
+     *
+     * @return, the number of dropped entries
+     */
+    unsigned long getDropped() const { return mDropped; }
+
+    /**
+     * Function for getting the number of batches written
+     *
+     * @return, the number of batches
+     */
+    unsigned long getBatches() const;
+
+// Private member functions
+private:
+    /**
+     * Function run by the writer thread, writes entries until stopped
+     */
+    void run();
+
+    /**
+     * Function for writing a batch of entries to the sinks
+     *
+     * @param batch, the joined entries
+     */
+    void writeBatch(const std::string &batch);
+
+    /**
+     * Function for waking the writer if it waits for entries
+     */
+    void wake();
+
+// Private data members
+private:
+    std::vector<std::string> mRing;
+
+    std::size_t mMask;
+
+    // Count of entries handed over and taken, kept on separate cache lines
+    alignas(64) std::atomic<std::size_t> mHead;
+    alignas(64) std::atomic<std::size_t> mTail;
+
+    alignas(64) std::atomic<bool> mWaiting;
+
+    std::atomic<bool> mStopping;
+
+    mutable std::mutex mMutex;
+
+    std::condition_variable mAvailable;
+
+    std::condition_variable mWritten;
+
+    // Entries written to the sinks, guarded by mMutex
+    std::size_t mWrittenCount;
+
+    unsigned long mBatches;
+
+    std::thread mWriter;
+
+    std::ofstream mFile;
+
+    LogSink mSink;
+
+    Backpressure mBackpressure;
+
+    unsigned long mDropped;
+
+    bool mSynchronous;
+};
+
+#endif  // DT060G_PROJECT_LOGGER_H
@@ -0,0 +1,162 @@
+/*
+ * MinCostFlow.h
+ * Project
+ * Albin Ågren
+ */
+
+#ifndef DT060G_PROJECT_MIN_COST_FLOW_H
+#define DT060G_PROJECT_MIN_COST_FLOW_H
+
+#include <vector>
+#include <cstddef>
+
+/**
+ * Class for finding the cheapest maximum flow through a network whose arcs
+ * only lead forward in node order, such as a time-expanded network.
+ * The solver is primal-dual: node potentials start as the shortest distances
+ * from the source, found in one pass in node order, so negative costs are
+ * allowed. Each phase finds the shortest distances over the reduced costs
+ * with Dijkstra's algorithm on a bucket queue, stopping at the sink, and
+ * then pushes flow over the arcs of zero reduced cost with a depth-first
+ * search until none is left, so a phase saturates every shortest path at
+ * once. The number of phases is bounded by the number of distinct path
+ * costs, which is small when the costs are small integers.
+ */
+class MinCostFlow {
+public:
+    // Capacity of an arc without limit
+    static constexpr long long UNLIMITED = 1ll << 50;
+
+    /**
+     * Constructor
+     *
+     * @param nodes, the number of nodes, arcs must lead from a lower to a
+     * higher node
+     */
+    explicit MinCostFlow(const unsigned &nodes);
+
+    // Default destructor
+    ~MinCostFlow() = default;
+
+    /**
+     * Function for reserving room for arcs
+     *
+     * @param arcs, the number of arcs to make room for
+     */
+    void reserve(const std::size_t &arcs);
+
+    /**
+     * Function for adding an arc
+     *
+     * @param from, the node the arc leaves
+     * @param to, the node the arc enters, higher than from
+     * @param capacity, the largest flow over the arc
+     * @param cost, the cost per unit of flow
+     * @return, the index of the arc
+     */
+    unsigned addArc(const unsigned &from, const unsigned &to,
+                    const long long &capacity, const long long &cost);
+
+    /**
+     * Function for sending as much flow as possible from the source to the
+     * sink at the lowest cost
+     *
+     * @param source, the source node
+     * @param sink, the sink node
+     * @return, the cost of the flow
+     */
+    long long solve(const unsigned &source, const unsigned &sink);
+
+    /**
+     * Function for getting the flow over an arc after solving
+     *
+     * @param arc, the index of the arc
+     * @return, the flow
+     */
+    long long getFlow(const unsigned &arc) const
+        { return mCapacity[2 * arc + 1]; }
+
+    /**
+     * Function for getting the total flow sent after solving
+     *
+     * @return, the flow
+     */
+    long long getTotalFlow() const { return mTotalFlow; }
+
+    /**
+     * Function for getting the number of phases the last solve took
+     *
+     * @return, the number of phases
+     */
+    unsigned getPhases() const { return mPhases; }
+
+// Private member functions
+private:
+    /**
+     * Function for setting the potentials to the shortest distances from the
+     * source, relying on arcs leading forward in node order
+     *
+     * @param source, the source node
+     */
+    void initPotentials(const unsigned &source);
+
+    /**
+     * Function for updating the potentials with the shortest distances over
+     * the reduced costs of the residual network
+     *
+     * @param source, the source node
+     * @param sink, the sink node
+     * @return, a bool indicating if the sink can be reached
+     */
+    bool updatePotentials(const unsigned &source, const unsigned &sink);
+
+    /**
+     * Function for pushing flow over the residual arcs of zero reduced cost
+     * until the sink can not be reached over them
+     *
+     * @param source, the source node
+     * @param sink, the sink node
+     * @return, the flow pushed
+     */
+    long long pushBlockingFlow(const unsigned &source, const unsigned &sink);
+
+    /**
+     * Function for getting the reduced cost of a residual arc
+     *
+     * @param arc, the index of the residual arc
+     * @return, the reduced cost
+     */
+    long long reducedCost(const unsigned &arc) const;
+
+// Private data members
+private:
+    unsigned mNodes;
+
+    // Residual arcs in pairs, an arc at 2i and its reverse at 2i + 1, the
+    // reverse arc's capacity is the flow over the arc
+    std::vector<unsigned> mHead;
+    std::vector<long long> mCapacity;
+    std::vector<long long> mCost;
+
+    // Residual arcs leaving each node, as a linked list
+    std::vector<unsigned> mFirst;
+    std::vector<unsigned> mNext;
+
+    std::vector<long long> mPotential;
+
+    std::vector<long long> mDistance;
+
+    // Nodes by tentative distance, for the shortest distance search
+    std::vector<std::vector<unsigned>> mBuckets;
+
+    // Whether each node is free, on the path or dead while pushing flow
+    std::vector<char> mState;
+
+    std::vector<unsigned> mCurrent;
+
+    long long mTotalFlow;
+
+    unsigned mPhases;
+};
+
+#endif  // DT060G_PROJECT_MIN_COST_FLOW_H
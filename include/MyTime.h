@@ -13,13 +13,19 @@
 
 /**
  * Class for managing a duration in days, hours and minutes
+ * The duration is stored as a single count of minutes, so arithmetic and
+ * comparisons are plain integer operations, days, hours and minutes are
+ * only worked out when they are asked for or the time is formatted
  */
 class Time {
 public:
+    // Number of minutes in a day
+    static constexpr int MINUTES_PER_DAY = 24 * 60;
+
     /**
      * Default constructor
      */
-    Time() = default;
+    constexpr Time() = default;
 
     /**
      * Constructor for initializing all data members
@@ -27,26 +33,36 @@ public:
      * @param hours, the number of hours
      * @param minutes, the number of minutes
      */
-    Time(const int &hours, const int &minutes);
+    constexpr Time(const int &hours, const int &minutes):
+                                            mMinutes(hours * 60 + minutes) { }
 
     /**
      * Copy constructor
      *
      * @param time, a time object to be copied
      */
-    Time(const Time &time);
+    constexpr Time(const Time &time) = default;
 
     /**
      * Constructor for initalizing from time represented as a double
      *
-     * @param timeAsDouble, a timestamp represented as a double
+     * @param timeAsDouble, a duration in hours represented as a double
      */
     explicit Time(const double &timeAsDouble);
 
+    /**
+     * Function for making a time from a number of minutes
+     *
+     * @param minutes, the total number of minutes
+     * @return, the time object
+     */
+    static constexpr Time fromMinutes(const int &minutes)
+        { return Time(0, minutes); }
+
     /*
      * Overload of the assignment operator using a Time object
      */
-    Time &operator=(const Time &time);
+    constexpr Time &operator=(const Time &time) = default;
 
     /*
      * Overload of the assignment operator using a double (allows division)
@@ -54,60 +70,64 @@ public:
     Time &operator=(const double &timeAsDouble);
 
     /**
-     * Function for setting hours
+     * Function for setting day
      *
-     * @param hours, the number of hours
+     * @param day, the day
      */
-    void setDay(const int &day) { mDay = day; }
+    constexpr void setDay(const int &day)
+        { mMinutes += (day - getDay()) * MINUTES_PER_DAY; }
 
     /**
      * Function for setting hours
      *
      * @param hours, the number of hours
      */
-    void setHours(const int &hours) { mHours = hours; }
+    constexpr void setHours(const int &hours)
+        { mMinutes += (hours - getHours()) * 60; }
 
     /**
      * Function for setting minutes
      *
      * @param minutes, the number of minutes
      */
-    void setMinutes(const int minutes) { mMinutes = minutes; }
+    constexpr void setMinutes(const int minutes)
+        { mMinutes += minutes - getMinutes(); }
 
     /**
      * Function for getting day
      *
      * @return, the day
      */
-    int getDay() const { return mDay; }
+    constexpr int getDay() const { return mMinutes / MINUTES_PER_DAY; }
 
     /**
      * Function for getting hours
      *
      * @return, the number of hours
      */
-    int getHours() const { return mHours; }
+    constexpr int getHours() const { return mMinutes / 60 % 24; }
 
     /**
      * Function for getting minutes
      *
      * @return, the number of minutes
      */
-    int getMinutes() const { return mMinutes; }
+    constexpr int getMinutes() const { return mMinutes % 60; }
 
     /**
      * Function for total in minutes time as an int
      *
      * @return, an int representing the total time in minutes
      */
-    int getTotalTime() const;
+    constexpr int getTotalTime() const { return mMinutes; }
 
     /**
      * Function for time in hours as a double
      *
      * @return, a double representing the total time in hours
      */
-    double getTimeAsDouble() const;
+    constexpr double getTimeAsDouble() const
+        { return mMinutes % 60 / 60.0 + mMinutes / 60; }
 
     /**
      * Function for getting a formatted string of the stored time
@@ -119,58 +139,75 @@ public:
     /**
      * Overload of the + operator for adding two Time objects
      */
-    Time operator+(const Time &time) const;
+    constexpr Time operator+(const Time &time) const
+        { return fromMinutes(mMinutes + time.mMinutes); }
 
     /**
      * Overload of the + operator for subtracting two Time objects
      */
-    Time operator-(const Time &time) const;
+    constexpr Time operator-(const Time &time) const
+        { return fromMinutes(mMinutes - time.mMinutes); }
 
     /**
      * Overload of the < operator for comparing two Time objects
      */
-    bool operator<(const Time &time) const;
+    constexpr bool operator<(const Time &time) const
+        { return mMinutes < time.mMinutes; }
 
     /**
      * Overload of the > operator for comparing two Time objects
      */
-    bool operator>(const Time &time) const;
+    constexpr bool operator>(const Time &time) const
+        { return mMinutes > time.mMinutes; }
+
+    /**
+     * Overload of the <= operator for comparing two Time objects
+     */
+    constexpr bool operator<=(const Time &time) const
+        { return mMinutes <= time.mMinutes; }
 
     /**
      * Overload of the == operator for comparing two Time objects
      */
-    bool operator==(const Time &time) const;
+    constexpr bool operator==(const Time &time) const
+        { return mMinutes == time.mMinutes; }
 
     /**
      * Overload of the != operator for comparing two Time objects
      */
-    bool operator!=(const Time &time) const;
+    constexpr bool operator!=(const Time &time) const
+        { return mMinutes != time.mMinutes; }
 
     /**
      * Overload of the >= operator for comparing two Time objects
      */
-    bool operator>=(const Time &time) const;
+    constexpr bool operator>=(const Time &time) const
+        { return mMinutes >= time.mMinutes; }
 
     /**
      * Overload of the prefix increment operator, increments 1 minute
      */
-    Time &operator++();
+    constexpr Time &operator++() { ++mMinutes; return *this; }
 
     /**
      * Overload of the postfix increment operator, increments 1 minute
      */
-    const Time operator++(int);
+    constexpr const Time operator++(int)
+        { Time tmp = *this; ++mMinutes; return tmp; }
 
     /**
      * Overload of the += operator
      */
-    Time &operator+=(const Time &time);
+    constexpr Time &operator+=(const Time &time)
+        { mMinutes += time.mMinutes; return *this; }
 
 // Private data members
 private:
-    int mDay = 0, mHours = 0, mMinutes = 0;
+    int mMinutes = 0;
 };
 
+static_assert(sizeof(Time) == sizeof(int), "time should be a single int");
+
 /**
  * Overload of the << operator for outputting data to ostream object
  */
@@ -0,0 +1,163 @@
+/*
+ * ParallelSimulation.h
+ * Project
+ * Albin Ågren
+ */
+
+#ifndef DT060G_PROJECT_PARALLEL_SIMULATION_H
+#define DT060G_PROJECT_PARALLEL_SIMULATION_H
+
+#include "MyTime.h"
+#include "Event.h"
+#include "Simulation.h"
+
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+
+// Forward declarations
+class Controller;
+class Station;
+
+/**
+ * Class for running a simulation on several threads
+ * Stations are divided into partitions that each own an event queue. Train
+ * events up to departure run in the partition of the origin station, arrival
+ * and disassembly in the partition of the destination station, so the only
+ * events crossing partitions are arrivals. Partitions advance in windows no
+ * longer than the shortest possible cross-partition journey, which lets them
+ * run in parallel without ever receiving an event in their past
+ */
+class ParallelSimulation {
+public:
+    /**
+     * Constructor, assigns stations to partitions and computes the lookahead
+     *
+     * @param sim, a pointer to the simulation holding the scheduled events
+     * @param controller, a pointer to the controller owning the trains
+     * @param threads, the desired number of worker threads
+     */
+    ParallelSimulation(Simulation *sim, Controller *controller,
+                       const unsigned &threads);
+
+    // Destructor
+    ~ParallelSimulation();
+
+    /**
+     * Function for running the simulation to the end time and finishing all
+     * departed trains, equivalent to doing so sequentially on the simulation
+     *
+     * @param endTime, the end time of the simulation
+     */
+    void run(const Time &endTime);
+
+    /**
+     * Function for dividing the stations into partitions with roughly the
+     * same number of events, busiest stations first
+     *
+     * @param controller, a pointer to the controller owning the trains
+     * @param threads, the desired number of partitions
+     * @param origins, a vector to fill with the partition of each train's
+     * origin station, indexed by train
+     * @param destinations, a vector to fill with the partition of each
+     * train's destination station, indexed by train
+     * @return, the number of partitions used
+     */
+    static unsigned assignStations(Controller *controller,
+                                   const unsigned &threads,
+                                   std::vector<unsigned> &origins,
+                                   std::vector<unsigned> &destinations);
+
+    /**
+     * Function for getting the number of partitions, one per worker thread
+     *
+     * @return, the number of partitions
+     */
+    unsigned getNoOfPartitions() const { return mPartitions.size(); }
+
+    /**
+     * Function for getting the length of the synchronization windows
+     *
+     * @return, the lookahead in minutes
+     */
+    int getLookahead() const { return mLookahead; }
+
+    /**
+     * Function for getting the number of windows processed in the last run
+     *
+     * @return, the number of windows
+     */
+    unsigned long getWindows() const { return mWindows; }
+
+// Private member functions
+private:
+    class Partition;
+
+    /**
+     * Function for getting the partition an event belongs to
+     *
+     * @param event, the event
+     * @return, the index of the partition
+     */
+    unsigned getPartition(const Event &event) const;
+
+    /**
+     * Function run by each worker thread
+     *
+     * @param index, the index of the partition processed by the thread
+     */
+    void work(const unsigned &index);
+
+    /**
+     * Function for waiting until all worker threads reach the same point
+     */
+    void synchronize();
+
+    /**
+     * Function for moving the events sent to a partition into its queue
+     *
+     * @param index, the index of the receiving partition
+     */
+    void deliver(const unsigned &index);
+
+    /**
+     * Function for writing the log entries held by the partitions, in the
+     * order they would have been written by a sequential run
+     */
+    void writeLogs();
+
+    /**
+     * Function for computing the end of the next window
+     *
+     * @return, a bool indicating if there are events left before the end time
+     */
+    bool nextWindow();
+
+// Private data members
+private:
+    Simulation *mSim;
+
+    Controller *mController;
+
+    std::vector<std::unique_ptr<Partition>> mPartitions;
+
+    // Partition of the origin and destination station, indexed by train
+    std::vector<unsigned> mOrigins, mDestinations;
+
+    int mLookahead;
+
+    int mEndTime, mWindowEnd;
+
+    bool mFinished;
+
+    unsigned long mWindows;
+
+    std::mutex mMutex;
+
+    std::condition_variable mCondition;
+
+    unsigned mWaiting, mGeneration;
+};
+
+#endif  // DT060G_PROJECT_PARALLEL_SIMULATION_H
@@ -0,0 +1,159 @@
+/*
+ * RecordWriter.h
+ * Project
+ * Albin Ågren
+ */
+
+#ifndef DT060G_PROJECT_RECORD_WRITER_H
+#define DT060G_PROJECT_RECORD_WRITER_H
+
+#include "MyTime.h"
+
+#include <string>
+#include <fstream>
+#include <cstddef>
+
+// Forward declaration
+class Train;
+
+// Enum class for the formats of the event records
+enum class RecordFormat { jsonl, csv };
+
+/**
+ * Class for writing one machine readable record per train transition, as
+ * JSON Lines or CSV
+ * Records are formatted with std::to_chars straight into a string and
+ * gathered in a buffer that is written to the file in large blocks. A
+ * record holds the event name, the event time, the train number, the origin
+ * and destination station ids, the scheduled and current departure and
+ * arrival, the speed and top speed, the arrival and departure delay and the
+ * ids of the vehicles in the train. Times are minutes since the start of the
+ * first day. Formatting may be done from several threads at once, writing
+ * from one thread at a time
+ */
+class RecordWriter {
+public:
+    // Size of the buffer gathering records before they are written
+    static constexpr std::size_t BUFFER_SIZE = 1 << 16;
+
+    /**
+     * Constructor, no file is open until one is opened
+     */
+    RecordWriter();
+
+    // Destructor, writes the buffered records
+    ~RecordWriter();
+
+    // A writer owns its file and is not copied
+    RecordWriter(const RecordWriter &) = delete;
+    RecordWriter &operator=(const RecordWriter &) = delete;
+
+    /**
+     * Function for opening the record file, truncating it, writes the header
+     * line of a CSV file
+     *
+     * @param path, the path of the file
+     * @param format, the format of the records
+     * @return, a bool indicating if the file was opened
+     */
+    bool open(const std::string &path, const RecordFormat &format);
+
+    /**
+     * Function for writing the buffered records and closing the file
+     */
+    void close();
+
+    /**
+     * Function for discerning if records are written
+     *
+     * @return, a bool indicating if a record file is open
+     */
+    bool isOpen() const { return mFile.is_open(); }
+
+    /**
+     * Function for getting the format of the records
+     *
+     * @return, the record format
+     */
+    RecordFormat getFormat() const { return mFormat; }
+
+    /**
+     * Function for formatting the record of a train transition, including
+     * the line break
+     *
+     * @param record, the string the record is appended to
+     * @param event, the name of the transition
+     * @param time, a Time object with the event time
+     * @param train, a pointer to the train
+     */
+    void format(std::string &record, const char *event, const Time &time,
+                const Train *train) const;
+
+    /**
+     * Function for writing a formatted record
+     *
+     * @param record, the record including its line break
+     */
+    void write(const std::string &record);
+
+    /**
+     * Function for writing the buffered records to the file
+     */
+    void flush();
+
+    /**
+     * Function for getting the number of records written
+     *
+     * @return, the number of records
+     */
+    unsigned long getRecords() const { return mRecords; }
+
+    /**
+     * Function for getting the number of bytes written, header included
+     *
+     * @return, the number of bytes
+     */
+    unsigned long long getBytes() const { return mBytes; }
+
+// Private member functions
+private:
+    /**
+     * Function for appending a field name, quoted for JSON Lines and
+     * left out of CSV where the header names the columns
+     *
+     * @param record, the string the field is appended to
+     * @param name, the field name
+     */
+    void appendName(std::string &record, const char *name) const;
+
+    /**
+     * Function for appending an integer
+     *
+     * @param record, the string the number is appended to
+     * @param value, the number
+     */
+    static void appendInteger(std::string &record, const long long &value);
+
+    /**
+     * Function for appending a floating point number, in the shortest form
+     * that reads back to the same value
+     *
+     * @param record, the string the number is appended to
+     * @param value, the number
+     */
+    static void appendDecimal(std::string &record, const double &value);
+
+// Private data members
+private:
+    std::ofstream mFile;
+
+    std::string mBuffer;
+
+    RecordFormat mFormat;
+
+    unsigned long mRecords;
+
+    unsigned long long mBytes;
+};
+
+#endif  // DT060G_PROJECT_RECORD_WRITER_H
@@ -0,0 +1,115 @@
+/*
+ * Router.h
+ * Project
+ * Albin Ågren
+ */
+
+#ifndef DT060G_PROJECT_ROUTER_H
+#define DT060G_PROJECT_ROUTER_H
+
+#include "DistanceTable.h"
+
+#include <vector>
+#include <unordered_map>
+#include <cstddef>
+
+/**
+ * Class for finding the shortest route between stations over the links of
+ * the map, for trains between stations without a direct link
+ * Routes are found with Dijkstra's algorithm from the origin to every other
+ * station, and the result is cached per origin so later queries from the
+ * same station are lookups. All stations' results are kept while they fit
+ * in MAX_CACHED_ENTRIES distances, beyond that the cache is cleared when
+ * full. A router is not safe to query from several threads at once
+ */
+class Router {
+public:
+    // Largest number of distances held in the cache
+    static constexpr std::size_t MAX_CACHED_ENTRIES = 1 << 24;
+
+    /**
+     * Constructor, makes a router without stations
+     */
+    Router(): mStations(0), mSearches(0) { }
+
+    // Default destructor
+    ~Router() = default;
+
+    /**
+     * Function for building the graph of links, links apply in both
+     * directions, clears the cache
+     *
+     * @param stations, the number of stations
+     * @param links, the distances between pairs of stations
+     */
+    void build(const unsigned &stations, const std::vector<Link> &links);
+
+    /**
+     * Function for getting the length of the shortest route between two
+     * stations
+     *
+     * @param from, the id of the origin station
+     * @param to, the id of the destination station
+     * @return, the route length, or NaN if there is no route
+     */
+    double getDistance(const unsigned &from, const unsigned &to);
+
+    /**
+     * Function for getting the stations along the shortest route between two
+     * stations
+     *
+     * @param from, the id of the origin station
+     * @param to, the id of the destination station
+     * @return, the station ids from origin to destination, empty if there is
+     * no route
+     */
+    std::vector<unsigned> getRoute(const unsigned &from, const unsigned &to);
+
+    /**
+     * Function for getting the number of searches run so far
+     *
+     * @return, the number of searches, one per origin not in the cache
+     */
+    unsigned long getSearches() const { return mSearches; }
+
+    /**
+     * Function for getting the memory held by the graph and the cache
+     *
+     * @return, the number of bytes allocated
+     */
+    std::size_t getMemoryUsage() const;
+
+// Private member functions
+private:
+    // Struct representing the shortest routes from one station
+    struct Tree {
+        std::vector<double> distances;
+        std::vector<unsigned> previous;
+    };
+
+    /**
+     * Function for getting the shortest routes from a station, searching
+     * the graph unless they are cached
+     *
+     * @param from, the id of the origin station
+     * @return, a reference to the shortest routes
+     */
+    const Tree &getTree(const unsigned &from);
+
+// Private data members
+private:
+    unsigned mStations;
+
+    // Links of station i are at mOffsets[i] to mOffsets[i + 1]
+    std::vector<std::size_t> mOffsets;
+
+    std::vector<unsigned> mNeighbours;
+
+    std::vector<double> mLengths;
+
+    std::unordered_map<unsigned, Tree> mCache;
+
+    unsigned long mSearches;
+};
+
+#endif  // DT060G_PROJECT_ROUTER_H
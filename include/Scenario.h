@@ -0,0 +1,120 @@
+/*
+ * Scenario.h
+ * Project
+ * Albin Ågren
+ */
+
+#ifndef DT060G_PROJECT_SCENARIO_H
+#define DT060G_PROJECT_SCENARIO_H
+
+#include "MyTime.h"
+
+#include <vector>
+#include <string>
+
+// Struct representing a vehicle as described in the station file
+struct VehicleData {
+    int id;
+    int type;
+    int param0;
+    int param1;
+};
+
+// Struct representing a station and its initial vehicle pool
+struct StationData {
+    std::string name;
+    std::vector<VehicleData> vehicles;
+};
+
+// Struct representing the distance between two stations
+struct DistanceData {
+    std::string station0;
+    std::string station1;
+    double distance;
+};
+
+// Struct representing a train as described in the train file
+struct TrainData {
+    int trainNumber;
+    std::string origin;
+    std::string destination;
+    Time departure;
+    Time arrival;
+    int topSpeed;
+    std::vector<int> requiredVehicles;
+};
+
+/**
+ * Class holding a parsed scenario, the stations, distances and trains read
+ * from the data files. A scenario is never changed after it is read, so any
+ * number of controllers can be built from it, also on different threads
+ */
+class Scenario {
+public:
+    /**
+     * Constructor, reads all data files in a directory
+     *
+     * @param directory, the directory holding the data files
+     */
+    explicit Scenario(const std::string &directory);
+
+    // Default destructor
+    ~Scenario() = default;
+
+    /**
+     * Function for reading the stations and their vehicle pools from file
+     *
+     * @param directory, the directory holding the data files
+     * @return, a vector of the stations in file order
+     */
+    static std::vector<StationData> readStations(const std::string &directory);
+
+    /**
+     * Function for reading the station distances from file
+     *
+     * @param directory, the directory holding the data files
+     * @return, a vector of the distances in file order
+     */
+    static std::vector<DistanceData> readDistances(
+                                            const std::string &directory);
+
+    /**
+     * Function for reading the trains from file
+     *
+     * @param directory, the directory holding the data files
+     * @return, a vector of the trains in file order
+     */
+    static std::vector<TrainData> readTrains(const std::string &directory);
+
+    /**
+     * Function for getting the stations of the scenario
+     *
+     * @return, a reference to the vector of stations
+     */
+    const std::vector<StationData> &getStations() const { return mStations; }
+
+    /**
+     * Function for getting the station distances of the scenario
+     *
+     * @return, a reference to the vector of distances
+     */
+    const std::vector<DistanceData> &getDistances() const
+        { return mDistances; }
+
+    /**
+     * Function for getting the trains of the scenario
+     *
+     * @return, a reference to the vector of trains
+     */
+    const std::vector<TrainData> &getTrains() const { return mTrains; }
+
+// Private data members
+private:
+    std::vector<StationData> mStations;
+
+    std::vector<DistanceData> mDistances;
+
+    std::vector<TrainData> mTrains;
+};
+
+#endif  // DT060G_PROJECT_SCENARIO_H
@@ -9,10 +9,37 @@
 
 #include "MyTime.h"
 #include "Event.h"
+#include "EventQueue.h"
 
-#include <queue>
 #include <vector>
 #include <memory>
+#include <string>
+#include <istream>
+#include <ostream>
+#include <cstddef>
+
+// Forward declaration
+class Controller;
+
+// Struct representing a log entry held back by a simulation, tagged with
+// the event that produced it so entries can be merged in processing order,
+// record marks a structured event record rather than log text
+struct LogEntry {
+    int time;
+    int trainNumber;
+    std::string text;
+    bool record;
+};
+
+// Struct representing the time, the queued events and the counters of a
+// simulation, as kept by a snapshot
+struct SimulationState {
+    Time time;
+    Event currentEvent;
+    std::shared_ptr<const EventQueue> queue;
+    std::vector<unsigned long> allocationsPerDay, eventsPerDay;
+    unsigned long eventsProcessed;
+};
 
 /**
  * Class for managing the simulation of events
@@ -21,11 +48,21 @@ class Simulation {
 public:
     /**
      * Constructor
+     *
+     * @param queueType, the event queue implementation to use
      */
-    Simulation(): mCurrentTime(Time(0, 0)), mEventQueue() { }
+    explicit Simulation(const QueueType &queueType = binaryHeap);
 
-    // Default destructor
-    ~Simulation() = default;
+    // Virtual destructor
+    virtual ~Simulation() { }
+
+    /**
+     * Function for setting the controller that handles the events
+     *
+     * @param controller, a pointer to the controller
+     */
+    void setController(Controller *const controller)
+        { mController = controller; }
 
     /**
      * Function for setting simulation time
@@ -46,14 +83,28 @@ public:
      *
      * @return, a Time object representing time of next event
      */
-    Time getNextEventTime() const { return mEventQueue.top()->getTime(); }
+    Time getNextEventTime() const { return mEventQueue->top().getTime(); }
+
+    /**
+     * Function for getting the next event without processing it
+     *
+     * @return, a copy of the next event
+     */
+    Event getNextEvent() const { return mEventQueue->top(); }
 
     /**
      * Function for scheduling a new event
      *
-     * @param event, a shared_ptr to an event object
+     * @param event, the event to be added to the queue
      */
-    void scheduleEvent(const std::shared_ptr<Event> &event);
+    virtual void scheduleEvent(const Event &event);
+
+    /**
+     * Function for removing all scheduled events from the queue
+     *
+     * @return, a vector with the removed events in processing order
+     */
+    std::vector<Event> takeEvents();
 
     /**
      * Function for processing the next event in the queue
@@ -71,15 +122,154 @@ public:
      *
      * @return, a bool indicating if simulation queue is empty
      */
-    bool done() { return mEventQueue.empty(); }
+    bool done() { return mEventQueue->empty(); }
+
+    /**
+     * Function for setting whether log entries are held by the simulation
+     * instead of being written out
+     *
+     * @param capture, a bool indicating if log entries should be held
+     */
+    void setCaptureLog(const bool &capture) { mCaptureLog = capture; }
+
+    /**
+     * Function for discerning if log entries are held by the simulation
+     *
+     * @return, a bool indicating if log entries are held
+     */
+    bool isCapturingLog() const { return mCaptureLog; }
+
+    /**
+     * Function for holding a log entry produced by the current event
+     *
+     * @param entry, the formatted log entry
+     * @param record, a bool indicating if the entry is an event record
+     */
+    void captureLog(const std::string &entry, const bool &record = false);
+
+    /**
+     * Function for getting the held log entries, in processing order
+     *
+     * @return, a reference to the vector of held log entries
+     */
+    std::vector<LogEntry> &getCapturedLog() { return mCapturedLog; }
+
+    /**
+     * Function for getting the number of events processed so far
+     *
+     * @return, the number of processed events
+     */
+    unsigned long getEventsProcessed() const { return mEventsProcessed; }
+
+    /**
+     * Function for getting the number of queue allocations made on each
+     * simulated day
+     *
+     * @return, a vector with the allocation count indexed by day
+     */
+    const std::vector<unsigned long> &getAllocationsPerDay() const
+        { return mAllocationsPerDay; }
+
+    /**
+     * Function for getting the number of events scheduled on each
+     * simulated day
+     *
+     * @return, a vector with the event count indexed by day
+     */
+    const std::vector<unsigned long> &getEventsPerDay() const
+        { return mEventsPerDay; }
+
+    /**
+     * Function for adding the event and queue counters of another
+     * simulation to this one
+     *
+     * @param other, the simulation whose counters are added
+     */
+    void addCounters(const Simulation &other);
+
+    /**
+     * Function for saving the time, the queued events and the counters, the
+     * queue is copied as it is, without reordering the events
+     *
+     * @return, the saved state
+     */
+    SimulationState saveState() const;
+
+    /**
+     * Function for returning to a saved state, the queue is replaced with a
+     * copy of the saved one so the state can be returned to again
+     *
+     * @param state, the saved state
+     */
+    void restoreState(const SimulationState &state);
+
+    /**
+     * Function for writing a saved state to a checkpoint, with the type of
+     * its event queue
+     *
+     * @param os, the stream to write to
+     * @param state, the saved state
+     */
+    static void writeState(std::ostream &os, const SimulationState &state);
+
+    /**
+     * Function for returning to a state read from a checkpoint, the event
+     * queue is replaced with one of the type that wrote it
+     * Throws std::runtime_error if the checkpoint is damaged
+     *
+     * @param is, the stream to read from
+     * @param trains, the number of trains the events can refer to
+     */
+    void readState(std::istream &is, const std::size_t &trains);
+
+// Protected member functions
+protected:
+    /**
+     * Function for making an empty event queue
+     *
+     * @param queueType, the event queue implementation to use
+     * @return, a unique_ptr to the queue
+     */
+    static std::unique_ptr<EventQueue> makeQueue(const QueueType &queueType);
+
+    /**
+     * Function for adding an event to the queue without counting it, for
+     * events already counted when they were first scheduled
+     *
+     * @param event, the event to be added to the queue
+     */
+    void queueEvent(const Event &event) { mEventQueue->push(event); }
+
+    /**
+     * Function for no longer counting a processed event, for events that
+     * were undone
+     */
+    void uncountProcessed() { --mEventsProcessed; }
+
+    /**
+     * Function for recording queue usage for the current simulated day
+     *
+     * @param allocations, the number of queue allocations made by the event
+     */
+    void countEvent(const unsigned long &allocations);
 
 // Private data members
 private:
     Time mCurrentTime;
 
-    std::priority_queue<std::shared_ptr<Event>,
-                        std::vector<std::shared_ptr<Event>>,
-                        EventComparison> mEventQueue;
+    Event mCurrentEvent;
+
+    Controller *mController;
+
+    std::unique_ptr<EventQueue> mEventQueue;
+
+    std::vector<unsigned long> mAllocationsPerDay, mEventsPerDay;
+
+    unsigned long mEventsProcessed = 0;
+
+    bool mCaptureLog = false;
+
+    std::vector<LogEntry> mCapturedLog;
 };
 
 #endif  // DT060G_PROJECT_SIMULATION_H
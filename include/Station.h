@@ -10,56 +10,93 @@
 #include <string>
 #include <memory>
 #include <vector>
-#include <map>
+#include <array>
+#include <istream>
+#include <ostream>
 
 // Forward declaration
 class Vehicle;
 
 /**
  * Class representing a single station
+ * The vehicle pool is kept in one queue per vehicle type, so a vehicle of a
+ * type is found and detached in constant time. Vehicles are numbered as they
+ * are attached, the oldest vehicle of a type is detached first and the pool
+ * is listed in the order the vehicles were attached. A queue keeps the
+ * memory of detached vehicles for later ones, so once the pool has reached
+ * its largest size attaching and detaching do not allocate
  */
 class Station {
 public:
+    // Number of vehicle types
+    static constexpr int VEHICLE_TYPES = 6;
+
     /**
      * Constructor
      *
-     * @param name, the number of hours
+     * @param name, the station name
+     * @param id, the index of the station in the controller
      */
-    explicit Station(const std::string &name): mName(name) { }
+    Station(const std::string &name, const unsigned &id): mName(name),
+                                                          mId(id),
+                                                          mAttached(0),
+                                                          mAllocations(0) { }
 
     // Default destructor
     ~Station() = default;
 
     /**
-     * Function for setting the distance to another station
+     * Function for getting station name
      *
-     * @param stationName, the name of the other station
-     * @param distance, a double with the distance to the other station
+     * @return, a reference to the station name
      */
-    void setDistance(const std::string &stationName, const double &distance);
+    const std::string &getName() const { return mName; }
 
     /**
-     * Function for getting station name
+     * Function for getting station id, used to look up distances
      *
-     * @return, the station name
+     * @return, the station id
      */
-    std::string getName() const { return mName; }
+    unsigned getId() const { return mId; }
 
     /**
-     * Function for getting station vehicle pool
+     * Function for getting station vehicle pool, use forEachVehicle to go
+     * through the pool without copying it
      *
      * @return, a vector of pointers to the attached vehicles
      */
-    std::vector<Vehicle *> getVehicles() const { return mVehicles; }
+    std::vector<Vehicle *> getVehicles() const;
+
+    /**
+     * Function for calling a function on every vehicle in the pool, in the
+     * order the vehicles were attached
+     *
+     * @param function, a callable taking a pointer to a vehicle
+     */
+    template<typename Function>
+    void forEachVehicle(Function function) const;
 
     /**
-     * Function for getting distance to another station
+     * Function for replacing station vehicle pool
      *
-     * @param stationName, the name of the other station
-     * @return, a double with the distance to the other station
+     * @param vehicles, a vector of pointers to the attached vehicles
      */
-    double getDistance(const std::string &stationName) const
-        { return mDistances.at(stationName); }
+    void setVehicles(const std::vector<Vehicle *> &vehicles);
+
+    /**
+     * Function for getting the number of vehicles in the pool
+     *
+     * @return, the number of vehicles
+     */
+    std::size_t getNoOfVehicles() const;
+
+    /**
+     * Function for getting the number of vehicles of a type in the pool
+     *
+     * @param type, the vehicle type
+     * @return, the number of vehicles of the type
+     */
+    std::size_t getNoOfVehicles(const int &type) const;
 
     /**
      * Function for attaching a vehicle to station pool
@@ -78,13 +115,134 @@ public:
      */
     bool detachVehicle(const int &type, Vehicle **vehicle);
 
+    /**
+     * Function for detaching the oldest vehicle of the specified type that
+     * passes a test
+     *
+     * @param type, the type of the desired vehicle
+     * @param accept, a callable taking a pointer to a vehicle and returning
+     * a bool indicating if the vehicle may be detached
+     * @param vehicle, a pointer to a pointer in which to store the
+     * detached vehicle
+     * @return, a bool indicating if a vehicle was found
+     */
+    template<typename Predicate>
+    bool detachVehicle(const int &type, Predicate accept, Vehicle **vehicle);
+
+    /**
+     * Function for detaching a particular vehicle
+     *
+     * @param vehicle, a pointer to the vehicle
+     * @return, a bool indicating if the vehicle was in the pool
+     */
+    bool detachVehicle(Vehicle *const vehicle);
+
+    /**
+     * Function for getting the number of times the pool storage has grown
+     *
+     * @return, the number of storage allocations since construction
+     */
+    unsigned long getAllocations() const { return mAllocations; }
+
+    /**
+     * Function for writing the vehicle pool to a checkpoint, each vehicle
+     * by its table row with the stamp ordering it
+     *
+     * @param os, the stream to write to
+     */
+    void writeState(std::ostream &os) const;
+
+    /**
+     * Function for reading the vehicle pool from a checkpoint, the vehicles
+     * read are pointed at the station
+     * Throws std::runtime_error if the checkpoint is damaged
+     *
+     * @param is, the stream to read from
+     * @param vehicles, the vehicles by table row
+     */
+    void readState(std::istream &is,
+                   const std::vector<std::unique_ptr<Vehicle>> &vehicles);
+
+// Private member functions
+private:
+    // Struct representing a vehicle in the pool and when it was attached
+    struct PoolEntry {
+        unsigned long attached;
+        Vehicle *vehicle;
+    };
+
+    // Struct representing the vehicles of one type, the queue starts at
+    // entries[front] and detached entries are reused once they are half
+    // the vector
+    struct PoolQueue {
+        std::vector<PoolEntry> entries;
+        std::size_t front = 0;
+    };
+
+    /**
+     * Function for adding a vehicle to the queue of its type
+     *
+     * @param vehicle, a pointer to the vehicle
+     */
+    void pushVehicle(Vehicle *const vehicle);
+
+    /**
+     * Function for removing a vehicle from the queue of its type
+     *
+     * @param type, the vehicle type
+     * @param position, the position of the vehicle in the queue entries
+     */
+    void removeEntry(const int &type, const std::size_t &position);
+
 // Private data members
 private:
     std::string mName;
 
-    std::vector<Vehicle *> mVehicles;
+    unsigned mId;
+
+    std::array<PoolQueue, VEHICLE_TYPES> mVehicles;
 
-    std::map<std::string, double> mDistances;
+    unsigned long mAttached;
+
+    unsigned long mAllocations;
 };
 
+template<typename Function>
+void Station::forEachVehicle(Function function) const {
+    // merge the queues, each is already in attach order
+    std::array<std::size_t, VEHICLE_TYPES> next;
+    for(int type = 0; type < VEHICLE_TYPES; ++type) {
+        next[type] = mVehicles[type].front;
+    }
+    for(std::size_t left = getNoOfVehicles(); left > 0; --left) {
+        int oldest = -1;
+        for(int type = 0; type < VEHICLE_TYPES; ++type) {
+            if(next[type] < mVehicles[type].entries.size() &&
+               (oldest < 0 || mVehicles[type].entries[next[type]].attached <
+                              mVehicles[oldest].entries[next[oldest]]
+                                                             .attached)) {
+                oldest = type;
+            }
+        }
+        function(mVehicles[oldest].entries[next[oldest]++].vehicle);
+    }
+}
+
+template<typename Predicate>
+bool Station::detachVehicle(const int &type, Predicate accept,
+                            Vehicle **vehicle) {
+    if(type < 0 || type >= VEHICLE_TYPES) {
+        return false;
+    }
+    const PoolQueue &queue = mVehicles[type];
+    for(std::size_t i = queue.front; i < queue.entries.size(); ++i) {
+        if(accept(queue.entries[i].vehicle)) {
+            *vehicle = queue.entries[i].vehicle;
+            removeEntry(type, i);
+            return true;
+        }
+    }
+    return false;
+}
+
 #endif  // DT060G_PROJECT_STATION_H
@@ -0,0 +1,131 @@
+/*
+ * SupplyTimeline.h
+ * Project
+ * Albin Ågren
+ */
+
+#ifndef DT060G_PROJECT_SUPPLY_TIMELINE_H
+#define DT060G_PROJECT_SUPPLY_TIMELINE_H
+
+#include "MyTime.h"
+
+#include <vector>
+#include <memory>
+#include <cstddef>
+
+// Forward declarations
+class Station;
+class Train;
+
+/**
+ * Class for predicting the vehicles of each type at each station over the
+ * timetable, without running the simulation
+ * Every train is taken to run to time: it takes the vehicles it needs from
+ * its origin 30 minutes before departure and leaves them at its destination
+ * 20 minutes after arrival. Each station and type gets the times its count
+ * changes, the count after each and the lowest count so far, so the count
+ * at a time and the earliest shortage are binary searches. Vehicles taken
+ * at a time are counted before those left, so a shortage is never hidden
+ * by a train arriving at the same minute
+ */
+class SupplyTimeline {
+public:
+    /**
+     * Constructor, makes an empty timeline
+     */
+    SupplyTimeline(): mStations(0) { }
+
+    // Default destructor
+    ~SupplyTimeline() = default;
+
+    /**
+     * Function for building the timeline, replaces any earlier one
+     *
+     * @param stations, the stations and their initial vehicle pools
+     * @param trains, the trains, not yet assembled
+     */
+    void build(const std::vector<std::unique_ptr<Station>> &stations,
+               const std::vector<std::unique_ptr<Train>> &trains);
+
+    /**
+     * Function for getting the predicted number of vehicles of a type at a
+     * station, after every change up to and including a time
+     * Throws std::out_of_range if the station or type is unknown
+     *
+     * @param station, the id of the station
+     * @param type, the vehicle type
+     * @param time, the time
+     * @return, the number of vehicles, negative if trains are short of them
+     */
+    int getInventory(const unsigned &station, const int &type,
+                     const Time &time) const;
+
+    /**
+     * Function for getting the first time a station is predicted to be
+     * short of a vehicle type
+     * Throws std::out_of_range if the station or type is unknown
+     *
+     * @param station, the id of the station
+     * @param type, the vehicle type
+     * @param time, a Time object set to the time of the shortage
+     * @return, a bool indicating if the station is ever short
+     */
+    bool getEarliestShortage(const unsigned &station, const int &type,
+                             Time &time) const;
+
+    /**
+     * Function for getting the lowest predicted number of vehicles of a
+     * type at a station over the timetable
+     * Throws std::out_of_range if the station or type is unknown
+     *
+     * @param station, the id of the station
+     * @param type, the vehicle type
+     * @return, the lowest number, negative if trains are short of them
+     */
+    int getLowestInventory(const unsigned &station, const int &type) const;
+
+    /**
+     * Function for getting the number of stations in the timeline
+     *
+     * @return, the number of stations
+     */
+    unsigned getNoOfStations() const { return mStations; }
+
+    /**
+     * Function for getting the number of changes over all stations and types
+     *
+     * @return, the number of changes
+     */
+    std::size_t getNoOfChanges() const { return mTimes.size(); }
+
+// Private member functions
+private:
+    /**
+     * Function for getting the row of a station and type
+     * Throws std::out_of_range if either is unknown
+     *
+     * @param station, the id of the station
+     * @param type, the vehicle type
+     * @return, the row
+     */
+    std::size_t getRow(const unsigned &station, const int &type) const;
+
+// Private data members
+private:
+    unsigned mStations;
+
+    // The initial count of each row, by station id and then type
+    std::vector<int> mInitial;
+
+    // Changes of each row in time order, in rows starting at the offsets
+    std::vector<std::size_t> mOffsets;
+    std::vector<int> mTimes;
+
+    // The count after the changes at each time
+    std::vector<int> mInventory;
+
+    // The lowest count up to each time, never increasing along a row
+    std::vector<int> mLowest;
+};
+
+#endif  // DT060G_PROJECT_SUPPLY_TIMELINE_H
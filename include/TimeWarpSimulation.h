@@ -0,0 +1,216 @@
+/*
+ * TimeWarpSimulation.h
+ * Project
+ * Albin Ågren
+ */
+
+#ifndef DT060G_PROJECT_TIME_WARP_SIMULATION_H
+#define DT060G_PROJECT_TIME_WARP_SIMULATION_H
+
+#include "MyTime.h"
+#include "Event.h"
+#include "Simulation.h"
+
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+
+// Forward declaration
+class Controller;
+
+/**
+ * Class for running a simulation optimistically on several threads
+ * Stations are divided into processes like in the conservative parallel
+ * simulation, but processes do not wait for each other. Each executes its
+ * events speculatively and saves the state they change, an arrival that
+ * turns up in a process' past rolls it back and cancels the arrivals it sent
+ * with anti-messages. Periodically all processes agree on the global virtual
+ * time (GVT), the earliest event any process could still roll back to, and
+ * commit the events and log entries before it
+ */
+class TimeWarpSimulation {
+public:
+    /**
+     * Constructor, assigns stations to processes
+     *
+     * @param sim, a pointer to the simulation holding the scheduled events
+     * @param controller, a pointer to the controller owning the trains
+     * @param threads, the desired number of worker threads
+     */
+    TimeWarpSimulation(Simulation *sim, Controller *controller,
+                       const unsigned &threads);
+
+    // Destructor
+    ~TimeWarpSimulation();
+
+    /**
+     * Function for running the simulation to the end time and finishing all
+     * departed trains, equivalent to doing so sequentially on the simulation
+     *
+     * @param endTime, the end time of the simulation
+     */
+    void run(const Time &endTime);
+
+    /**
+     * Function for getting the number of processes, one per worker thread
+     *
+     * @return, the number of processes
+     */
+    unsigned getNoOfPartitions() const { return mProcesses.size(); }
+
+    /**
+     * Function for getting the number of events executed in the last run,
+     * including those later rolled back
+     *
+     * @return, the number of executed events
+     */
+    unsigned long getEventsExecuted() const { return mExecuted; }
+
+    /**
+     * Function for getting the number of events committed in the last run
+     *
+     * @return, the number of committed events
+     */
+    unsigned long getEventsCommitted() const { return mCommitted; }
+
+    /**
+     * Function for getting the number of executed events that were undone
+     *
+     * @return, the number of rolled back events
+     */
+    unsigned long getEventsRolledBack() const { return mRolledBack; }
+
+    /**
+     * Function for getting the number of rollbacks in the last run
+     *
+     * @return, the number of rollbacks
+     */
+    unsigned long getRollbacks() const { return mRollbacks; }
+
+    /**
+     * Function for getting the number of anti-messages sent in the last run
+     *
+     * @return, the number of anti-messages
+     */
+    unsigned long getAntiMessages() const { return mAntiMessages; }
+
+    /**
+     * Function for getting the number of GVT computations in the last run
+     *
+     * @return, the number of GVT rounds
+     */
+    unsigned long getGvtRounds() const { return mGvtRounds; }
+
+    /**
+     * Function for getting the share of executed events that were rolled back
+     *
+     * @return, the rollback rate between 0 and 1
+     */
+    double getRollbackRate() const;
+
+    /**
+     * Function for getting the share of executed events that were committed
+     *
+     * @return, the efficiency between 0 and 1
+     */
+    double getEfficiency() const;
+
+// Private member functions
+private:
+    class Process;
+
+    // Enum representing the kinds of messages sent between processes
+    enum MessageType { positive, negative, returned };
+
+    // Struct representing a message, an event sent to another process, its
+    // cancellation or the return of a train whose arrival was cancelled
+    struct Message {
+        Event event;
+        MessageType type;
+    };
+
+    /**
+     * Function for getting the process an event belongs to
+     *
+     * @param event, the event
+     * @return, the index of the process
+     */
+    unsigned getPartition(const Event &event) const;
+
+    /**
+     * Function for sending a message to another process
+     *
+     * @param target, the index of the receiving process
+     * @param message, the message
+     */
+    void send(const unsigned &target, const Message &message);
+
+    /**
+     * Function run by each worker thread
+     *
+     * @param index, the index of the process executed by the thread
+     */
+    void work(const unsigned &index);
+
+    /**
+     * Function for computing the GVT together with the other threads and
+     * committing everything before it
+     *
+     * @param index, the index of the process executed by the thread
+     * @return, a bool indicating if there are no events left before the
+     * end time
+     */
+    bool computeGvt(const unsigned &index);
+
+    /**
+     * Function for waiting until all worker threads reach the same point
+     */
+    void synchronize();
+
+    /**
+     * Function for writing the log entries committed by the processes, in
+     * the order they would have been written by a sequential run
+     */
+    void writeLogs();
+
+// Private data members
+private:
+    // Events executed between GVT computations while any process is busy
+    static constexpr unsigned long GVT_INTERVAL = 4096;
+
+    Simulation *mSim;
+
+    Controller *mController;
+
+    std::vector<std::unique_ptr<Process>> mProcesses;
+
+    // Process of the origin and destination station, indexed by train
+    std::vector<unsigned> mOrigins, mDestinations;
+
+    int mEndTime;
+
+    bool mFinished;
+
+    Event mGvt;
+
+    bool mHasGvt;
+
+    std::atomic<bool> mGvtRequested;
+
+    std::atomic<unsigned> mIdle;
+
+    std::atomic<unsigned long> mSent, mSinceGvt;
+
+    std::mutex mMutex;
+
+    std::condition_variable mCondition;
+
+    unsigned mWaiting, mGeneration;
+
+    unsigned long mExecuted, mCommitted, mRolledBack, mRollbacks,
+                  mAntiMessages, mGvtRounds;
+};
+
+#endif  // DT060G_PROJECT_TIME_WARP_SIMULATION_H
@@ -12,7 +12,9 @@
 #include <string>
 #include <memory>
 #include <vector>
+#include <istream>
 #include <ostream>
+#include <limits>
 
 // Forward declarations
 class Station;
@@ -45,11 +47,16 @@ public:
                                             mDelay(Time(0,0)),
                                             mTopSpeed(topSpeed),
                                             mSpeed(0),
+                                            mDistance(std::numeric_limits<
+                                                      double>::quiet_NaN()),
                                             mRequiredVehicles(requiredVehicles),
                                             mOrigin(origin),
                                             mDestination(destination),
                                             mStatus("NOT ASSEMBLED"),
-                                            mIgnore(false) { }
+                                            mIgnore(false) {
+        // make room for the vehicles so assembly does not allocate
+        mVehicles.reserve(requiredVehicles.size());
+    }
 
     // Default destructor
     ~Train() = default;
@@ -82,6 +89,13 @@ public:
      */
     void setSpeed(const double &speed) { mSpeed = speed; }
 
+    /**
+     * Function for setting the distance the train travels
+     *
+     * @param distance, the length of the route from origin to destination
+     */
+    void setDistance(const double &distance) { mDistance = distance; }
+
     /**
      * Function for setting train status
      *
@@ -117,6 +131,13 @@ public:
      */
     double getSpeed() const { return mSpeed; }
 
+    /**
+     * Function for getting the distance the train travels
+     *
+     * @return, the length of the route, NaN if there is no route
+     */
+    double getDistance() const { return mDistance; }
+
     /**
      * Function for getting original departure time
      *
@@ -177,9 +198,10 @@ public:
      * Function for getting which vehicle types must still be connected for
      * train to be complete
      *
-     * @return, a vector with the type numbers of the required vehicles
+     * @return, a reference to the type numbers of the required vehicles
      */
-    std::vector<int> getRequiredVehicles() const { return mRequiredVehicles; }
+    const std::vector<int> &getRequiredVehicles() const
+        { return mRequiredVehicles; }
 
     /**
      * Function for getting origin station of train
@@ -198,16 +220,16 @@ public:
     /**
      * Function for getting train status
      *
-     * @return, the train status
+     * @return, a reference to the train status
      */
-    std::string getStatus() const { return mStatus; }
+    const std::string &getStatus() const { return mStatus; }
 
     /**
      * Function for getting all currently connected vehicles
      *
-     * @return, a vector of pointers to the connected vehicles
+     * @return, a reference to the pointers to the connected vehicles
      */
-    std::vector<Vehicle *> getVehicles() const { return mVehicles; }
+    const std::vector<Vehicle *> &getVehicles() const { return mVehicles; }
 
     /**
      * Function for attaching additional vehicle to the train
@@ -232,11 +254,30 @@ public:
      */
     void addDelay(const Time &delay);
 
+    /**
+     * Function for writing the state the simulation changes to a checkpoint,
+     * the vehicles by their table rows
+     *
+     * @param os, the stream to write to
+     */
+    void writeState(std::ostream &os) const;
+
+    /**
+     * Function for reading the state the simulation changes from a
+     * checkpoint, the vehicles read are pointed at the train
+     * Throws std::runtime_error if the checkpoint is damaged
+     *
+     * @param is, the stream to read from
+     * @param vehicles, the vehicles by table row
+     */
+    void readState(std::istream &is,
+                   const std::vector<std::unique_ptr<Vehicle>> &vehicles);
+
 // Private data members
 private:
     int mTrainNumber;
 
-    double mTopSpeed, mSpeed;
+    double mTopSpeed, mSpeed, mDistance;
 
     std::vector<int> mRequiredVehicles;
 
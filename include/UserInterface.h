@@ -10,20 +10,39 @@
 #include "MyTime.h"
 #include "Controller.h"
 #include "Simulation.h"
+#include "EventQueue.h"
 
 #include <string>
+#include <vector>
 #include <memory>
 
+// Enum representing the formats of the batch run summary
+enum class OutputFormat { text, json, csv };
+
 /**
  * Class for providing user with control over the simulation
  * Owns the simulation and controller objects
  */
 class UserInterface {
 public:
+    // Upper limit for the number of worker threads
+    static constexpr int MAX_THREADS = 64;
+
+    // Upper limit for the number of ensemble replicas
+    static constexpr unsigned MAX_REPLICAS = 1000000;
+
     /**
      * Constructor, initializes time intervals to default values
      */
-    UserInterface(): mStartTime(0, 0), mEndTime(23, 59), mInterval(0, 10) { }
+    UserInterface(): mStartTime(0, 0), mEndTime(23, 59), mInterval(0, 10),
+                     mThreads(1), mOptimistic(false), mBatch(false),
+                     mFollowPlan(false), mShortages(false),
+                     mDirectory("../resources/Project/"), mLogLevel(low),
+                     mHistoryDetail(HistoryDetail::full),
+                     mLogSink(LogSink::both),
+                     mRecordFormat(RecordFormat::jsonl),
+                     mCheckpointInterval(1, 0),
+                     mQueueType(binaryHeap) { }
 
     // Default destructor
     ~UserInterface() = default;
@@ -41,6 +60,27 @@ public:
      */
     void runStartMenu();
 
+    /**
+     * Function for running the simulation without prompts, sets up the
+     * simulation from the options, completes it and prints the statistics
+     * followed by a summary with timings in the chosen format
+     *
+     * @param arguments, the command line options
+     * @return, the exit status, 0 on success, 1 if setup failed and 2 if the
+     * options were invalid
+     */
+    int runBatch(const std::vector<std::string> &arguments);
+
+    /**
+     * Function for running a Monte Carlo ensemble of the scenario with
+     * random departure delays and printing the delay distributions
+     *
+     * @param arguments, the command line options
+     * @return, the exit status, 0 on success, 1 if the run failed and 2 if
+     * the options were invalid
+     */
+    int runEnsemble(const std::vector<std::string> &arguments);
+
     /**
      * Function for running the main simulation menu
      */
@@ -96,6 +136,22 @@ public:
      */
     void completeSimulation();
 
+    /**
+     * Function for saving a snapshot of the simulation at the current time
+     */
+    void saveSnapshot();
+
+    /**
+     * Function for letting user rewind the simulation to a saved snapshot
+     */
+    void restoreSnapshot();
+
+    /**
+     * Function for changing the number of threads used to complete the
+     * simulation
+     */
+    void changeThreads();
+
     /**
      * Function for changing the level of detail in the log entries
      */
@@ -123,6 +179,12 @@ public:
      */
     void printStationNames();
 
+    /**
+     * Function for printing each station and vehicle type predicted to run
+     * short over the timetable, with the time it first does
+     */
+    void printShortages();
+
     /**
      * Function for letting user find a station by its name
      * Prints vehicle pool info upon successful find
@@ -135,13 +197,76 @@ public:
      */
     void findVehicleById();
 
+// Private member functions
+private:
+    /**
+     * Function for reading a time given as HH:MM
+     *
+     * @param str, the string to read
+     * @param time, the time object that will hold the read time
+     * @return, a bool indicating if the string was a valid time
+     */
+    static bool parseTime(const std::string &str, Time &time);
+
+    /**
+     * Function for reading a whole number without a sign
+     *
+     * @param str, the string to read
+     * @param value, the read number
+     * @return, a bool indicating if the whole string was a number
+     */
+    static bool parseNumber(const std::string &str, unsigned long long &value);
+
+    /**
+     * Function for printing the batch run options to the error stream
+     */
+    static void printUsage();
+
+    /**
+     * Function for printing the ensemble options to the error stream
+     */
+    static void printEnsembleUsage();
+
 // Private data members
 private:
     Time mStartTime, mEndTime, mInterval;
 
+    unsigned mThreads;
+
+    bool mOptimistic;   // complete the simulation with time warp
+
+    bool mBatch;        // running without prompts, keep the output clean
+
+    bool mFollowPlan;   // plan the vehicles of all trains before assembly
+
+    bool mShortages;    // predict vehicle shortages before simulating
+
+    std::string mDirectory;
+
+    LogLevel mLogLevel;
+
+    HistoryDetail mHistoryDetail;
+
+    LogSink mLogSink;
+
+    std::string mRecordPath;    // event records are written if not empty
+
+    RecordFormat mRecordFormat;
+
+    std::string mCheckpointPath;    // checkpoints are written if not empty
+
+    Time mCheckpointInterval;       // simulated time between checkpoints
+
+    std::string mResumePath;    // the run continues a checkpoint if not empty
+
+    QueueType mQueueType;
+
     std::unique_ptr<Simulation> mSim;
 
     std::unique_ptr<Controller> mController;
+
+    // Snapshots saved from the simulation menu, in the order saved
+    std::vector<Snapshot> mSnapshots;
 };
 
 #endif  // DT060G_PROJECT_USER_INTERFACE_H
@@ -10,13 +10,20 @@
 #include "MyTime.h"
 #include "Train.h"
 #include "Station.h"
+#include "VehicleTable.h"
+#include "HistoryJournal.h"
 
 #include <vector>
 #include <memory>
 #include <string>
+#include <ostream>
+#include <cstddef>
 
 /**
  * Virtual base class for representing vehicles
+ * A vehicle loaded by the controller also has a row in its VehicleTable, and
+ * keeps the train and station of the row up to date as it moves. Its history
+ * is kept in the controller's HistoryJournal
  */
 class Vehicle {
 public:
@@ -26,7 +33,10 @@ public:
      * @param id, the vehicle id
      */
     explicit Vehicle(const int &id): mId(id), mTrain(nullptr),
-                                     mStation(nullptr) { }
+                                     mStation(nullptr), mTable(nullptr),
+                                     mRow(0), mJournal(nullptr),
+                                     mLastRecord(HistoryJournal::NONE),
+                                     mHistorySize(0), mLoggedHistory(0) { }
 
     // Virtual destructor
     virtual ~Vehicle() { }
@@ -36,14 +46,45 @@ public:
      *
      * @param train, a pointer to a train
      */
-    void setTrain(Train *const train) { mTrain = train; }
+    void setTrain(Train *const train) {
+        mTrain = train;
+        if(mTable) {
+            mTable->setTrain(mRow, train ? train->getTrainNumber()
+                                         : VehicleTable::NONE);
+        }
+    }
 
     /**
      * Function for setting which station vehicle is attached to
      *
      * @param station, a pointer to a station
      */
-    void setStation(Station *const station) { mStation = station; }
+    void setStation(Station *const station) {
+        mStation = station;
+        if(mTable) {
+            mTable->setStation(mRow,
+                               station ? static_cast<int>(station->getId())
+                                       : VehicleTable::NONE);
+        }
+    }
+
+    /**
+     * Function for setting the table row that mirrors the vehicle
+     *
+     * @param table, a pointer to the table
+     * @param row, the row of the vehicle in the table
+     */
+    void setTableRow(VehicleTable *const table, const std::size_t &row) {
+        mTable = table;
+        mRow = row;
+    }
+
+    /**
+     * Function for getting the table row that mirrors the vehicle
+     *
+     * @return, the row of the vehicle in the table
+     */
+    std::size_t getTableRow() const { return mRow; }
 
     /**
      * Function for getting vehicle id
@@ -53,11 +94,35 @@ public:
     int getId() const { return mId; }
 
     /**
-     * Function for getting vehicle history
+     * Function for setting the journal that records vehicle history
+     *
+     * @param journal, a pointer to the journal
+     */
+    void setJournal(HistoryJournal *const journal) { mJournal = journal; }
+
+    /**
+     * Function for getting vehicle history, rendered from the journal
      *
      * @return, a vector of strings recording all vehicle events
      */
-    std::vector<std::string> getHistory() const { return mHistory; }
+    std::vector<std::string> getHistory() const;
+
+    /**
+     * Function for writing vehicle history, one event per line
+     *
+     * @param os, the stream to write to
+     */
+    void writeHistory(std::ostream &os) const;
+
+    /**
+     * Function for writing the history events added since the vehicle was
+     * last logged this way, after a line giving their positions in the
+     * history, and moving the cursor past them. Nothing is written if no
+     * event was added
+     *
+     * @param os, the stream to write to
+     */
+    void writeNewHistory(std::ostream &os);
 
     /**
      * Function for getting the train to which vehicle is attached
@@ -160,21 +225,79 @@ public:
     virtual int getFuelConsumption() const { return 0; }
 
     /**
-     * Function for adding a new event to vehicle history
+     * Function for adding a new event to vehicle history, nothing is
+     * recorded without a journal
      *
-     * @param event, a sting describing the event
+     * @param action, the event
+     * @param subject, the station id or train number
      * @param time, a Time object with the event time
      */
-    void addHistory(const std::string &event, const Time &time);
+    void addHistory(const HistoryAction &action, const int &subject,
+                    const Time &time);
+
+    /**
+     * Function for getting the number of events in vehicle history
+     *
+     * @return, the number of recorded events
+     */
+    std::size_t getHistorySize() const { return mHistorySize; }
+
+    /**
+     * Function for removing the latest events from vehicle history
+     *
+     * @param size, the number of events to keep
+     */
+    void truncateHistory(const std::size_t &size);
+
+    /**
+     * Function for getting the journal record of the latest history event
+     *
+     * @return, the index of the record, or HistoryJournal::NONE
+     */
+    unsigned getLastRecord() const { return mLastRecord; }
+
+    /**
+     * Function for pointing vehicle history at an earlier or later record
+     * of its chain in the journal, the records are never removed so any
+     * history the vehicle has had can be returned to
+     *
+     * @param lastRecord, the index of the latest record to keep
+     * @param size, the number of events up to and including that record
+     */
+    void setHistory(const unsigned &lastRecord, const std::size_t &size) {
+        mLastRecord = lastRecord;
+        mHistorySize = size;
+    }
+
+    /**
+     * Function for getting the number of history events already logged
+     *
+     * @return, the position of the log cursor in the history
+     */
+    std::size_t getLoggedHistory() const { return mLoggedHistory; }
+
+    /**
+     * Function for setting the number of history events already logged
+     *
+     * @param logged, the position of the log cursor in the history
+     */
+    void setLoggedHistory(const std::size_t &logged)
+        { mLoggedHistory = logged; }
 
 // Private data members
 private:
     int mId;
 
-    std::vector<std::string> mHistory;
-
     Train *mTrain;
     Station *mStation;
+
+    VehicleTable *mTable;
+    std::size_t mRow;
+
+    HistoryJournal *mJournal;
+    unsigned mLastRecord;
+    std::size_t mHistorySize;
+    std::size_t mLoggedHistory;     // events written by writeNewHistory
 };
 
 /**
@@ -0,0 +1,141 @@
+/*
+ * VehiclePlan.h
+ * Project
+ * Albin Ågren
+ */
+
+#ifndef DT060G_PROJECT_VEHICLE_PLAN_H
+#define DT060G_PROJECT_VEHICLE_PLAN_H
+
+#include <vector>
+#include <memory>
+#include <limits>
+#include <cstddef>
+
+// Forward declarations
+class Station;
+class Train;
+
+/**
+ * Class for planning which vehicles each train takes over the whole
+ * timetable, before the simulation assembles any train
+ * Each vehicle type gets a network over time: a station's vehicles wait
+ * between the assemblies and disassemblies there, and a train carries its
+ * vehicles from the assembly at its origin, 30 minutes before departure, to
+ * the disassembly at its destination, 20 minutes after arrival. The cheapest
+ * flow through the network carries as many vehicles on trains as possible.
+ * The types are planned apart, so trains a type can not fully supply are left
+ * out and the types planned again, at most MAX_ROUNDS times. Finally the
+ * vehicles are handed out in time order, oldest first as at assembly, and
+ * the trains that get every vehicle they need are planned
+ */
+class VehiclePlan {
+public:
+    // Most times the types are planned again without the trains left short
+    static constexpr unsigned MAX_ROUNDS = 8;
+
+    // Marks a train or vehicle without a planned counterpart
+    static constexpr unsigned NONE = std::numeric_limits<unsigned>::max();
+
+    /**
+     * Constructor, makes an empty plan
+     */
+    VehiclePlan(): mPlanned(0), mRounds(0), mPhases(0) { }
+
+    // Default destructor
+    ~VehiclePlan() = default;
+
+    /**
+     * Function for planning the vehicles of the trains, replaces any earlier
+     * plan
+     *
+     * @param stations, the stations and their vehicle pools
+     * @param trains, the trains in load order, not yet assembled
+     * @param vehicles, the number of vehicles, indexed by table row
+     */
+    void build(const std::vector<std::unique_ptr<Station>> &stations,
+               const std::vector<std::unique_ptr<Train>> &trains,
+               const std::size_t &vehicles);
+
+    /**
+     * Function for discerning if a train is planned
+     *
+     * @param train, the index of the train
+     * @return, a bool indicating if the train gets every vehicle it needs
+     */
+    bool isPlanned(const unsigned &train) const
+        { return train + 1 < mTrainOffsets.size() &&
+                 mTrainOffsets[train] != mTrainOffsets[train + 1]; }
+
+    /**
+     * Function for calling a function on the table row of every vehicle
+     * planned for a train, in the order they are attached
+     *
+     * @param train, the index of the train
+     * @param function, a callable taking a table row
+     */
+    template<typename Function>
+    void forEachVehicle(const unsigned &train, Function function) const;
+
+    /**
+     * Function for getting a train in the planned sequence of a vehicle
+     *
+     * @param vehicle, the table row of the vehicle
+     * @param position, the position in the sequence
+     * @return, the index of the train, or NONE past the end
+     */
+    unsigned getTrain(const std::size_t &vehicle,
+                      const unsigned &position) const;
+
+    /**
+     * Function for getting the number of trains planned
+     *
+     * @return, the number of trains
+     */
+    unsigned getNoOfPlannedTrains() const { return mPlanned; }
+
+    /**
+     * Function for getting the number of times the types were planned
+     *
+     * @return, the number of rounds
+     */
+    unsigned getRounds() const { return mRounds; }
+
+    /**
+     * Function for getting the number of solver phases over all rounds and
+     * types
+     *
+     * @return, the number of phases
+     */
+    unsigned long getPhases() const { return mPhases; }
+
+// Private data members
+private:
+    // Vehicles of each train and trains of each vehicle, in rows starting
+    // at the offsets
+    std::vector<std::size_t> mTrainOffsets;
+    std::vector<unsigned> mTrainVehicles;
+
+    std::vector<std::size_t> mVehicleOffsets;
+    std::vector<unsigned> mVehicleTrains;
+
+    unsigned mPlanned;
+
+    unsigned mRounds;
+
+    unsigned long mPhases;
+};
+
+template<typename Function>
+void VehiclePlan::forEachVehicle(const unsigned &train,
+                                 Function function) const {
+    if(train + 1 >= mTrainOffsets.size()) {
+        return;
+    }
+    for(std::size_t i = mTrainOffsets[train]; i < mTrainOffsets[train + 1];
+        ++i) {
+        function(mTrainVehicles[i]);
+    }
+}
+
+#endif  // DT060G_PROJECT_VEHICLE_PLAN_H
@@ -0,0 +1,201 @@
+/*
+ * VehicleTable.h
+ * Project
+ * Albin Ågren
+ */
+
+#ifndef DT060G_PROJECT_VEHICLE_TABLE_H
+#define DT060G_PROJECT_VEHICLE_TABLE_H
+
+#include <vector>
+#include <cstddef>
+
+// Struct representing the summed attributes of a set of vehicles
+struct FleetTotals {
+    unsigned vehicles;
+    long long seats;
+    long long beds;
+    long long cargoCapacity;
+    long long cargoArea;
+    long long cargoVolume;
+    long long power;
+};
+
+/**
+ * Class holding the attributes and whereabouts of every vehicle in columns,
+ * one row per vehicle in the order the vehicles were loaded
+ * Attributes a vehicle type does not have are zero, as for the getters of
+ * Vehicle. The vehicle objects keep their row up to date as they move, so
+ * sums over the fleet, a station or a train read the contiguous columns
+ * rather than following a pointer and a virtual call per vehicle
+ */
+class VehicleTable {
+public:
+    // Location of a vehicle not attached to a train or station
+    static constexpr int NONE = -1;
+
+    /**
+     * Default constructor, makes an empty table
+     */
+    VehicleTable() = default;
+
+    // Default destructor
+    ~VehicleTable() = default;
+
+    /**
+     * Function for reserving rows ahead of loading
+     *
+     * @param vehicles, the number of vehicles to make room for
+     */
+    void reserve(const std::size_t &vehicles);
+
+    /**
+     * Function for adding a vehicle, not attached anywhere
+     *
+     * @param id, the vehicle id
+     * @param type, the vehicle type
+     * @param param0, the first parameter of the type as in the data file
+     * @param param1, the second parameter of the type as in the data file
+     * @return, the row of the vehicle
+     */
+    std::size_t addVehicle(const int &id, const int &type, const int &param0,
+                           const int &param1);
+
+    /**
+     * Function for getting the number of vehicles
+     *
+     * @return, the number of rows
+     */
+    std::size_t size() const { return mIds.size(); }
+
+    /**
+     * Function for getting the id of a vehicle
+     *
+     * @param row, the row of the vehicle
+     * @return, the vehicle id
+     */
+    int getId(const std::size_t &row) const { return mIds[row]; }
+
+    /**
+     * Function for getting the type of a vehicle
+     *
+     * @param row, the row of the vehicle
+     * @return, the vehicle type
+     */
+    int getType(const std::size_t &row) const { return mTypes[row]; }
+
+    /**
+     * Function for getting the train a vehicle is attached to
+     *
+     * @param row, the row of the vehicle
+     * @return, the train number, or NONE
+     */
+    int getTrain(const std::size_t &row) const { return mTrains[row]; }
+
+    /**
+     * Function for getting the station a vehicle is attached to
+     *
+     * @param row, the row of the vehicle
+     * @return, the station id, or NONE
+     */
+    int getStation(const std::size_t &row) const { return mStations[row]; }
+
+    /**
+     * Function for setting the train a vehicle is attached to
+     *
+     * @param row, the row of the vehicle
+     * @param train, the train number, or NONE
+     */
+    void setTrain(const std::size_t &row, const int &train) {
+        mTrains[row] = train;
+    }
+
+    /**
+     * Function for setting the station a vehicle is attached to
+     *
+     * @param row, the row of the vehicle
+     * @param station, the station id, or NONE
+     */
+    void setStation(const std::size_t &row, const int &station) {
+        mStations[row] = station;
+    }
+
+    /**
+     * Function for summing the attributes of the whole fleet
+     *
+     * @return, the totals
+     */
+    FleetTotals getTotals() const;
+
+    /**
+     * Function for summing the attributes of the vehicles in a station pool
+     *
+     * @param station, the station id
+     * @return, the totals
+     */
+    FleetTotals getStationTotals(const int &station) const {
+        return sumWhere(mStations, station);
+    }
+
+    /**
+     * Function for summing the attributes of the vehicles in a train
+     *
+     * @param train, the train number
+     * @return, the totals
+     */
+    FleetTotals getTrainTotals(const int &train) const {
+        return sumWhere(mTrains, train);
+    }
+
+    /**
+     * Function for summing the attributes of every station pool in one pass
+     *
+     * @param stations, the number of stations
+     * @return, the totals indexed by station id
+     */
+    std::vector<FleetTotals> getTotalsPerStation(
+                                        const unsigned &stations) const;
+
+    /**
+     * Function for getting the memory held by the table
+     *
+     * @return, the number of bytes allocated
+     */
+    std::size_t getMemoryUsage() const;
+
+// Private member functions
+private:
+    /**
+     * Function for summing the attributes of the rows where a location
+     * column holds a value, written without branches so it vectorizes
+     *
+     * @param location, the train or station column
+     * @param value, the train number or station id to match
+     * @return, the totals
+     */
+    FleetTotals sumWhere(const std::vector<int> &location,
+                         const int &value) const;
+
+// Private data members
+private:
+    std::vector<int> mIds;
+
+    std::vector<unsigned char> mTypes;
+
+    // Attribute columns
+    std::vector<int> mSeats;
+    std::vector<unsigned char> mInternet;
+    std::vector<int> mBeds;
+    std::vector<int> mCargoCapacity;
+    std::vector<int> mCargoArea;
+    std::vector<int> mCargoVolume;
+    std::vector<double> mTopSpeed;
+    std::vector<int> mPower;
+    std::vector<int> mFuelConsumption;
+
+    // Location columns
+    std::vector<int> mTrains;
+    std::vector<int> mStations;
+};
+
+#endif  // DT060G_PROJECT_VEHICLE_TABLE_H
@@ -0,0 +1,110 @@
+/*
+ * WorkStealingPool.h
+ * Project
+ * Albin Ågren
+ */
+
+#ifndef DT060G_PROJECT_WORK_STEALING_POOL_H
+#define DT060G_PROJECT_WORK_STEALING_POOL_H
+
+#include <vector>
+#include <deque>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <atomic>
+
+/**
+ * Class for running tasks on a fixed number of worker threads
+ * Each worker has its own deque of tasks, it takes new work from the back of
+ * its own deque and, when that is empty, steals from the front of the others
+ */
+class WorkStealingPool {
+public:
+    // Type of the tasks, called with the index of the worker running them
+    using Task = std::function<void(unsigned)>;
+
+    /**
+     * Constructor, starts the worker threads
+     *
+     * @param threads, the number of worker threads
+     */
+    explicit WorkStealingPool(const unsigned &threads);
+
+    // Destructor, waits for queued tasks and stops the worker threads
+    ~WorkStealingPool();
+
+    /**
+     * Function for queuing a task, tasks are spread over the workers in turn
+     *
+     * @param task, the task to run
+     */
+    void submit(Task task);
+
+    /**
+     * Function for waiting until all queued tasks have finished
+     */
+    void wait();
+
+    /**
+     * Function for getting the number of worker threads
+     *
+     * @return, the number of worker threads
+     */
+    unsigned getNoOfWorkers() const { return mWorkers.size(); }
+
+    /**
+     * Function for getting the number of tasks taken from another worker
+     *
+     * @return, the number of stolen tasks
+     */
+    unsigned long getSteals() const { return mSteals; }
+
+// Private member functions
+private:
+    // Struct representing the task deque of a single worker
+    struct Worker {
+        std::deque<Task> tasks;
+        std::mutex mutex;
+    };
+
+    /**
+     * Function run by each worker thread
+     *
+     * @param index, the index of the worker
+     */
+    void work(const unsigned &index);
+
+    /**
+     * Function for taking the next task, first from the worker's own deque
+     * and otherwise from another worker
+     *
+     * @param index, the index of the worker
+     * @param task, the task that will hold the taken task if one is found
+     * @return, a bool indicating if a task was found
+     */
+    bool take(const unsigned &index, Task &task);
+
+// Private data members
+private:
+    std::vector<std::unique_ptr<Worker>> mWorkers;
+
+    std::vector<std::thread> mThreads;
+
+    std::mutex mMutex;
+
+    std::condition_variable mTaskAvailable, mAllDone;
+
+    // Tasks queued but not yet taken, and tasks queued but not yet finished
+    unsigned long mQueued, mPending;
+
+    unsigned mNext;
+
+    bool mStopping;
+
+    std::atomic<unsigned long> mSteals;
+};
+
+#endif  // DT060G_PROJECT_WORK_STEALING_POOL_H
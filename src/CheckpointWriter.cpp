@@ -0,0 +1,76 @@
+/*
+ * CheckpointWriter.cpp
+ * Project
+ * Albin Ågren
+ */
+
+#include "CheckpointWriter.h"
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <thread>
+#include <exception>
+#include <utility>
+#include <cstdio>
+
+namespace {
+
+// Size of the buffer between the checkpoint and the file
+constexpr std::size_t BUFFER_SIZE = 1 << 20;
+
+}   // namespace
+
+void CheckpointWriter::write(const std::string &path, Task task) {
+    wait();
+
+    mPath = path;
+    mTask = std::move(task);
+    mFailed = false;
+    mError.clear();
+    mThread = std::thread(&CheckpointWriter::run, this);
+}
+
+bool CheckpointWriter::wait() {
+    if(mThread.joinable()) {
+        mThread.join();
+
+        // the task holds what it writes, let it go on this thread
+        mTask = nullptr;
+    }
+    return !mFailed;
+}
+
+void CheckpointWriter::run() {
+    std::string temporary = mPath + ".tmp";
+    try {
+        std::vector<char> buffer(BUFFER_SIZE);
+        std::ofstream file;
+        file.rdbuf()->pubsetbuf(buffer.data(), buffer.size());
+        file.open(temporary, std::ios::binary | std::ios::trunc);
+        if(!file) {
+            mFailed = true;
+            mError = "checkpoint file failed to open";
+            return;
+        }
+
+        mTask(file);
+        file.close();
+        if(!file) {
+            mFailed = true;
+            mError = "checkpoint file failed to write";
+            return;
+        }
+
+        // replace the last checkpoint only with a complete one
+        if(std::rename(temporary.c_str(), mPath.c_str()) != 0) {
+            mFailed = true;
+            mError = "checkpoint file failed to replace " + mPath;
+            return;
+        }
+        ++mWritten;
+    } catch(const std::exception &e) {
+        mFailed = true;
+        mError = e.what();
+    }
+}
@@ -10,6 +10,8 @@
 #include "Train.h"
 #include "Simulation.h"
 #include "Event.h"
+#include "Scenario.h"
+#include "BinaryIO.h"
 
 #include <fstream>
 #include <vector>
@@ -20,16 +22,216 @@
 #include <exception>
 #include <stdexcept>
 #include <iostream>
+#include <cmath>
+#include <utility>
+#include <numeric>
+#include <cstdint>
 
-Controller::Controller(Simulation *sim): mSim(sim), mLogLevel(off) {
-    mLogFile.open("../resources/Project/Trainsim.log");
+namespace {
+
+// Tag at the start and the end of a checkpoint file
+constexpr char CHECKPOINT_TAG[8] = { 'T', 'R', 'A', 'I', 'N', 'C', 'K', 'P' };
+
+// Written in the byte order of the machine, to tell another order apart
+constexpr std::uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+// Reads a tag and throws std::runtime_error if it is not the checkpoint tag
+void readCheckpointTag(std::istream &is) {
+    char tag[sizeof(CHECKPOINT_TAG)];
+    if(!is.read(tag, sizeof(tag)) ||
+       !std::equal(tag, tag + sizeof(tag), CHECKPOINT_TAG)) {
+        throw std::runtime_error("not a complete checkpoint file");
+    }
+}
+
+// Writes back the elements of a snapshot that were changed since the last
+// one or are in chunks it does not share with the last one
+template<typename T, typename Apply>
+void restoreChanges(const ChangeSet &changes, const CowArray<T> &synced,
+                    const CowArray<T> &target, Apply apply) {
+    for(const unsigned &index : changes.indices) {
+        apply(index, target[index]);
+    }
+    for(std::size_t first = 0; first < target.size();
+        first += CowArray<T>::CHUNK) {
+        if(target.sharesChunk(synced, first)) {
+            continue;
+        }
+        std::size_t last = std::min(first + CowArray<T>::CHUNK,
+                                    target.size());
+        for(std::size_t index = first; index < last; ++index) {
+            apply(static_cast<unsigned>(index), target[index]);
+        }
+    }
+}
+
+}   // namespace
+
+Controller::Controller(Simulation *sim, const std::string &directory):
+                                                        mSim(sim),
+                                                        mDirectory(directory),
+                                                        mLogLevel(off),
+                                        mHistoryDetail(HistoryDetail::full),
+                                                        mWaitForVehicles(true),
+                                                        mFollowPlan(false),
+                                                        mTracking(false),
+                                                        mDisturbance(0),
+                                                        mMaxDisturbance(0),
+                                                        mSeed(0) {
+    // register as the handler of the simulation events
+    mSim->setController(this);
 
     // throw exception if file failed to open
-    if(mLogFile.fail()) {
+    if(!mLogger.openFile(mDirectory + "Trainsim.log")) {
         throw std::runtime_error("logfile failed to open");
     }
 }
 
+Controller::Controller(Simulation *sim, const Scenario &scenario):
+                                                        mSim(sim),
+                                                        mLogLevel(off),
+                                        mHistoryDetail(HistoryDetail::full),
+                                                        mWaitForVehicles(true),
+                                                        mFollowPlan(false),
+                                                        mTracking(false),
+                                                        mDisturbance(0),
+                                                        mMaxDisturbance(0),
+                                                        mSeed(0) {
+    // register as the handler of the simulation events
+    mSim->setController(this);
+
+    // build the system from the already parsed data, no log file is opened
+    buildStations(scenario.getStations());
+    buildDistances(scenario.getDistances());
+    buildTrains(scenario.getTrains());
+}
+
+void Controller::setDisturbances(const double &probability,
+                                 const int &maxDelay,
+                                 const unsigned long long &seed) {
+    mDisturbance = probability;
+    mMaxDisturbance = maxDelay;
+    mSeed = seed;
+}
+
+void Controller::setLogLevel(const LogLevel &logLevel) {
+    mLogLevel = logLevel;
+
+    // every retry is logged from now on
+    if(mLogLevel != off) {
+        resumeRetries(mSim->getTime());
+    }
+}
+
+bool Controller::openRecords(const std::string &path,
+                             const RecordFormat &format) {
+    // every retry is recorded from now on
+    resumeRetries(mSim->getTime());
+    return mRecords.open(path, format);
+}
+
+void Controller::setWaitForVehicles(const bool &wait) {
+    mWaitForVehicles = wait;
+    if(!mWaitForVehicles) {
+        resumeRetries(mSim->getTime());
+    }
+}
+
+bool Controller::waitForVehicles(const unsigned &index, const Time &nextTry) {
+    // a retry that is logged or recorded must happen
+    if(!mWaitForVehicles || mLogLevel != off || mRecords.isOpen()) {
+        return false;
+    }
+
+    Train *train = mTrains[index].get();
+    AssemblyWait &wait = mWaits[index];
+    wait.nextTry = nextTry.getTotalTime();
+    ++wait.ticket;
+    wait.queued = true;
+
+    // queue the train once for each type it misses, the entries left behind
+    // when it is woken are told apart by the ticket
+    markStation(train->getOrigin());
+    StationWaits &waits = mStationWaits[train->getOrigin()->getId()];
+    for(const int &type : train->getRequiredVehicles()) {
+        if(type < 0 || type >= Station::VEHICLE_TYPES) {
+            continue;
+        }
+        std::vector<WaitEntry> &queue = waits.queues[type];
+        if(!queue.empty() && queue.back().train == index &&
+           queue.back().ticket == wait.ticket) {
+            continue;
+        }
+        if(queue.size() == queue.capacity()) {
+            ++waits.allocations;
+        }
+        queue.push_back({ index, wait.ticket });
+    }
+    return true;
+}
+
+void Controller::endWait(const unsigned &index, const Time &time) {
+    AssemblyWait &wait = mWaits[index];
+    if(wait.nextTry == AssemblyWait::NOT_WAITING) {
+        return;
+    }
+
+    // each skipped retry would have added 10 minutes
+    int skipped = time.getTotalTime() - wait.nextTry;
+    if(skipped > 0) {
+        mTrains[index]->addDelay(Time::fromMinutes(skipped));
+    }
+    wait.nextTry = AssemblyWait::NOT_WAITING;
+    wait.queued = false;
+}
+
+void Controller::resumeRetries(const Time &until) {
+    // polling only retries on day 0
+    int end = std::min(until.getTotalTime(), Time::MINUTES_PER_DAY);
+
+    for(unsigned index = 0; index < mWaits.size(); ++index) {
+        AssemblyWait &wait = mWaits[index];
+        if(wait.nextTry == AssemblyWait::NOT_WAITING) {
+            continue;
+        }
+
+        // add the delay of the retries polling would have made by now
+        markTrain(index);
+        Train *train = mTrains[index].get();
+        if(wait.nextTry < end) {
+            int skipped = (end - wait.nextTry + 9) / 10 * 10;
+            train->addDelay(Time::fromMinutes(skipped));
+            wait.nextTry += skipped;
+        }
+
+        // a woken train's retry is already scheduled at the next try
+        Time nextTry = Time::fromMinutes(wait.nextTry);
+        if(wait.queued && nextTry.getDay() == 0) {
+            mSim->scheduleEvent(Event(EventType::assembly, nextTry, train,
+                                      index));
+        }
+        wait.nextTry = AssemblyWait::NOT_WAITING;
+        wait.queued = false;
+    }
+
+    for(unsigned id = 0; id < mStationWaits.size(); ++id) {
+        for(std::vector<WaitEntry> &queue : mStationWaits[id].queues) {
+            if(!queue.empty()) {
+                markStation(mStations[id].get());
+                queue.clear();
+            }
+        }
+    }
+}
+
+unsigned long Controller::getWaitAllocations() const {
+    unsigned long allocations = 0;
+    for(const StationWaits &waits : mStationWaits) {
+        allocations += waits.allocations;
+    }
+    return allocations;
+}
+
 std::string Controller::getLogLevelAsString() const {
     std::string logLevel;
     switch(mLogLevel) {
@@ -40,7 +242,8 @@ std::string Controller::getLogLevelAsString() const {
             logLevel = "Low";
             break;
         case high:
-            logLevel = "High";
+            logLevel = mHistoryDetail == HistoryDetail::incremental
+                     ? "High, new history" : "High";
             break;
         default:    // do nothing
             break;
@@ -86,180 +289,170 @@ std::string Controller::getVehicleTypeNameByTypeNumber(const int &type) const {
 }
 
 void Controller::loadStations() {
-    std::ifstream inFile("../resources/Project/TrainStations.txt");
+    buildStations(Scenario::readStations(mDirectory));
+}
 
-    // throw exception if file failed to open
-    if(inFile.fail()) {
-        throw std::runtime_error("station file failed to open");
-    }
+void Controller::loadDistances() {
+    buildDistances(Scenario::readDistances(mDirectory));
+}
+
+void Controller::loadTrains() {
+    buildTrains(Scenario::readTrains(mDirectory));
+}
 
-    std::string tmpStr;
-    // read station name
-    while(inFile >> tmpStr) {
+void Controller::buildStations(const std::vector<StationData> &stations) {
+    // size the vectors and indices up front
+    std::size_t vehicles = mVehicles.size();
+    for(const StationData &station : stations) {
+        vehicles += station.vehicles.size();
+    }
+    mVehicles.reserve(vehicles);
+    mVehicleTable.reserve(vehicles);
+    mVehicleIndex.reserve(vehicles);
+    mStations.reserve(mStations.size() + stations.size());
+    mStationIndex.reserve(mStations.size() + stations.size());
+    mStationWaits.resize(mStations.size() + stations.size());
+
+    for(const StationData &station : stations) {
         // make a new station
-        std::unique_ptr<Station> newStation = std::make_unique<Station>(tmpStr);
-
-        // get vehicle information
-        std::getline(inFile, tmpStr);
-
-        std::string vehicleStr;     // string to hold vehicle data
-        // parse all vehicles
-        while(!tmpStr.empty()) {
-            // get substring representing single vehicle
-            vehicleStr = tmpStr.substr(tmpStr.find('(') + 1,
-                                       tmpStr.find(')') - 1);
-            tmpStr = tmpStr.substr(tmpStr.find(')') + 1);
-
-            // unique_ptr to hold new vehicle
-            std::unique_ptr<Vehicle> newVehicle;
-
-            int id, type, param0, param1;     // ints to hold vehicle paramers
-            std::stringstream ss(vehicleStr);
-            ss >> id >> type;   // use sstream to convert to ints
-
-            // make the appropriate type of vehicle
-            switch(type) {
-                case 0: {
-                    // read the params
-                    ss >> param0 >> param1;
-                    // make a new shared pointer and assign to newVehicle
-                    newVehicle = std::make_unique<Coach>(id, param0, param1);
-                    break;
-                }
-                case 1: {
-                    ss >> param0;
-                    newVehicle = std::make_unique<Sleeper>(id, param0);
-                    break;
-                }
-                case 2: {
-                    ss >> param0 >> param1;
-                    newVehicle = std::make_unique<OpenWagon>(id, param0,
-                                                             param1);
-                    break;
-                }
-                case 3: {
-                    ss >> param0;
-                    newVehicle = std::make_unique<CoveredWagon>(id, param0);
-                    break;
-                }
-                case 4: {
-                    ss >> param0 >> param1;
-                    newVehicle = std::make_unique<ElectricLocomotive>(id,
-                                                                      param0,
-                                                                      param1);
-                    break;
-                }
-                case 5: {
-                    ss >> param0 >> param1;
-                    newVehicle = std::make_unique<DieselLocomotive>(id,
-                                                                    param0,
-                                                                    param1);
-                    break;
-                }
-                default: {
-                    // if type out of range, throw error
-                    throw std::runtime_error("datafile corrupted");
-                }
-            }
+        std::unique_ptr<Station> newStation =
+                    std::make_unique<Station>(station.name, mStations.size());
+        mJournal.addStation(station.name);
+
+        for(const VehicleData &vehicle : station.vehicles) {
+            std::unique_ptr<Vehicle> newVehicle = makeVehicle(vehicle);
+            newVehicle->setTableRow(&mVehicleTable,
+                                    mVehicleTable.addVehicle(vehicle.id,
+                                                             vehicle.type,
+                                                             vehicle.param0,
+                                                             vehicle.param1));
+            newVehicle->setJournal(&mJournal);
+
             // add the new vehicle to the correct station
             newStation->attachVehicle(newVehicle.get());
             newVehicle->setStation(newStation.get());
 
             // log the event
-            std::string event = "Connected to train pool at station " 
-                              + newStation->getName();
-            newVehicle->addHistory(event, Time(0, 0));
+            newVehicle->addHistory(HistoryAction::poolConnected,
+                                   newStation->getId(), Time(0, 0));
+
+            // index the vehicle by id, the first vehicle with an id is found
+            mVehicleIndex.emplace(newVehicle->getId(), newVehicle.get());
 
             // move pointer into member vector
             mVehicles.push_back(std::move(newVehicle));
         }
-        // add station to Controller member vector
+        // index the station by name and add it to Controller member vector
+        mStationIndex.emplace(newStation->getName(), newStation.get());
         mStations.push_back(std::move(newStation));
     }
-    inFile.close();
 }
 
-void Controller::loadDistances() {
-    std::ifstream inFile("../resources/Project/TrainMap.txt");
-
-    // throw exception if file failed to open
-    if(inFile.fail()) {
-        throw std::runtime_error("map file failed to open");
-    }
-
-    // strings to hold station names
+void Controller::buildDistances(const std::vector<DistanceData> &distances) {
     Station *station0, *station1;
-    std::string station0Name, station1Name;
-    double distance;
-    // get all distances
-    while(inFile >> station0Name) {
-        inFile >> station1Name;
-        inFile >> distance;
-
-        // set the distance for both station objects
-        findStation(station0Name, &station0);
-        station0->setDistance(station1Name, distance);
-        findStation(station1Name, &station1);
-        station1->setDistance(station0Name, distance);
+    std::vector<Link> links;
+    links.reserve(distances.size());
+    for(const DistanceData &distance : distances) {
+        // translate the station names to ids
+        if(!findStation(distance.station0, &station0) ||
+           !findStation(distance.station1, &station1)) {
+            throw std::runtime_error("map file refers to unknown station");
+        }
+        links.push_back({ station0->getId(), station1->getId(),
+                          distance.distance });
     }
-    inFile.close();
+    mDistances.build(mStations.size(), links);
+    mRouter.build(mStations.size(), links);
 }
 
-void Controller::loadTrains() {
-    std::ifstream inFile("../resources/Project/Trains.txt");
-
-    // throw exception if file failed to open
-    if(inFile.fail()) {
-        throw std::runtime_error("train file failed to open");
-    }
-
-    std::string tmpStr;
-    // get line representing single train
-    while(std::getline(inFile, tmpStr)) {
-        std::stringstream ss(tmpStr);
-        int id, topSpeed, type;
-        std::string originName, destinationName;
-        Time departure, arrival;
-
-        // get id, origin, destination, departure time and arrival time
-        ss >> id >> originName >> destinationName >> departure >> arrival
-           >> topSpeed;
-
-        // get the required vehicles
-        std::vector<int> requiredVehicles;
-        while(ss >> type) {
-            requiredVehicles.push_back(type);
-        }
+void Controller::buildTrains(const std::vector<TrainData> &trains) {
+    std::size_t first = mTrains.size();
+    mTrains.reserve(mTrains.size() + trains.size());
+    mTrainIndex.reserve(mTrains.size() + trains.size());
+    mWaits.resize(mTrains.size() + trains.size(),
+                  { AssemblyWait::NOT_WAITING, 0, false });
 
+    for(const TrainData &train : trains) {
         // get pointers to the origin and destination stations
         Station *origin, *destination;
-        findStation(originName, &origin);
-        findStation(destinationName, &destination);
+        if(!findStation(train.origin, &origin) ||
+           !findStation(train.destination, &destination)) {
+            throw std::runtime_error("train file refers to unknown station");
+        }
 
         // make a new train object and assign a unique_ptr to it
         std::unique_ptr<Train> newTrain = std::make_unique<Train>(
-                                                            id,
-                                                            departure,
-                                                            arrival,
-                                                            topSpeed,
-                                                            requiredVehicles,
-                                                            origin,
-                                                            destination);
-        mTrains.push_back(std::move(newTrain));    // add train to member vector
+                                                    train.trainNumber,
+                                                    train.departure,
+                                                    train.arrival,
+                                                    train.topSpeed,
+                                                    train.requiredVehicles,
+                                                    origin,
+                                                    destination);
+
+        // index the train by number and add it to member vector
+        mTrainIndex.emplace(newTrain->getTrainNumber(), newTrain.get());
+        mTrains.push_back(std::move(newTrain));
+    }
+
+    // resolve the distance of the new trains, routed trains are taken in
+    // order of origin so each origin is searched once
+    std::vector<Train *> routed;
+    for(std::size_t i = first; i < mTrains.size(); ++i) {
+        Train *train = mTrains[i].get();
+        unsigned origin = train->getOrigin()->getId();
+        unsigned destination = train->getDestination()->getId();
+        if(mDistances.hasDistance(origin, destination)) {
+            train->setDistance(mDistances.getDistance(origin, destination));
+        } else {
+            routed.push_back(train);
+        }
+    }
+    std::stable_sort(routed.begin(), routed.end(),
+                     [](const Train *left, const Train *right) {
+        return left->getOrigin()->getId() < right->getOrigin()->getId();
+    });
+    for(Train *train : routed) {
+        train->setDistance(mRouter.getDistance(train->getOrigin()->getId(),
+                                               train->getDestination()->
+                                                                getId()));
     }
+}
 
-    inFile.close();
+std::unique_ptr<Vehicle> Controller::makeVehicle(const VehicleData &vehicle) {
+    // make the appropriate type of vehicle
+    switch(vehicle.type) {
+        case 0:
+            return std::make_unique<Coach>(vehicle.id, vehicle.param0,
+                                           vehicle.param1);
+        case 1:
+            return std::make_unique<Sleeper>(vehicle.id, vehicle.param0);
+        case 2:
+            return std::make_unique<OpenWagon>(vehicle.id, vehicle.param0,
+                                               vehicle.param1);
+        case 3:
+            return std::make_unique<CoveredWagon>(vehicle.id, vehicle.param0);
+        case 4:
+            return std::make_unique<ElectricLocomotive>(vehicle.id,
+                                                        vehicle.param0,
+                                                        vehicle.param1);
+        case 5:
+            return std::make_unique<DieselLocomotive>(vehicle.id,
+                                                      vehicle.param0,
+                                                      vehicle.param1);
+        default:
+            // if type out of range, throw error
+            throw std::runtime_error("datafile corrupted");
+    }
 }
 
 bool Controller::findStation(const std::string &name, Station **station) {
-    // find station with matching name in member vector
-    auto it = std::find_if(mStations.begin(), mStations.end(),
-                           [name](std::unique_ptr<Station> &station) {
-                            return station->getName() == name; });
+    // look the station up in the index built while loading
+    auto it = mStationIndex.find(name);
 
     // if a matching station is found, assign it to the ptr and return true
-    if(it != mStations.end()) {
-        *station = (*it).get();
+    if(it != mStationIndex.end()) {
+        *station = it->second;
         return true;
     } else {
         return false;
@@ -267,14 +460,12 @@ bool Controller::findStation(const std::string &name, Station **station) {
 }
 
 bool Controller::findTrain(const int &trainNumber, Train **train) {
-    // find train with matching number in member vector
-    auto it = std::find_if(mTrains.begin(), mTrains.end(),
-                           [trainNumber](std::unique_ptr<Train> &train) {
-                            return train->getTrainNumber() == trainNumber; });
+    // look the train up in the index built while loading
+    auto it = mTrainIndex.find(trainNumber);
 
     // if a matching train is found, assign it to the ptr and return true
-    if(it != mTrains.end()) {
-        *train = (*it).get();
+    if(it != mTrainIndex.end()) {
+        *train = it->second;
         return true;
     } else {
         return false;
@@ -282,93 +473,303 @@ bool Controller::findTrain(const int &trainNumber, Train **train) {
 }
 
 bool Controller::findVehicle(const int &id, Vehicle **vehicle) {
-    // find vehicle with matching number in member vector
-    auto it = std::find_if(mVehicles.begin(), mVehicles.end(),
-                           [id](std::unique_ptr<Vehicle> &vehicle) {
-                            return vehicle->getId() == id; });
+    // look the vehicle up in the index built while loading
+    auto it = mVehicleIndex.find(id);
 
     // if a matching vehicle is found, assign it to the ptr and return true
-    if(it != mVehicles.end()) {
-        *vehicle = (*it).get();
+    if(it != mVehicleIndex.end()) {
+        *vehicle = it->second;
         return true;
     } else {
         return false;
     }
 }
 
-void Controller::scheduleAssemblyEvents() {
-    std::shared_ptr<Event> newEvent;
+void Controller::planVehicles() {
+    mPlan.build(mStations, mTrains, mVehicles.size());
+    mPlanCursors.assign(mVehicles.size(), 0);
+    for(const std::unique_ptr<Vehicle> &vehicle : mVehicles) {
+        markVehicle(vehicle.get());
+    }
+}
+
+Snapshot Controller::saveSnapshot() {
+    if(!mTracking) {
+        // copy everything once, then track what changes
+        if(mTrainOrder.empty()) {
+            // trains departing close in time are kept close, so the trains
+            // an interval changes are in few chunks
+            mTrainOrder.resize(mTrains.size());
+            std::iota(mTrainOrder.begin(), mTrainOrder.end(), 0u);
+            std::stable_sort(mTrainOrder.begin(), mTrainOrder.end(),
+                             [this](const unsigned &a, const unsigned &b) {
+                                 return mTrains[a]->getOrigDeparture() <
+                                        mTrains[b]->getOrigDeparture();
+                             });
+            mTrainSlots.resize(mTrains.size());
+            for(unsigned slot = 0; slot < mTrainOrder.size(); ++slot) {
+                mTrainSlots[mTrainOrder[slot]] = slot;
+            }
+        }
+        mSynced = Snapshot();
+        mSynced.owner = this;
+        for(const unsigned &index : mTrainOrder) {
+            mSynced.trains.append(saveTrain(index));
+        }
+        for(unsigned id = 0; id < mStations.size(); ++id) {
+            mSynced.stations.append(saveStation(id));
+        }
+        for(unsigned row = 0; row < mVehicles.size(); ++row) {
+            mSynced.vehicles.append(saveVehicle(row));
+        }
+        mTrainChanges.marked.assign(mTrains.size(), 0);
+        mStationChanges.marked.assign(mStations.size(), 0);
+        mVehicleChanges.marked.assign(mVehicles.size(), 0);
+        mTracking = true;
+    } else {
+        // only the changed chunks are copied, the snapshots share the rest
+        for(const unsigned &slot : mTrainChanges.indices) {
+            mSynced.trains.write(slot) = saveTrain(mTrainOrder[slot]);
+        }
+        for(const unsigned &id : mStationChanges.indices) {
+            mSynced.stations.write(id) = saveStation(id);
+        }
+        for(const unsigned &row : mVehicleChanges.indices) {
+            mSynced.vehicles.write(row) = saveVehicle(row);
+        }
+    }
+    clearChanges();
+
+    mSynced.simulation = mSim->saveState();
+    return mSynced;
+}
+
+void Controller::restoreSnapshot(const Snapshot &snapshot) {
+    if(snapshot.owner != this) {
+        throw std::invalid_argument("snapshot of another controller");
+    }
+
+    if(!mTracking) {
+        // nothing is known about what changed, so write everything back
+        for(unsigned slot = 0; slot < mTrainOrder.size(); ++slot) {
+            restoreTrain(mTrainOrder[slot], snapshot.trains[slot]);
+        }
+        for(unsigned id = 0; id < mStations.size(); ++id) {
+            restoreStation(id, snapshot.stations[id]);
+        }
+        for(unsigned row = 0; row < mVehicles.size(); ++row) {
+            restoreVehicle(row, snapshot.vehicles[row]);
+        }
+        mTrainChanges.marked.assign(mTrains.size(), 0);
+        mStationChanges.marked.assign(mStations.size(), 0);
+        mVehicleChanges.marked.assign(mVehicles.size(), 0);
+        mTracking = true;
+    } else {
+        // write back what changed since the last snapshot and what the
+        // snapshot does not share with it
+        restoreChanges(mTrainChanges, mSynced.trains, snapshot.trains,
+                [this](const unsigned &slot, const TrainSnapshot &state) {
+                    restoreTrain(mTrainOrder[slot], state);
+                });
+        restoreChanges(mStationChanges, mSynced.stations, snapshot.stations,
+                [this](const unsigned &id, const StationSnapshot &state) {
+                    restoreStation(id, state);
+                });
+        restoreChanges(mVehicleChanges, mSynced.vehicles, snapshot.vehicles,
+                [this](const unsigned &row, const VehicleSnapshot &state) {
+                    restoreVehicle(row, state);
+                });
+    }
+    clearChanges();
+
+    mSynced = snapshot;
+    mSim->restoreState(snapshot.simulation);
+
+    // trains may have waited under settings that now log every retry
+    if(!mWaitForVehicles || mLogLevel != off || mRecords.isOpen()) {
+        resumeRetries(mSim->getTime());
+    }
+}
+
+void Controller::saveCheckpoint(const std::string &path) {
+    // the snapshot shares its chunks, so the run copies what it changes
+    // while the writer reads them
+    Snapshot snapshot = saveSnapshot();
+    std::size_t records = mJournal.size();
+    std::uint64_t hash = getScenarioHash();
+    mCheckpoints.write(path, [this, snapshot, records, hash](
+                                                        std::ostream &os) {
+        writeCheckpoint(os, snapshot, records, hash);
+    });
+}
+
+void Controller::loadCheckpoint(const std::string &path) {
+    // the writer reads the journal that is about to be replaced
+    mCheckpoints.wait();
+
+    std::ifstream file(path, std::ios::binary);
+    if(!file) {
+        throw std::runtime_error("checkpoint file failed to open");
+    }
+
+    std::uint32_t version, byteOrder, trains, stations, vehicles;
+    std::uint64_t hash;
+    readCheckpointTag(file);
+    readBinary(file, version);
+    readBinary(file, byteOrder);
+    if(version != CHECKPOINT_VERSION || byteOrder != BYTE_ORDER_MARK) {
+        throw std::runtime_error("checkpoint of another version or machine");
+    }
+    readBinary(file, trains);
+    readBinary(file, stations);
+    readBinary(file, vehicles);
+    readBinary(file, hash);
+    if(trains != mTrains.size() || stations != mStations.size() ||
+       vehicles != mVehicles.size() || hash != getScenarioHash()) {
+        throw std::runtime_error("checkpoint of another scenario");
+    }
+
+    mSim->readState(file, mTrains.size());
+
+    // the trains and pools read point their vehicles back at them
+    for(const std::unique_ptr<Vehicle> &vehicle : mVehicles) {
+        vehicle->setTrain(nullptr);
+        vehicle->setStation(nullptr);
+    }
+    for(unsigned index = 0; index < mTrains.size(); ++index) {
+        std::uint8_t queued;
+        mTrains[index]->readState(file, mVehicles);
+        readBinary(file, mWaits[index].nextTry);
+        readBinary(file, mWaits[index].ticket);
+        readBinary(file, queued);
+        mWaits[index].queued = queued != 0;
+    }
+    for(unsigned id = 0; id < mStations.size(); ++id) {
+        std::uint64_t allocations;
+        mStations[id]->readState(file, mVehicles);
+        for(std::vector<WaitEntry> &queue : mStationWaits[id].queues) {
+            readBinaryVector(file, queue);
+            for(const WaitEntry &entry : queue) {
+                if(entry.train >= mTrains.size()) {
+                    throw std::runtime_error(
+                                        "checkpoint refers to unknown train");
+                }
+            }
+        }
+        readBinary(file, allocations);
+        mStationWaits[id].allocations = allocations;
+    }
+    for(unsigned row = 0; row < mVehicles.size(); ++row) {
+        std::uint32_t lastRecord, cursor;
+        std::uint64_t size, logged;
+        readBinary(file, lastRecord);
+        readBinary(file, size);
+        readBinary(file, logged);
+        readBinary(file, cursor);
+        mVehicles[row]->setHistory(lastRecord, size);
+        mVehicles[row]->setLoggedHistory(logged);
+        if(!mPlanCursors.empty()) {
+            mPlanCursors[row] = cursor;
+        }
+    }
+    mJournal.readRecords(file);
+    for(const std::unique_ptr<Vehicle> &vehicle : mVehicles) {
+        if(vehicle->getLastRecord() != HistoryJournal::NONE &&
+           vehicle->getLastRecord() >= mJournal.size()) {
+            throw std::runtime_error("checkpoint holds a damaged journal");
+        }
+    }
+    readCheckpointTag(file);
+
+    // nothing is known about what changed since the last snapshot
+    mTracking = false;
+
+    // trains may have waited under settings that now log every retry
+    if(!mWaitForVehicles || mLogLevel != off || mRecords.isOpen()) {
+        resumeRetries(mSim->getTime());
+    }
+}
 
+void Controller::scheduleAssemblyEvents() {
     // schedule assembly events for all trains
-    for(const auto &train : mTrains) {
+    for(unsigned index = 0; index < mTrains.size(); ++index) {
+        Train *train = mTrains[index].get();
         Time eventTime = train->getCurrentDeparture() - Time(0, 30);
-        newEvent = std::make_shared<AssemblyEvent>(eventTime, mSim,
-                                                   this, train.get());;
-
-        mSim->scheduleEvent(newEvent);
+        mSim->scheduleEvent(Event(EventType::assembly, eventTime, train,
+                                  index));
     }
 }
 
-bool Controller::attemptAssembly(Train *train) {
+bool Controller::attemptAssembly(Train *train, const unsigned &index,
+                                 Simulation *sim) {
     bool complete = true;
     Station *station = train->getOrigin();
     Vehicle *vehicle;
+    markStation(station);
+
+    // a planned train first takes its planned vehicles that are here
+    if(mFollowPlan) {
+        mPlan.forEachVehicle(index, [&](const unsigned &row) {
+            vehicle = mVehicles[row].get();
+            const std::vector<int> &required = train->getRequiredVehicles();
+            if(vehicle->getStation() == station &&
+               std::find(required.begin(), required.end(),
+                         vehicle->getType()) != required.end() &&
+               station->detachVehicle(vehicle)) {
+                connectVehicle(train, vehicle, sim);
+            }
+        });
+    }
+
+    // when following the plan, leave the vehicles kept for other trains
+    Time time = sim->getTime();
+    auto isFree = [this, &index, &time](const Vehicle *candidate) {
+        return !isReserved(candidate, index, time);
+    };
 
-    for(int type : train->getRequiredVehicles()) {
+    // attaching a vehicle removes its type from the required vehicles, so
+    // walk the list by index and only step past the types not found
+    const std::vector<int> &required = train->getRequiredVehicles();
+    for(std::size_t i = 0; i < required.size(); ) {
         // try to detatch a vehicle of the right type from station
-        if(station->detachVehicle(type, &vehicle)) {
-            // log event
-            std::string event = "Disconnected from train pool at station "
-                              + station->getName();
-            vehicle->addHistory(event, mSim->getTime());
-
-            // attach vehicle to train and log event
-            train->attachVehicle(vehicle);
-            event = "Connected to train " 
-                  + std::to_string(train->getTrainNumber());
-            vehicle->addHistory(event, mSim->getTime());
-
-            // if a locomotive is slower than the train, adjust top speed
-            if(vehicle->getType() > 3) {
-                train->setTopSpeed(std::min(train->getTopSpeed(),
-                                            vehicle->getTopSpeed()));
-            }
+        int type = required[i];
+        if(mFollowPlan ? station->detachVehicle(type, isFree, &vehicle)
+                       : station->detachVehicle(type, &vehicle)) {
+            connectVehicle(train, vehicle, sim);
         } else {
             complete = false;
+            ++i;
         }
     }
 
     if(complete){
         train->setStatus("ASSEMBLED");
+        recordEvent(train, sim, "assembled");
         // output log to console and log file
         std::stringstream ss;
         switch(mLogLevel) {
             case low:
-                ss << mSim->getTime() << " " << train
+                ss << sim->getTime() << " " << train
                    << " is now assembled, arriving at the platform at "
-                   << (mSim->getTime() + Time(0, 20)) << std::endl;
+                   << (sim->getTime() + Time(0, 20)) << std::endl;
 
                 // output to console and file
-                std::cout << ss.str();
-                mLogFile << ss.str();
+                writeLog(sim, ss.str());
                 break;
             case high:
-                ss << mSim->getTime() << " " << train
+                ss << sim->getTime() << " " << train
                    << " is now assembled, arriving at the platform at "
-                   << (mSim->getTime() + Time(0, 20)) << std::endl
+                   << (sim->getTime() + Time(0, 20)) << std::endl
                    << "Connected vehicles: " << std::endl;
 
                 // include individual vehicle info for high log level
-                for(const Vehicle *const vehiclePtr : train->getVehicles()) {
+                for(Vehicle *vehiclePtr : train->getVehicles()) {
                     ss << vehiclePtr->getInfo() << std::endl;
 
                     // print vehicle history
-                    for(const std::string &event : vehiclePtr->getHistory()) {
-                        ss << event << std::endl;
-                    }
+                    writeHistory(ss, vehiclePtr);
                 }
-                std::cout << ss.str();
-                mLogFile << ss.str();
+                writeLog(sim, ss.str());
                 break;
             case off:
                 break;
@@ -377,28 +778,27 @@ bool Controller::attemptAssembly(Train *train) {
     } else {
         train->setStatus("INCOMPLETE");
         train->addDelay(Time(0, 10));
+        recordEvent(train, sim, "incomplete");
 
         // log event
         std::stringstream ss;
         switch(mLogLevel) {
             case low:
-                ss << mSim->getTime() << " " << train
+                ss << sim->getTime() << " " << train
                    << " is incomplete, next try at " 
-                   << mSim->getTime() + Time(0, 10) << std::endl;
-                std::cout << ss.str();
-                mLogFile << ss.str();
+                   << sim->getTime() + Time(0, 10) << std::endl;
+                writeLog(sim, ss.str());
                 break;
             case high:
-                ss << mSim->getTime() << " " << train
+                ss << sim->getTime() << " " << train
                    << " is incomplete, next try at " 
-                   << mSim->getTime() + Time(0, 10) << std::endl
+                   << sim->getTime() + Time(0, 10) << std::endl
                    << "Missing vehicles: " << std::endl;
                 // add the missing vehicle types
                 for(const int &type : train->getRequiredVehicles()) {
                     ss << getVehicleTypeNameByTypeNumber(type) << std::endl;
                 }
-                std::cout << ss.str();
-                mLogFile << ss.str();
+                writeLog(sim, ss.str());
                 break;
             case off:
                 break;
@@ -407,52 +807,65 @@ bool Controller::attemptAssembly(Train *train) {
     return complete;    // indicate whether train fully equipped
 }
 
-void Controller::readyUp(Train *train) {
+void Controller::readyUp(Train *train, Simulation *sim) {
     train->setStatus("READY");
 
+    // disturb the departure, the delay depends only on the seed and the train
+    // so replicas with the same seed agree whatever order they run events in
+    if(mDisturbance > 0 && mMaxDisturbance > 0) {
+        unsigned long long hash = mixBits(mSeed ^ mixBits(
+                                                    train->getTrainNumber()));
+        double sample = (hash >> 11) * (1.0 / (1ull << 53));
+        if(sample < mDisturbance) {
+            int delay = 1 + mixBits(hash) % mMaxDisturbance;
+            train->addDelay(Time(delay / 60, delay % 60));
+        }
+    }
+    recordEvent(train, sim, "ready");
+
     // log event
     std::stringstream ss;
     switch(mLogLevel) {
         case low:
-            ss << mSim->getTime() << " " << train
+            ss << sim->getTime() << " " << train
                << " is now at the platform, departing at "
                << train->getCurrentDeparture() << std::endl;
 
             // output to console and file
-            std::cout << ss.str();
-            mLogFile << ss.str();
+            writeLog(sim, ss.str());
             break;
         case high:
-            ss << mSim->getTime() << " " << train
+            ss << sim->getTime() << " " << train
                << " is now at the platform, departing at "
                << train->getCurrentDeparture() << std::endl
                << "Connected vehicles: " << std::endl;
 
             // include individual vehicle info for high log level
-            for(const Vehicle *vehiclePtr : train->getVehicles()) {
+            for(Vehicle *vehiclePtr : train->getVehicles()) {
                 ss << vehiclePtr->getInfo() << std::endl;
 
                 // print vehicle history
-                for(const std::string &event : vehiclePtr->getHistory()) {
-                    ss << event << std::endl;
-                }
+                writeHistory(ss, vehiclePtr);
             }
-            std::cout << ss.str();
-            mLogFile << ss.str();
+            writeLog(sim, ss.str());
             break;
         case off:
             break;
     }
 }
 
-void Controller::depart(Train *train) {
+void Controller::depart(Train *train, Simulation *sim) {
     train->setStatus("RUNNING");
 
     Time arrival, delay;
 
     // get the distance between origin and destination
-    double distance = train->getOrigin()->
-                        getDistance(train->getDestination()->getName());
+    double distance = train->getDistance();
+    if(std::isnan(distance)) {
+        throw std::out_of_range("no route between " +
+                                train->getOrigin()->getName() + " and " +
+                                train->getDestination()->getName());
+    }
 
     // calculate the required speed to arrive on time
     Time travelTime = train->getOrigArrival() - train->getCurrentDeparture();
@@ -477,45 +890,43 @@ void Controller::depart(Train *train) {
     // set the new arrival and delay times
     train->setArrival(arrival);
     train->setDelay(delay);
+    recordEvent(train, sim, "departed");
 
     // log event
     std::stringstream ss;
     switch(mLogLevel) {
         case low:
-            ss << mSim->getTime() << " " << train
+            ss << sim->getTime() << " " << train
                << " has left the platform, travelling at speed "
                << train->getSpeed() << " (" << train->getTopSpeed() << ")" 
                << std::endl;
 
             // output to console and file
-            std::cout << ss.str();
-            mLogFile << ss.str();
+            writeLog(sim, ss.str());
             break;
         case high:
-            ss << mSim->getTime() << " " << train
+            ss << sim->getTime() << " " << train
                << " has left the platform, travelling at speed "
                << train->getSpeed() << " (" << train->getTopSpeed() << ")" 
                << std::endl << "Connected vehicles: " << std::endl;
 
             // include individual vehicle info for high log level
-            for(const Vehicle *vehiclePtr : train->getVehicles()) {
+            for(Vehicle *vehiclePtr : train->getVehicles()) {
                 ss << vehiclePtr->getInfo() << std::endl;
 
                 // print vehicle history
-                for(const std::string &event : vehiclePtr->getHistory()) {
-                    ss << event << std::endl;
-                }
+                writeHistory(ss, vehiclePtr);
             }
-            std::cout << ss.str();
-            mLogFile << ss.str();
+            writeLog(sim, ss.str());
             break;
         case off:
             break;
     }
 }
 
-void Controller::arrive(Train *train) {
+void Controller::arrive(Train *train, Simulation *sim) {
     train->setStatus("ARRIVED");
+    recordEvent(train, sim, "arrived");
 
     // log event
     std::stringstream ss;
@@ -523,35 +934,29 @@ void Controller::arrive(Train *train) {
         case low:
             // ignore trains outside of user specified time window
             if(!train->getIgnore()) {
-                ss << mSim->getTime() << " " << train
+                ss << sim->getTime() << " " << train
                    << " has arrived at the platform, disassembly at "
-                   << mSim->getTime() + Time(0, 20) << std::endl;
+                   << sim->getTime() + Time(0, 20) << std::endl;
 
                 // output to console and file
-                mLogFile << ss.str();
-                std::cout << ss.str();
+                writeLog(sim, ss.str());
             }
             break;
         case high:
             if(!train->getIgnore()) {
-                ss << mSim->getTime() << " " << train
+                ss << sim->getTime() << " " << train
                    << " has arrived at the platform, disassembly at "
-                   << mSim->getTime() + Time(0, 20) << std::endl
+                   << sim->getTime() + Time(0, 20) << std::endl
                    << "Connected vehicles: " << std::endl;
 
                 // include individual vehicle info for high log level
-                for(const Vehicle *vehiclePtr : train->getVehicles()) {
+                for(Vehicle *vehiclePtr : train->getVehicles()) {
                     ss << vehiclePtr->getInfo() << std::endl;
 
                     // print vehicle history
-                    for(const std::string &event : vehiclePtr->getHistory()) {
-                        ss << event << std::endl;
-                    }
-                }
-                if(mLogFile.is_open()) {
-                    std::cout << ss.str();
-                    mLogFile << ss.str();
+                    writeHistory(ss, vehiclePtr);
                 }
+                writeLog(sim, ss.str());
             }
             break;
         case off:
@@ -559,56 +964,67 @@ void Controller::arrive(Train *train) {
     }
 }
 
-void Controller::disassemble(Train *train) {
+void Controller::disassemble(Train *train, Simulation *sim) {
     train->setStatus("FINISHED");
     Station *station = train->getDestination();
 
-    // detach the vehicles, add the event and store pointers in vector
+    // record the train while it still holds its vehicles
+    recordEvent(train, sim, "disassembled");
+
+    // detach the vehicles, add the event and store pointers in vector when
+    // they are to be logged
     Vehicle *vehicle;
     std::vector<Vehicle *> vehicles;
+    if(mLogLevel == high) {
+        vehicles.reserve(train->getNoOfVehicles());
+    }
+    unsigned types = 0;
+    markStation(station);
     while(train->detachVehicle(&vehicle)) {
         // add event to vehicle history
-        std::string event = "Disconnected from train " 
-                          + std::to_string(train->getTrainNumber());
-        vehicle->addHistory(event, mSim->getTime());
+        markVehicle(vehicle);
+        vehicle->addHistory(HistoryAction::trainDisconnected,
+                            train->getTrainNumber(), sim->getTime());
 
         station->attachVehicle(vehicle);
-        event = "Connected to train pool at station " + station->getName();
-        vehicle->addHistory(event, mSim->getTime());
+        types |= 1u << vehicle->getType();
+        vehicle->addHistory(HistoryAction::poolConnected, station->getId(),
+                            sim->getTime());
 
-        vehicles.push_back(vehicle);
+        if(mLogLevel == high) {
+            vehicles.push_back(vehicle);
+        }
     }
 
+    // the returned vehicles may complete the trains waiting for them
+    wakeWaitingTrains(station, types, train, sim);
+
     // log event
     std::stringstream ss;
     switch(mLogLevel) {
         case low:
             if(!train->getIgnore()) {
-                ss << mSim->getTime() << " " << train
+                ss << sim->getTime() << " " << train
                    << " has been disassembled" << std::endl;
 
                 // output to console and file
-                std::cout << ss.str();
-                mLogFile << ss.str();
+                writeLog(sim, ss.str());
             }
         break;
         case high:
             if(!train->getIgnore()) {
-                ss << mSim->getTime() << " " << train
+                ss << sim->getTime() << " " << train
                    << " has been disassembled." << std::endl
                    << "The train consisted of: " << std::endl;
 
                 // include individual vehicle info for high log level
-                for(const Vehicle *const vehiclePtr : vehicles) {
+                for(Vehicle *vehiclePtr : vehicles) {
                     ss << vehiclePtr->getInfo() << std::endl;
 
                     // print vehicle history
-                    for(const std::string &event : vehiclePtr->getHistory()) {
-                        ss << event << std::endl;
-                    }
+                    writeHistory(ss, vehiclePtr);
                 }
-                std::cout << ss.str();
-                mLogFile << ss.str();
+                writeLog(sim, ss.str());
             }
             break;
         case off:
@@ -616,16 +1032,269 @@ void Controller::disassemble(Train *train) {
     }
 }
 
+void Controller::writeLog(Simulation *sim, std::string entry) {
+    // let the simulation hold the entry if it is collecting its log
+    if(sim->isCapturingLog()) {
+        sim->captureLog(entry);
+        return;
+    }
+
+    // output to console and file on the logger's thread
+    mLogger.write(std::move(entry));
+}
+
+void Controller::writeRecord(Simulation *sim, std::string record) {
+    // let the simulation hold the record if it is collecting its log
+    if(sim->isCapturingLog()) {
+        sim->captureLog(record, true);
+        return;
+    }
+
+    mRecords.write(record);
+}
+
+void Controller::connectVehicle(Train *train, Vehicle *vehicle,
+                                Simulation *sim) {
+    // log event
+    markVehicle(vehicle);
+    vehicle->addHistory(HistoryAction::poolDisconnected,
+                        train->getOrigin()->getId(), sim->getTime());
+
+    // attach vehicle to train and log event
+    train->attachVehicle(vehicle);
+    vehicle->addHistory(HistoryAction::trainConnected,
+                        train->getTrainNumber(), sim->getTime());
+
+    // if a locomotive is slower than the train, adjust top speed
+    if(vehicle->getType() > 3) {
+        train->setTopSpeed(std::min(train->getTopSpeed(),
+                                    vehicle->getTopSpeed()));
+    }
+}
+
+bool Controller::isReserved(const Vehicle *vehicle, const unsigned &index,
+                            const Time &time) {
+    // step past the planned trains the vehicle is done with, the status is
+    // only read of trains at the vehicle's station, which run on the same
+    // thread as this event
+    markVehicle(vehicle);
+    unsigned &cursor = mPlanCursors[vehicle->getTableRow()];
+    for(unsigned next = mPlan.getTrain(vehicle->getTableRow(), cursor);
+        next != VehiclePlan::NONE;
+        next = mPlan.getTrain(vehicle->getTableRow(), ++cursor)) {
+        const Train *planned = mTrains[next].get();
+        if(planned->getOrigin() == vehicle->getStation()) {
+            const std::string &status = planned->getStatus();
+            if(next == index) {
+                return false;
+            } else if(status == "NOT ASSEMBLED" || status == "INCOMPLETE") {
+                return true;
+            }
+
+        // a vehicle off its plan is free until it is due elsewhere
+        } else if(planned->getOrigDeparture() - Time(0, 30) >= time) {
+            return false;
+        }
+    }
+    return false;
+}
+
+void Controller::recordEvent(const Train *train, Simulation *sim,
+                             const char *event) {
+    if(!mRecords.isOpen()) {
+        return;
+    }
+    std::string record;
+    mRecords.format(record, event, sim->getTime(), train);
+    writeRecord(sim, std::move(record));
+}
+
+void Controller::wakeWaitingTrains(const Station *station,
+                                   const unsigned &types, const Train *train,
+                                   Simulation *sim) {
+    StationWaits &waits = mStationWaits[station->getId()];
+    int now = sim->getTime().getTotalTime();
+
+    for(int type = 0; type < Station::VEHICLE_TYPES; ++type) {
+        std::vector<WaitEntry> &queue = waits.queues[type];
+        if(!(types & (1u << type)) || queue.empty()) {
+            continue;
+        }
+
+        for(const WaitEntry &entry : queue) {
+            AssemblyWait &wait = mWaits[entry.train];
+            if(!wait.queued || wait.ticket != entry.ticket) {
+                continue;
+            }
+            wait.queued = false;
+            markTrain(entry.train);
+
+            // polling retries on a 10 minute grid, a retry at this time only
+            // comes after this event for a higher train number
+            Train *waiting = mTrains[entry.train].get();
+            int nextTry = wait.nextTry;
+            if(nextTry < now) {
+                nextTry += (now - nextTry + 9) / 10 * 10;
+            }
+            if(nextTry == now &&
+               waiting->getTrainNumber() < train->getTrainNumber()) {
+                nextTry += 10;
+            }
+
+            // a train past its last retry stays waiting until resumed
+            Time retry = Time::fromMinutes(nextTry);
+            if(retry.getDay() == 0) {
+                sim->scheduleEvent(Event(EventType::assembly, retry, waiting,
+                                         entry.train));
+            }
+        }
+        markStation(station);
+        queue.clear();
+    }
+}
+
+void Controller::writeHistory(std::ostream &os, Vehicle *vehicle) {
+    if(mHistoryDetail == HistoryDetail::incremental) {
+        markVehicle(vehicle);
+        vehicle->writeNewHistory(os);
+    } else {
+        vehicle->writeHistory(os);
+    }
+}
+
+void Controller::writeCheckpoint(std::ostream &os, const Snapshot &snapshot,
+                                 const std::size_t &records,
+                                 const std::uint64_t &hash) const {
+    os.write(CHECKPOINT_TAG, sizeof(CHECKPOINT_TAG));
+    writeBinary(os, CHECKPOINT_VERSION);
+    writeBinary(os, BYTE_ORDER_MARK);
+    writeBinary(os, static_cast<std::uint32_t>(mTrains.size()));
+    writeBinary(os, static_cast<std::uint32_t>(mStations.size()));
+    writeBinary(os, static_cast<std::uint32_t>(mVehicles.size()));
+    writeBinary(os, hash);
+
+    Simulation::writeState(os, snapshot.simulation);
+
+    // the trains are written by index, the snapshot keeps them by departure
+    for(unsigned index = 0; index < mTrains.size(); ++index) {
+        const TrainSnapshot &state = snapshot.trains[mTrainSlots[index]];
+        state.train.writeState(os);
+        writeBinary(os, state.wait.nextTry);
+        writeBinary(os, state.wait.ticket);
+        writeBinary(os, static_cast<std::uint8_t>(state.wait.queued));
+    }
+    for(unsigned id = 0; id < mStations.size(); ++id) {
+        const StationSnapshot &state = snapshot.stations[id];
+        state.station.writeState(os);
+        for(const std::vector<WaitEntry> &queue : state.waits.queues) {
+            writeBinaryVector(os, queue);
+        }
+        writeBinary(os, static_cast<std::uint64_t>(state.waits.allocations));
+    }
+    for(unsigned row = 0; row < mVehicles.size(); ++row) {
+        const VehicleSnapshot &state = snapshot.vehicles[row];
+        writeBinary(os, static_cast<std::uint32_t>(state.lastRecord));
+        writeBinary(os, static_cast<std::uint64_t>(state.historySize));
+        writeBinary(os, static_cast<std::uint64_t>(state.loggedHistory));
+        writeBinary(os, static_cast<std::uint32_t>(state.planCursor));
+    }
+    mJournal.writeRecords(os, records);
+
+    os.write(CHECKPOINT_TAG, sizeof(CHECKPOINT_TAG));
+}
+
+std::uint64_t Controller::getScenarioHash() const {
+    // FNV-1a over what the trains, stations and vehicles were loaded with
+    std::uint64_t hash = 0xcbf29ce484222325ull;
+    auto add = [&hash](const std::uint64_t &value) {
+        hash = (hash ^ value) * 0x100000001b3ull;
+    };
+    for(const std::unique_ptr<Train> &train : mTrains) {
+        add(static_cast<std::uint64_t>(train->getTrainNumber()));
+        add(static_cast<std::uint64_t>(
+                                train->getOrigDeparture().getTotalTime()));
+        add(static_cast<std::uint64_t>(
+                                train->getOrigArrival().getTotalTime()));
+        add(train->getOrigin()->getId());
+        add(train->getDestination()->getId());
+    }
+    for(const std::unique_ptr<Station> &station : mStations) {
+        for(const char &c : station->getName()) {
+            add(static_cast<unsigned char>(c));
+        }
+    }
+    for(const std::unique_ptr<Vehicle> &vehicle : mVehicles) {
+        add(static_cast<std::uint64_t>(vehicle->getId()));
+        add(static_cast<std::uint64_t>(vehicle->getType()));
+    }
+    return hash;
+}
+
+VehicleSnapshot Controller::saveVehicle(const unsigned &row) const {
+    const Vehicle *vehicle = mVehicles[row].get();
+    return { vehicle->getStation(), vehicle->getTrain(),
+             vehicle->getLastRecord(), vehicle->getHistorySize(),
+             vehicle->getLoggedHistory(),
+             mPlanCursors.empty() ? 0 : mPlanCursors[row] };
+}
+
+void Controller::restoreTrain(const unsigned &index,
+                              const TrainSnapshot &state) {
+    *mTrains[index] = state.train;
+    mWaits[index] = state.wait;
+}
+
+void Controller::restoreStation(const unsigned &id,
+                                const StationSnapshot &state) {
+    *mStations[id] = state.station;
+    mStationWaits[id] = state.waits;
+}
+
+void Controller::restoreVehicle(const unsigned &row,
+                                const VehicleSnapshot &state) {
+    // the setters keep the vehicle table up to date
+    Vehicle *vehicle = mVehicles[row].get();
+    vehicle->setStation(state.station);
+    vehicle->setTrain(state.train);
+    vehicle->setHistory(state.lastRecord, state.historySize);
+    vehicle->setLoggedHistory(state.loggedHistory);
+    if(!mPlanCursors.empty()) {
+        mPlanCursors[row] = state.planCursor;
+    }
+}
+
+void Controller::clearChanges() {
+    for(ChangeSet *changes : { &mTrainChanges, &mStationChanges,
+                               &mVehicleChanges }) {
+        for(const unsigned &index : changes->indices) {
+            changes->marked[index] = 0;
+        }
+        changes->indices.clear();
+    }
+}
+
+unsigned long long Controller::mixBits(unsigned long long value) {
+    // splitmix64 finalizer
+    value += 0x9e3779b97f4a7c15ull;
+    value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ull;
+    value = (value ^ (value >> 27)) * 0x94d049bb133111ebull;
+    return value ^ (value >> 31);
+}
+
 void Controller::ignoreDepartedTrains() {
     // set ignore flags for all departed trains
-    for(auto &train : mTrains) {
-        if(train->getCurrentDeparture() < mSim->getTime()) {
-            train->setIgnore(true);
+    for(unsigned index = 0; index < mTrains.size(); ++index) {
+        if(mTrains[index]->getCurrentDeparture() < mSim->getTime()) {
+            markTrain(index);
+            mTrains[index]->setIgnore(true);
         }
     }
 }
 
-void Controller::printStatistics(const Time &endTime) const {
+void Controller::printStatistics(const Time &endTime) {
+    // finish writing the log before the statistics follow it
+    mLogger.flush();
+
     // print on time, delayed and unfinished trains separately
     std::stringstream onTime, delayed, failed;
     Time departureDelay, arrivalDelay;
@@ -659,3 +1328,24 @@ void Controller::printStatistics(const Time &endTime) const {
               << departureDelay << std::endl
               << "Total delay at arrival: " << arrivalDelay << std::endl;
 }
+
+TrainStatistics Controller::getStatistics(const Time &endTime) const {
+    TrainStatistics statistics = { 0, 0, 0, Time(0, 0), Time(0, 0) };
+
+    // classify the trains like printStatistics does
+    for(const auto &train : mTrains) {
+        if(train->getIgnore() || train->getOrigDeparture() > endTime) {
+            continue;
+        } else if(train->getStatus() == "FINISHED" &&
+                  train->getDelay() == Time(0, 0)) {
+            ++statistics.onTime;
+        } else if(train->getStatus() == "FINISHED") {
+            ++statistics.delayed;
+            statistics.departureDelay += train->getDepartureDelay();
+            statistics.arrivalDelay += train->getDelay();
+        } else {
+            ++statistics.failed;
+        }
+    }
+    return statistics;
+}
@@ -0,0 +1,108 @@
+/*
+ * DistanceTable.cpp
+ * Project
+ * Albin Ågren
+ */
+
+#include "DistanceTable.h"
+
+#include <vector>
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+void DistanceTable::build(const unsigned &stations,
+                          const std::vector<Link> &links) {
+    mStations = stations;
+    mDense = stations <= DENSE_LIMIT;
+    mMatrix.clear();
+    mOffsets.clear();
+    mNeighbours.clear();
+    mDistances.clear();
+    mNoOfDistances = 0;
+
+    if(mDense) {
+        mMatrix.assign(static_cast<std::size_t>(stations) * stations,
+                       std::numeric_limits<double>::quiet_NaN());
+        for(const Link &link : links) {
+            // keep the first distance given for a pair
+            for(int direction = 0; direction < 2; ++direction) {
+                unsigned from = direction ? link.station1 : link.station0;
+                unsigned to = direction ? link.station0 : link.station1;
+                double &distance = mMatrix[from * mStations + to];
+                if(std::isnan(distance)) {
+                    distance = link.distance;
+                    ++mNoOfDistances;
+                }
+            }
+        }
+        return;
+    }
+
+    // list both directions of every link, in the order given
+    std::vector<Link> directed;
+    directed.reserve(2 * links.size());
+    for(const Link &link : links) {
+        directed.push_back(link);
+        directed.push_back({ link.station1, link.station0, link.distance });
+    }
+
+    // sort into rows, the stable sort keeps the first distance of a pair
+    // ahead of any later one
+    std::stable_sort(directed.begin(), directed.end(),
+                     [](const Link &left, const Link &right) {
+        return left.station0 < right.station0 ||
+               (left.station0 == right.station0 &&
+                left.station1 < right.station1);
+    });
+
+    mOffsets.assign(stations + 1, 0);
+    for(std::size_t i = 0; i < directed.size(); ++i) {
+        const Link &link = directed[i];
+        if(i > 0 && link.station0 == directed[i - 1].station0 &&
+           link.station1 == directed[i - 1].station1) {
+            continue;
+        }
+        mNeighbours.push_back(link.station1);
+        mDistances.push_back(link.distance);
+        ++mOffsets[link.station0 + 1];
+    }
+    for(unsigned i = 0; i < stations; ++i) {
+        mOffsets[i + 1] += mOffsets[i];
+    }
+    mNoOfDistances = mNeighbours.size();
+}
+
+double DistanceTable::findDistance(const unsigned &from,
+                                   const unsigned &to) const {
+    if(!mDense && from < mStations) {
+        // binary search the neighbours of the origin
+        auto begin = mNeighbours.begin() + mOffsets[from];
+        auto end = mNeighbours.begin() + mOffsets[from + 1];
+        auto it = std::lower_bound(begin, end, to);
+        if(it != end && *it == to) {
+            return mDistances[it - mNeighbours.begin()];
+        }
+    }
+    throw std::out_of_range("no distance between stations");
+}
+
+bool DistanceTable::hasDistance(const unsigned &from,
+                                const unsigned &to) const {
+    if(from >= mStations || to >= mStations) {
+        return false;
+    }
+    if(mDense) {
+        return !std::isnan(mMatrix[from * mStations + to]);
+    }
+    auto begin = mNeighbours.begin() + mOffsets[from];
+    auto end = mNeighbours.begin() + mOffsets[from + 1];
+    return std::binary_search(begin, end, to);
+}
+
+std::size_t DistanceTable::getMemoryUsage() const {
+    return mMatrix.capacity() * sizeof(double) +
+           mOffsets.capacity() * sizeof(std::size_t) +
+           mNeighbours.capacity() * sizeof(unsigned) +
+           mDistances.capacity() * sizeof(double);
+}
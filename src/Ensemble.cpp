@@ -0,0 +1,198 @@
+/*
+ * Ensemble.cpp
+ * Project
+ * Albin Ågren
+ */
+
+#include "Ensemble.h"
+#include "Simulation.h"
+#include "Controller.h"
+#include "Train.h"
+#include "WorkStealingPool.h"
+
+#include <vector>
+#include <string>
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <algorithm>
+
+void DelayHistogram::add(const int &minutes) {
+    int delay = std::max(minutes, 0);
+    ++mBins[std::min(delay, MAX_MINUTES + 1)];
+    ++mCount;
+    mSum += delay;
+    mMax = std::max(mMax, delay);
+}
+
+void DelayHistogram::merge(const DelayHistogram &histogram) {
+    for(std::size_t i = 0; i < mBins.size(); ++i) {
+        mBins[i] += histogram.mBins[i];
+    }
+    mCount += histogram.mCount;
+    mSum += histogram.mSum;
+    mMax = std::max(mMax, histogram.mMax);
+}
+
+double DelayHistogram::getMean() const {
+    return mCount == 0 ? 0 : static_cast<double>(mSum) / mCount;
+}
+
+int DelayHistogram::getPercentile(const double &share) const {
+    if(mCount == 0) {
+        return 0;
+    }
+
+    // walk the bins until the share of all delays is covered
+    unsigned long target = static_cast<unsigned long>(share * mCount);
+    unsigned long seen = 0;
+    for(int minutes = 0; minutes <= MAX_MINUTES; ++minutes) {
+        seen += mBins[minutes];
+        if(seen > target || seen == mCount) {
+            return minutes;
+        }
+    }
+    return mMax;
+}
+
+Ensemble::Ensemble(const Scenario &scenario, const double &probability,
+                   const int &maxDelay): mScenario(scenario),
+                                         mProbability(probability),
+                                         mMaxDelay(maxDelay),
+                                         mResults(makeResults()),
+                                         mThreads(0),
+                                         mSteals(0),
+                                         mSeconds(0) { }
+
+void Ensemble::run(const unsigned &replicas, const unsigned &threads,
+                   const unsigned long long &seed, const Time &endTime) {
+    auto start = std::chrono::steady_clock::now();
+
+    std::vector<Results> workerResults;
+    {
+        WorkStealingPool pool(threads);
+        workerResults.assign(pool.getNoOfWorkers(), makeResults());
+        mThreads = pool.getNoOfWorkers();
+
+        for(unsigned i = 0; i < replicas; ++i) {
+            unsigned long long replicaSeed = seed + i;
+            pool.submit([this, replicaSeed, &endTime, &workerResults]
+                        (unsigned worker) {
+                runReplica(replicaSeed, endTime, workerResults[worker]);
+            });
+        }
+        pool.wait();
+        mSteals = pool.getSteals();
+    }
+
+    // merge the results of the workers
+    mResults = makeResults();
+    for(const Results &results : workerResults) {
+        mResults.departureDelays.merge(results.departureDelays);
+        mResults.arrivalDelays.merge(results.arrivalDelays);
+        for(std::size_t i = 0; i < mResults.delayed.size(); ++i) {
+            mResults.delayed[i] += results.delayed[i];
+            mResults.delaySum[i] += results.delaySum[i];
+            mResults.unfinished[i] += results.unfinished[i];
+        }
+        mResults.replicas += results.replicas;
+    }
+
+    mSeconds = std::chrono::duration<double>(
+                    std::chrono::steady_clock::now() - start).count();
+}
+
+void Ensemble::runReplica(const unsigned long long &seed, const Time &endTime,
+                          Results &results) const {
+    Simulation sim;
+    Controller controller(&sim, mScenario);
+    controller.setDisturbances(mProbability, mMaxDelay, seed);
+    controller.scheduleAssemblyEvents();
+
+    while(!sim.done() && sim.getNextEventTime() < endTime) {
+        sim.processNextEvent();
+    }
+    sim.finishRunningTrains();
+    controller.resumeRetries(endTime);
+
+    // add the delays of the trains within the time window
+    for(unsigned i = 0; i < controller.getNoOfTrains(); ++i) {
+        const Train *train = controller.getTrain(i);
+        if(train->getOrigDeparture() > endTime) {
+            continue;
+        }
+        if(train->getStatus() != "FINISHED") {
+            ++results.unfinished[i];
+            continue;
+        }
+
+        int arrivalDelay = train->getDelay().getTotalTime();
+        results.departureDelays.add(train->getDepartureDelay().getTotalTime());
+        results.arrivalDelays.add(arrivalDelay);
+        if(arrivalDelay > 0) {
+            ++results.delayed[i];
+            results.delaySum[i] += arrivalDelay;
+        }
+    }
+    ++results.replicas;
+}
+
+Ensemble::Results Ensemble::makeResults() const {
+    Results results;
+    std::size_t trains = mScenario.getTrains().size();
+    results.delayed.assign(trains, 0);
+    results.delaySum.assign(trains, 0);
+    results.unfinished.assign(trains, 0);
+    results.replicas = 0;
+    return results;
+}
+
+void Ensemble::printResults() const {
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << mResults.replicas << " replicas on " << mThreads
+              << " threads in " << mSeconds << " s (" << mSteals
+              << " replicas stolen)" << std::endl << std::endl;
+
+    // print the distributions
+    const DelayHistogram *histograms[] = { &mResults.departureDelays,
+                                           &mResults.arrivalDelays };
+    const char *names[] = { "Delay at departure", "Delay at arrival" };
+    for(int i = 0; i < 2; ++i) {
+        const DelayHistogram &histogram = *histograms[i];
+        std::cout << names[i] << " (minutes, " << histogram.getCount()
+                  << " trains): mean " << histogram.getMean()
+                  << ", median " << histogram.getPercentile(0.5)
+                  << ", 90th " << histogram.getPercentile(0.9)
+                  << ", 99th " << histogram.getPercentile(0.99)
+                  << ", max " << histogram.getMax() << std::endl;
+    }
+
+    // print the trains most often delayed at arrival
+    std::vector<std::size_t> order;
+    for(std::size_t i = 0; i < mResults.delayed.size(); ++i) {
+        if(mResults.delayed[i] > 0 || mResults.unfinished[i] > 0) {
+            order.push_back(i);
+        }
+    }
+    std::stable_sort(order.begin(), order.end(),
+                     [this](const std::size_t &a, const std::size_t &b) {
+        return mResults.delayed[a] + mResults.unfinished[a] >
+               mResults.delayed[b] + mResults.unfinished[b];
+    });
+    if(order.size() > 10) {
+        order.resize(10);
+    }
+
+    std::cout << std::endl << "Trains most often delayed:" << std::endl;
+    for(const std::size_t &i : order) {
+        double replicas = mResults.replicas > 0 ? mResults.replicas : 1;
+        std::cout << "Train " << mScenario.getTrains()[i].trainNumber
+                  << ": delayed " << 100 * mResults.delayed[i] / replicas
+                  << "%, mean delay " << (mResults.delayed[i] > 0 ?
+                        static_cast<double>(mResults.delaySum[i]) /
+                        mResults.delayed[i] : 0)
+                  << " min, unfinished "
+                  << 100 * mResults.unfinished[i] / replicas << "%"
+                  << std::endl;
+    }
+}
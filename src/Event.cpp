@@ -9,81 +9,97 @@
 #include "Controller.h"
 #include "Simulation.h"
 #include "Train.h"
+#include "BinaryIO.h"
 
-#include <memory>
-#include <string>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <cstddef>
 
-void AssemblyEvent::processEvent() {
-    Time nextEventTime;
-    std::shared_ptr<Event> nextEvent;
+Event::Event(const EventType &eventType, const Time &eventTime,
+             const Train *const eventTrain, const unsigned &index):
+                                    time(eventTime.getTotalTime()),
+                                    trainNumber(eventTrain->getTrainNumber()),
+                                    train(index),
+                                    type(eventType) { }
 
-    if(mController->attemptAssembly(mTrain)) {
-        // schedule departure event 10 minutes in the future
-        nextEventTime = mTrain->getCurrentDeparture() - Time(0, 10);
-        nextEvent = std::make_shared<ReadyEvent>(nextEventTime,
-                                                 mSim,
-                                                 mController,
-                                                 mTrain);
-        mSim->scheduleEvent(nextEvent);
+void processEvent(const Event &event, Simulation *sim, Controller *controller) {
+    Train *train = controller->getTrain(event.train);
+    Time nextEventTime;
 
-    // if assembly fails, schedule new attempt unless day has passed
-    } else {
-        // if incomplete, schedule new try in 10 minutes
-        nextEventTime = mTime + Time(0, 10);
+    // every event changes its train
+    controller->markTrain(event.train);
 
-        // only schedule another try if still on day 0
-        if(nextEventTime.getDay() == 0) {
-            nextEvent = std::make_shared<AssemblyEvent>(nextEventTime,
-                                                        mSim,
-                                                        mController,
-                                                        mTrain);
+    switch(event.type) {
+        case EventType::assembly:
+            // a train woken from waiting takes the delay of skipped retries
+            controller->endWait(event.train, event.getTime());
 
-            mSim->scheduleEvent(nextEvent);
-        }
-    }
-}
+            if(controller->attemptAssembly(train, event.train, sim)) {
+                // schedule departure event 10 minutes in the future
+                nextEventTime = train->getCurrentDeparture() - Time(0, 10);
+                sim->scheduleEvent(Event(EventType::ready, nextEventTime,
+                                         train, event.train));
 
-void ReadyEvent::processEvent() {
-    mController->readyUp(mTrain);
+            // if assembly fails, schedule new try in 10 minutes
+            } else {
+                nextEventTime = event.getTime() + Time(0, 10);
 
-    Time nextEventTime = mTrain->getCurrentDeparture();
+                // only schedule another try if still on day 0, unless the
+                // train waits for the vehicles it misses
+                if(nextEventTime.getDay() == 0 &&
+                   !controller->waitForVehicles(event.train, nextEventTime)) {
+                    sim->scheduleEvent(Event(EventType::assembly,
+                                             nextEventTime, train,
+                                             event.train));
+                }
+            }
+            break;
+        case EventType::ready:
+            controller->readyUp(train, sim);
 
-    // create and schedule departure event
-    std::shared_ptr<Event> nextEvent = std::make_shared<DepartureEvent>(
-                                                                nextEventTime,
-                                                                mSim,
-                                                                mController,
-                                                                mTrain);
-    mSim->scheduleEvent(nextEvent);
-}
+            // create and schedule departure event
+            nextEventTime = train->getCurrentDeparture();
+            sim->scheduleEvent(Event(EventType::departure, nextEventTime,
+                                     train, event.train));
+            break;
+        case EventType::departure:
+            controller->depart(train, sim);
 
-void DepartureEvent::processEvent() {
-    mController->depart(mTrain);
+            // create and schedule upcoming arrival event
+            nextEventTime = train->getCurrentArrival();
+            sim->scheduleEvent(Event(EventType::arrival, nextEventTime,
+                                     train, event.train));
+            break;
+        case EventType::arrival:
+            controller->arrive(train, sim);
 
-    // create and schedule upcoming arrival event
-    Time nextEventTime = mTrain->getCurrentArrival();
-    std::shared_ptr<Event> nextEvent = std::make_shared<ArrivalEvent>(
-                                                                nextEventTime,
-                                                                mSim,
-                                                                mController,
-                                                                mTrain);
-    mSim->scheduleEvent(nextEvent);
+            // create and schedule upcoming disassembly event
+            nextEventTime = event.getTime() + Time(0, 20);
+            sim->scheduleEvent(Event(EventType::disassembly, nextEventTime,
+                                     train, event.train));
+            break;
+        case EventType::disassembly:
+            controller->disassemble(train, sim);
+            break;
+    }
 }
 
-void ArrivalEvent::processEvent() {
-    mController->arrive(mTrain);
-
-    // create and schedule upcoming disassembly event
-    Time nextEventTime = mTime + Time(0, 20);
-    std::shared_ptr<Event> nextEvent = std::make_shared<DisassemblyEvent>(
-                                                                nextEventTime,
-                                                                mSim,
-                                                                mController,
-                                                                mTrain);
-    mSim->scheduleEvent(nextEvent);
+void writeEvent(std::ostream &os, const Event &event) {
+    writeBinary(os, event.time);
+    writeBinary(os, event.trainNumber);
+    writeBinary(os, event.train);
+    writeBinary(os, event.type);
 }
 
-void DisassemblyEvent::processEvent() {
-    // disassemble the train
-    mController->disassemble(mTrain);
+Event readEvent(std::istream &is, const std::size_t &trains) {
+    Event event;
+    event.time = readBinaryMinutes(is);
+    readBinary(is, event.trainNumber);
+    readBinary(is, event.train);
+    readBinary(is, event.type);
+    if(event.train >= trains || event.type > EventType::disassembly) {
+        throw std::runtime_error("checkpoint holds a damaged event");
+    }
+    return event;
 }
@@ -0,0 +1,163 @@
+/*
+ * EventQueue.cpp
+ * Project
+ * Albin Ågren
+ */
+
+#include "EventQueue.h"
+#include "Event.h"
+#include "BinaryIO.h"
+
+#include <vector>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <cstdint>
+#include <algorithm>
+
+void CalendarEventQueue::push(const Event &event) {
+    // start the ring at the first event pushed into an empty queue
+    if(size() == 0) {
+        mBase = event.time;
+        mCursor = event.time & (HORIZON - 1);
+    }
+
+    // keep events outside the ring horizon in the overflow heap
+    if(event.time < mBase || event.time - mBase >= HORIZON) {
+        mOverflow.push(event);
+        return;
+    }
+
+    pushBucket(event);
+}
+
+const Event &CalendarEventQueue::top() {
+    advance();
+
+    if(overflowFirst()) {
+        return mOverflow.top();
+    }
+    return mBuckets[mCursor].front();
+}
+
+void CalendarEventQueue::pop() {
+    advance();
+
+    if(overflowFirst()) {
+        mOverflow.pop();
+    } else {
+        std::vector<Event> &bucket = mBuckets[mCursor];
+        std::pop_heap(bucket.begin(), bucket.end(), EventComparison());
+        bucket.pop_back();
+        --mRingSize;
+    }
+}
+
+void CalendarEventQueue::advance() {
+    // move the ring to the earliest overflow event once the ring runs dry
+    if(mRingSize == 0) {
+        if(mOverflow.empty()) {
+            return;
+        }
+        mBase = mOverflow.top().time;
+        mCursor = mBase & (HORIZON - 1);
+
+        // migrate overflow events that now fall within the horizon
+        while(!mOverflow.empty() && mOverflow.top().time - mBase < HORIZON) {
+            pushBucket(mOverflow.top());
+            mOverflow.pop();
+        }
+        return;
+    }
+
+    // skip empty buckets, the ring holds no events earlier than the cursor
+    while(mBuckets[mCursor].empty()) {
+        ++mBase;
+        mCursor = (mCursor + 1) & (HORIZON - 1);
+    }
+}
+
+bool CalendarEventQueue::overflowFirst() {
+    if(mOverflow.empty()) {
+        return false;
+    }
+    if(mRingSize == 0) {
+        return true;
+    }
+
+    // compare the earliest ring event with the earliest overflow event
+    EventComparison compare;
+    return compare(mBuckets[mCursor].front(), mOverflow.top());
+}
+
+void CalendarEventQueue::pushBucket(const Event &event) {
+    // each bucket is a small heap ordering simultaneous events by train
+    std::vector<Event> &bucket = mBuckets[event.time & (HORIZON - 1)];
+    if(bucket.size() == bucket.capacity()) {
+        ++mAllocations;
+    }
+    bucket.push_back(event);
+    std::push_heap(bucket.begin(), bucket.end(), EventComparison());
+    ++mRingSize;
+}
+
+void CalendarEventQueue::writeState(std::ostream &os) const {
+    writeBinary(os, static_cast<std::uint64_t>(mAllocations));
+    writeBinary(os, mBase);
+    writeBinary(os, mCursor);
+
+    // only the buckets holding storage are written, each as it is laid out
+    std::uint32_t used = 0;
+    for(const std::vector<Event> &bucket : mBuckets) {
+        used += bucket.capacity() > 0;
+    }
+    writeBinary(os, used);
+    for(std::uint32_t i = 0; i < mBuckets.size(); ++i) {
+        const std::vector<Event> &bucket = mBuckets[i];
+        if(bucket.capacity() == 0) {
+            continue;
+        }
+        writeBinary(os, i);
+        writeBinary(os, static_cast<std::uint64_t>(bucket.capacity()));
+        writeBinary(os, static_cast<std::uint64_t>(bucket.size()));
+        for(const Event &event : bucket) {
+            writeEvent(os, event);
+        }
+    }
+    mOverflow.writeState(os);
+}
+
+void CalendarEventQueue::readState(std::istream &is,
+                                   const std::size_t &trains) {
+    std::uint64_t allocations;
+    std::uint32_t used;
+    readBinary(is, allocations);
+    readBinary(is, mBase);
+    readBinary(is, mCursor);
+    readBinary(is, used);
+    mAllocations = allocations;
+    if(mCursor < 0 || mCursor >= HORIZON || used > HORIZON) {
+        throw std::runtime_error("checkpoint holds a damaged event queue");
+    }
+
+    mRingSize = 0;
+    for(std::vector<Event> &bucket : mBuckets) {
+        bucket = std::vector<Event>();
+    }
+    for(std::uint32_t i = 0; i < used; ++i) {
+        std::uint32_t index;
+        std::uint64_t capacity, size;
+        readBinary(is, index);
+        readBinary(is, capacity);
+        readBinary(is, size);
+        if(index >= HORIZON || capacity < size) {
+            throw std::runtime_error("checkpoint holds a damaged event queue");
+        }
+        std::vector<Event> &bucket = mBuckets[index];
+        for(std::uint64_t j = 0; j < size; ++j) {
+            bucket.push_back(readEvent(is, trains));
+        }
+        mRingSize += size;
+    }
+    mOverflow.readState(is, trains);
+}
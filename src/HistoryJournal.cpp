@@ -0,0 +1,174 @@
+/*
+ * HistoryJournal.cpp
+ * Project
+ * Albin Ågren
+ */
+
+#include "HistoryJournal.h"
+#include "MyTime.h"
+#include "BinaryIO.h"
+
+#include <vector>
+#include <string>
+#include <mutex>
+#include <istream>
+#include <ostream>
+#include <cstdint>
+#include <algorithm>
+#include <stdexcept>
+
+namespace {
+
+// Number of records copied out of the journal at a time while writing
+constexpr std::size_t WRITE_BLOCK = 1 << 16;
+
+}   // namespace
+
+void HistoryJournal::addStation(const std::string &name) {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mStationNames.push_back(name);
+}
+
+unsigned HistoryJournal::append(const unsigned &previous,
+                                const HistoryAction &action,
+                                const int &subject, const Time &time) {
+    std::lock_guard<std::mutex> lock(mMutex);
+    if(mRecords.size() >= NONE) {
+        throw std::length_error("vehicle history journal full");
+    }
+
+    // the records grow geometrically with the events, not the timetable
+    if(mRecords.size() == mRecords.capacity()) {
+        ++mAllocations;
+    }
+    mRecords.push_back({ time.getTotalTime(), subject, previous, action });
+    return mRecords.size() - 1;
+}
+
+unsigned HistoryJournal::getPrevious(unsigned record,
+                                     std::size_t steps) const {
+    std::lock_guard<std::mutex> lock(mMutex);
+    while(steps-- > 0 && record != NONE) {
+        record = mRecords[record].previous;
+    }
+    return record;
+}
+
+std::vector<std::string> HistoryJournal::render(
+                                    unsigned last,
+                                    const std::size_t &count) const {
+    std::vector<std::string> history;
+    history.reserve(count);
+
+    // collect the records from the latest back, then put the oldest first
+    std::lock_guard<std::mutex> lock(mMutex);
+    for(std::size_t i = 0; i < count && last != NONE; ++i) {
+        history.push_back(render(mRecords[last]));
+        last = mRecords[last].previous;
+    }
+    std::reverse(history.begin(), history.end());
+
+    return history;
+}
+
+void HistoryJournal::write(std::ostream &os, unsigned last,
+                           const std::size_t &count) const {
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    // collect the records from the latest back, then write the oldest first
+    std::vector<unsigned> records(count);
+    for(std::size_t i = count; i > 0 && last != NONE; --i) {
+        records[i - 1] = last;
+        last = mRecords[last].previous;
+    }
+    for(unsigned record : records) {
+        os << render(mRecords[record]) << std::endl;
+    }
+}
+
+std::size_t HistoryJournal::size() const {
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mRecords.size();
+}
+
+std::size_t HistoryJournal::getMemoryUsage() const {
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mRecords.size() * sizeof(HistoryRecord);
+}
+
+std::size_t HistoryJournal::getMemoryHeld() const {
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mRecords.capacity() * sizeof(HistoryRecord);
+}
+
+unsigned long HistoryJournal::getAllocations() const {
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mAllocations;
+}
+
+void HistoryJournal::writeRecords(std::ostream &os,
+                                  const std::size_t &count) const {
+    writeBinary(os, static_cast<std::uint64_t>(count));
+
+    // copy a block under the lock and write it without, so appending is
+    // not held up by the writing
+    std::vector<HistoryRecord> block;
+    for(std::size_t first = 0; first < count; first += WRITE_BLOCK) {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            block.assign(mRecords.begin() + first,
+                         mRecords.begin() + std::min(first + WRITE_BLOCK,
+                                                     count));
+        }
+        for(const HistoryRecord &record : block) {
+            writeBinary(os, record.time);
+            writeBinary(os, record.subject);
+            writeBinary(os, record.previous);
+            writeBinary(os, record.action);
+        }
+    }
+}
+
+void HistoryJournal::readRecords(std::istream &is) {
+    std::uint64_t count;
+    readBinary(is, count);
+
+    std::vector<HistoryRecord> records;
+    for(std::uint64_t i = 0; i < count; ++i) {
+        HistoryRecord record;
+        readBinary(is, record.time);
+        readBinary(is, record.subject);
+        readBinary(is, record.previous);
+        readBinary(is, record.action);
+        if(record.previous != NONE && record.previous >= i) {
+            throw std::runtime_error("checkpoint holds a damaged journal");
+        }
+        records.push_back(record);
+    }
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    mRecords.swap(records);
+}
+
+std::string HistoryJournal::render(const HistoryRecord &record) const {
+    // same text as the events used to be stored with
+    std::string event = Time::fromMinutes(record.time).getFormattedTime();
+    switch(record.action) {
+        case HistoryAction::poolConnected:
+            event += " Connected to train pool at station "
+                   + mStationNames[record.subject];
+            break;
+        case HistoryAction::poolDisconnected:
+            event += " Disconnected from train pool at station "
+                   + mStationNames[record.subject];
+            break;
+        case HistoryAction::trainConnected:
+            event += " Connected to train " + std::to_string(record.subject);
+            break;
+        case HistoryAction::trainDisconnected:
+            event += " Disconnected from train "
+                   + std::to_string(record.subject);
+            break;
+    }
+    return event;
+}
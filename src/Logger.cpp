@@ -0,0 +1,171 @@
+/*
+ * Logger.cpp
+ * Project
+ * Albin Ågren
+ */
+
+#include "Logger.h"
+
+#include <iostream>
+#include <string>
+#include <thread>
+#include <mutex>
+#include <chrono>
+#include <utility>
+
+Logger::Logger(const std::size_t &capacity): mHead(0), mTail(0),
+                                             mWaiting(false),
+                                             mStopping(false),
+                                             mWrittenCount(0), mBatches(0),
+                                             mSink(LogSink::both),
+                                             mBackpressure(Backpressure::block),
+                                             mDropped(0) {
+    // with a single hardware thread the writer would only take turns with
+    // the simulation, so entries are written as they come
+    mSynchronous = std::thread::hardware_concurrency() == 1;
+
+    // round the capacity up to a power of two so slots are found by masking
+    std::size_t size = 1;
+    while(size < capacity) {
+        size *= 2;
+    }
+    mRing.resize(size);
+    mMask = size - 1;
+}
+
+Logger::~Logger() {
+    if(mWriter.joinable()) {
+        mStopping = true;
+        wake();
+        mWriter.join();
+    }
+    std::cout.flush();
+    if(mFile.is_open()) {
+        mFile.close();
+    }
+}
+
+bool Logger::openFile(const std::string &path) {
+    flush();
+    mFile.open(path);
+    return !mFile.fail();
+}
+
+void Logger::setSink(const LogSink &sink) {
+    // let the writer finish the entries meant for the old sinks
+    flush();
+    mSink = sink;
+}
+
+void Logger::write(std::string entry) {
+    if(mSink == LogSink::none) {
+        return;
+    }
+    if(mSynchronous) {
+        writeBatch(entry);
+        return;
+    }
+    if(!mWriter.joinable()) {
+        mWriter = std::thread(&Logger::run, this);
+    }
+
+    // wait for room, or give up on the entry
+    std::size_t head = mHead.load(std::memory_order_relaxed);
+    while(head - mTail.load(std::memory_order_acquire) > mMask) {
+        if(mBackpressure == Backpressure::drop) {
+            ++mDropped;
+            return;
+        }
+        wake();
+        std::this_thread::yield();
+    }
+
+    mRing[head & mMask] = std::move(entry);
+    mHead.store(head + 1, std::memory_order_seq_cst);
+
+    // only wake the writer if it went to sleep
+    if(mWaiting.load(std::memory_order_seq_cst)) {
+        wake();
+    }
+}
+
+void Logger::flush() {
+    if(mWriter.joinable()) {
+        std::size_t target = mHead.load(std::memory_order_relaxed);
+        wake();
+        std::unique_lock<std::mutex> lock(mMutex);
+        mWritten.wait(lock, [this, target]() {
+            return mWrittenCount == target;
+        });
+    }
+
+    // the writer is idle until the next entry, so the streams are free
+    std::cout.flush();
+    if(mFile.is_open()) {
+        mFile.flush();
+    }
+}
+
+unsigned long Logger::getBatches() const {
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mBatches;
+}
+
+void Logger::run() {
+    std::string batch;
+    while(true) {
+        std::size_t tail = mTail.load(std::memory_order_relaxed);
+        std::size_t head = mHead.load(std::memory_order_acquire);
+
+        if(tail == head) {
+            if(mStopping) {
+                // stopping is set after the last entry, so nothing is left
+                if(mHead.load(std::memory_order_acquire) == tail) {
+                    break;
+                }
+                continue;
+            }
+
+            // sleep until woken, checking again after announcing it so an
+            // entry handed over meanwhile is not missed
+            std::unique_lock<std::mutex> lock(mMutex);
+            mWaiting.store(true, std::memory_order_seq_cst);
+            if(mHead.load(std::memory_order_seq_cst) == tail && !mStopping) {
+                mAvailable.wait_for(lock, std::chrono::milliseconds(10));
+            }
+            mWaiting.store(false, std::memory_order_relaxed);
+            continue;
+        }
+
+        // take every waiting entry and give the slots back before writing
+        batch.clear();
+        for(; tail != head; ++tail) {
+            batch += mRing[tail & mMask];
+        }
+        mTail.store(tail, std::memory_order_release);
+
+        writeBatch(batch);
+
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mWrittenCount = tail;
+            ++mBatches;
+        }
+        mWritten.notify_all();
+    }
+}
+
+void Logger::writeBatch(const std::string &batch) {
+    if(mSink == LogSink::console || mSink == LogSink::both) {
+        std::cout.write(batch.data(), batch.size());
+    }
+    if((mSink == LogSink::file || mSink == LogSink::both) &&
+       mFile.is_open()) {
+        mFile.write(batch.data(), batch.size());
+    }
+}
+
+void Logger::wake() {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mAvailable.notify_one();
+}
@@ -0,0 +1,241 @@
+/*
+ * MinCostFlow.cpp
+ * Project
+ * Albin Ågren
+ */
+
+#include "MinCostFlow.h"
+
+#include <vector>
+#include <limits>
+#include <algorithm>
+#include <utility>
+
+namespace {
+
+// Marks the end of a list of arcs
+constexpr unsigned NONE = std::numeric_limits<unsigned>::max();
+
+// Distance of a node not reached
+constexpr long long FAR = std::numeric_limits<long long>::max() / 4;
+
+// States of a node while pushing flow
+constexpr char FREE = 0;
+constexpr char ON_PATH = 1;
+constexpr char DEAD = 2;
+
+// Struct representing an arc on the path being extended, the flow pushed
+// is the total when it was added and limit caps the total pushed over the
+// arcs up to it
+struct PathStep {
+    unsigned arc;
+    long long pushed;
+    long long limit;
+};
+
+}   // namespace
+
+MinCostFlow::MinCostFlow(const unsigned &nodes): mNodes(nodes),
+                                                 mFirst(nodes, NONE),
+                                                 mTotalFlow(0), mPhases(0) {
+}
+
+void MinCostFlow::reserve(const std::size_t &arcs) {
+    mHead.reserve(2 * arcs);
+    mCapacity.reserve(2 * arcs);
+    mCost.reserve(2 * arcs);
+    mNext.reserve(2 * arcs);
+}
+
+unsigned MinCostFlow::addArc(const unsigned &from, const unsigned &to,
+                             const long long &capacity,
+                             const long long &cost) {
+    unsigned arc = mHead.size();
+    mHead.push_back(to);
+    mCapacity.push_back(capacity);
+    mCost.push_back(cost);
+    mNext.push_back(mFirst[from]);
+    mFirst[from] = arc;
+
+    mHead.push_back(from);
+    mCapacity.push_back(0);
+    mCost.push_back(-cost);
+    mNext.push_back(mFirst[to]);
+    mFirst[to] = arc + 1;
+    return arc / 2;
+}
+
+long long MinCostFlow::solve(const unsigned &source, const unsigned &sink) {
+    mTotalFlow = 0;
+    mPhases = 0;
+    initPotentials(source);
+
+    while(updatePotentials(source, sink)) {
+        ++mPhases;
+        long long pushed = pushBlockingFlow(source, sink);
+        if(pushed == 0) {
+            break;
+        }
+        mTotalFlow += pushed;
+    }
+
+    long long cost = 0;
+    for(std::size_t arc = 0; arc < mHead.size(); arc += 2) {
+        cost += mCapacity[arc + 1] * mCost[arc];
+    }
+    return cost;
+}
+
+void MinCostFlow::initPotentials(const unsigned &source) {
+    // arcs lead forward, so one pass in node order settles every distance
+    mPotential.assign(mNodes, FAR);
+    mPotential[source] = 0;
+    for(unsigned node = source; node < mNodes; ++node) {
+        if(mPotential[node] == FAR) {
+            continue;
+        }
+        for(unsigned arc = mFirst[node]; arc != NONE; arc = mNext[arc]) {
+            if(arc % 2 == 0 && mCapacity[arc] > 0) {
+                long long distance = mPotential[node] + mCost[arc];
+                if(distance < mPotential[mHead[arc]]) {
+                    mPotential[mHead[arc]] = distance;
+                }
+            }
+        }
+    }
+
+    // nodes not reached can not be reached later either
+    for(long long &potential : mPotential) {
+        if(potential == FAR) {
+            potential = 0;
+        }
+    }
+}
+
+long long MinCostFlow::reducedCost(const unsigned &arc) const {
+    return mCost[arc] + mPotential[mHead[arc ^ 1]] - mPotential[mHead[arc]];
+}
+
+bool MinCostFlow::updatePotentials(const unsigned &source,
+                                   const unsigned &sink) {
+    // the reduced costs are small integers, so the nodes are settled from
+    // buckets by distance, and only until the sink is
+    mDistance.assign(mNodes, FAR);
+    mDistance[source] = 0;
+    if(mBuckets.empty()) {
+        mBuckets.resize(1);
+    }
+    mBuckets[0].push_back(source);
+
+    bool reached = false;
+    for(std::size_t distance = 0; distance < mBuckets.size(); ++distance) {
+        // index the bucket each time, a resize moves it
+        for(std::size_t i = 0; !reached && i < mBuckets[distance].size();
+            ++i) {
+            unsigned node = mBuckets[distance][i];
+            if(mDistance[node] != static_cast<long long>(distance)) {
+                continue;
+            } else if(node == sink) {
+                reached = true;
+                break;
+            }
+            for(unsigned arc = mFirst[node]; arc != NONE; arc = mNext[arc]) {
+                long long next = mDistance[node] + reducedCost(arc);
+                unsigned head = mHead[arc];
+                if(mCapacity[arc] == 0 || next >= mDistance[head] ||
+                   (head != sink && next >= mDistance[sink])) {
+                    continue;
+                }
+                mDistance[head] = next;
+                if(static_cast<std::size_t>(next) >= mBuckets.size()) {
+                    mBuckets.resize(next + 1);
+                }
+                mBuckets[next].push_back(head);
+            }
+        }
+        mBuckets[distance].clear();
+    }
+
+    if(!reached) {
+        return false;
+    }
+
+    // capping at the sink distance keeps every reduced cost non-negative
+    for(unsigned node = 0; node < mNodes; ++node) {
+        mPotential[node] += std::min(mDistance[node], mDistance[sink]);
+    }
+    return true;
+}
+
+long long MinCostFlow::pushBlockingFlow(const unsigned &source,
+                                        const unsigned &sink) {
+    long long total = 0;
+    std::vector<PathStep> path;
+
+    // a node is left as dead once no path to the sink is found from it,
+    // which pushing flow may undo, so passes are made until one pushes none
+    while(true) {
+        long long before = total;
+        mCurrent = mFirst;
+        mState.assign(mNodes, FREE);
+        mState[source] = ON_PATH;
+
+        // the flow of the arcs on the path is applied as they are left, so
+        // an augmentation costs no more than the arcs it saturates
+        auto leaveArc = [this, &path, &total](const char &state) {
+            long long flow = total - path.back().pushed;
+            mCapacity[path.back().arc] -= flow;
+            mCapacity[path.back().arc ^ 1] += flow;
+            mState[mHead[path.back().arc]] = state;
+            path.pop_back();
+        };
+
+        unsigned node = source;
+        while(true) {
+            if(node == sink) {
+                // step back to the first arc saturated
+                total = path.back().limit;
+                std::size_t saturated = std::partition_point(
+                                path.begin(), path.end(),
+                                [&total](const PathStep &step) {
+                                    return step.limit > total;
+                                }) - path.begin();
+                while(path.size() > saturated) {
+                    leaveArc(FREE);
+                }
+                node = path.empty() ? source : mHead[path.back().arc];
+                continue;
+            }
+
+            // follow an arc of zero reduced cost off the path
+            unsigned &arc = mCurrent[node];
+            while(arc != NONE &&
+                  (mCapacity[arc] == 0 || mState[mHead[arc]] != FREE ||
+                   reducedCost(arc) != 0)) {
+                arc = mNext[arc];
+            }
+            if(arc != NONE) {
+                long long limit = mCapacity[arc] + total;
+                if(!path.empty()) {
+                    limit = std::min(limit, path.back().limit);
+                }
+                path.push_back({ arc, total, limit });
+                mState[mHead[arc]] = ON_PATH;
+                node = mHead[arc];
+                continue;
+            }
+
+            // a dead end, step back and skip the arc leading here
+            if(path.empty()) {
+                break;
+            }
+            leaveArc(DEAD);
+            node = path.empty() ? source : mHead[path.back().arc];
+            mCurrent[node] = mNext[mCurrent[node]];
+        }
+
+        if(total == before) {
+            return total;
+        }
+    }
+}
@@ -0,0 +1,358 @@
+/*
+ * ParallelSimulation.cpp
+ * Project
+ * Albin Ågren
+ */
+
+#include "ParallelSimulation.h"
+#include "MyTime.h"
+#include "Event.h"
+#include "Simulation.h"
+#include "Controller.h"
+#include "Station.h"
+#include "Train.h"
+
+#include <vector>
+#include <memory>
+#include <string>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <algorithm>
+#include <iterator>
+#include <utility>
+#include <cmath>
+#include <stdexcept>
+
+/**
+ * Class for the simulation of one partition, holds the events of its own
+ * stations and collects events for other partitions until they are delivered
+ */
+class ParallelSimulation::Partition : public Simulation {
+public:
+    /**
+     * Constructor
+     *
+     * @param parent, a pointer to the parallel simulation owning the partition
+     * @param controller, a pointer to the controller owning the trains
+     * @param index, the index of the partition
+     * @param partitions, the total number of partitions
+     */
+    Partition(ParallelSimulation *parent, Controller *controller,
+              const unsigned &index, const unsigned &partitions):
+                                                        mParent(parent),
+                                                        mIndex(index),
+                                                        mOutboxes(partitions) {
+        setController(controller);
+        setCaptureLog(true);
+    }
+
+    // Virtual destructor
+    virtual ~Partition() { }
+
+    /**
+     * Function for scheduling a new event, events for stations in other
+     * partitions are held until the end of the window
+     *
+     * @param event, the event to be added to the queue
+     */
+    void scheduleEvent(const Event &event) override {
+        unsigned partition = mParent->getPartition(event);
+        if(partition == mIndex) {
+            Simulation::scheduleEvent(event);
+        } else {
+            mOutboxes[partition].push_back(event);
+        }
+    }
+
+    /**
+     * Function for taking over an event scheduled by another simulation
+     *
+     * @param event, the event to be added to the queue
+     */
+    void adoptEvent(const Event &event) { queueEvent(event); }
+
+    /**
+     * Function for processing all events before a time
+     *
+     * @param limit, the time in minutes to stop at
+     */
+    void processUntil(const int &limit) {
+        while(!done() && getNextEventTime().getTotalTime() < limit) {
+            processNextEvent();
+        }
+    }
+
+    /**
+     * Function for getting the events held for another partition
+     *
+     * @param index, the index of the receiving partition
+     * @return, a reference to the vector of held events
+     */
+    std::vector<Event> &getOutbox(const unsigned &index)
+        { return mOutboxes[index]; }
+
+// Private data members
+private:
+    ParallelSimulation *mParent;
+
+    unsigned mIndex;
+
+    std::vector<std::vector<Event>> mOutboxes;
+};
+
+ParallelSimulation::ParallelSimulation(Simulation *sim, Controller *controller,
+                                       const unsigned &threads):
+                                                        mSim(sim),
+                                                        mController(controller),
+                                                        mLookahead(0),
+                                                        mEndTime(0),
+                                                        mWindowEnd(0),
+                                                        mFinished(false),
+                                                        mWindows(0),
+                                                        mWaiting(0),
+                                                        mGeneration(0) {
+    unsigned noOfTrains = controller->getNoOfTrains();
+    unsigned partitions = assignStations(controller, threads, mOrigins,
+                                         mDestinations);
+
+    // the lookahead is the shortest journey between partitions, trains can
+    // only slow down when assembled so their initial top speed is a bound
+    mLookahead = 24 * 60;
+    for(unsigned index = 0; index < noOfTrains; ++index) {
+        if(mOrigins[index] == mDestinations[index]) {
+            continue;
+        }
+
+        // trains without a route fail on departure, as they do sequentially
+        Train *train = controller->getTrain(index);
+        if(!std::isnan(train->getDistance())) {
+            double hours = train->getDistance() / train->getTopSpeed();
+            int minutes = static_cast<int>(std::floor(hours * 60)) - 1;
+            mLookahead = std::min(mLookahead, minutes);
+        }
+    }
+
+    // without lookahead the partitions can not run independently
+    if(mLookahead < 1) {
+        partitions = 1;
+        std::fill(mOrigins.begin(), mOrigins.end(), 0);
+        std::fill(mDestinations.begin(), mDestinations.end(), 0);
+    }
+
+    for(unsigned index = 0; index < partitions; ++index) {
+        mPartitions.push_back(std::make_unique<Partition>(this, controller,
+                                                          index, partitions));
+    }
+}
+
+ParallelSimulation::~ParallelSimulation() = default;
+
+void ParallelSimulation::run(const Time &endTime) {
+    mEndTime = endTime.getTotalTime();
+    mWindows = 0;
+    mFinished = false;
+
+    // move the scheduled events to the partitions of their stations
+    for(const std::unique_ptr<Partition> &partition : mPartitions) {
+        partition->setTime(mSim->getTime());
+    }
+    for(const Event &event : mSim->takeEvents()) {
+        mPartitions[getPartition(event)]->adoptEvent(event);
+    }
+
+    mFinished = !nextWindow();
+
+    // the calling thread processes the first partition
+    std::vector<std::thread> workers;
+    for(unsigned index = 1; index < mPartitions.size(); ++index) {
+        workers.emplace_back(&ParallelSimulation::work, this, index);
+    }
+    work(0);
+    for(std::thread &worker : workers) {
+        worker.join();
+    }
+
+    // the simulation ends at the last event processed by any partition
+    Time lastTime = mSim->getTime();
+    for(const std::unique_ptr<Partition> &partition : mPartitions) {
+        if(lastTime < partition->getTime()) {
+            lastTime = partition->getTime();
+        }
+        mSim->addCounters(*partition);
+    }
+    mSim->setTime(lastTime);
+}
+
+unsigned ParallelSimulation::assignStations(Controller *controller,
+                                            const unsigned &threads,
+                                            std::vector<unsigned> &origins,
+                                            std::vector<unsigned> &destinations) {
+    unsigned noOfTrains = controller->getNoOfTrains();
+
+    // count the events each station will process, in order of appearance
+    std::vector<Station *> stations;
+    std::vector<unsigned long> loads;
+    auto addLoad = [&stations, &loads](Station *station, unsigned long load) {
+        auto it = std::find(stations.begin(), stations.end(), station);
+        if(it == stations.end()) {
+            stations.push_back(station);
+            loads.push_back(load);
+            return stations.size() - 1;
+        }
+        loads[it - stations.begin()] += load;
+        return static_cast<std::size_t>(it - stations.begin());
+    };
+
+    std::vector<std::size_t> stationOrigins(noOfTrains),
+                             stationDestinations(noOfTrains);
+    for(unsigned index = 0; index < noOfTrains; ++index) {
+        Train *train = controller->getTrain(index);
+        stationOrigins[index] = addLoad(train->getOrigin(), 3);
+        stationDestinations[index] = addLoad(train->getDestination(), 2);
+    }
+
+    // assign the busiest stations first, each to the least loaded partition
+    unsigned partitions = std::max(1u, std::min<unsigned>(threads,
+                                                          stations.size()));
+    std::vector<std::size_t> order(stations.size());
+    for(std::size_t i = 0; i < order.size(); ++i) {
+        order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(),
+                     [&loads](std::size_t left, std::size_t right) {
+                         return loads[left] > loads[right];
+                     });
+
+    std::vector<unsigned> stationPartitions(stations.size());
+    std::vector<unsigned long> partitionLoads(partitions, 0);
+    for(std::size_t station : order) {
+        unsigned lightest = std::min_element(partitionLoads.begin(),
+                                             partitionLoads.end())
+                            - partitionLoads.begin();
+        stationPartitions[station] = lightest;
+        partitionLoads[lightest] += loads[station];
+    }
+
+    origins.resize(noOfTrains);
+    destinations.resize(noOfTrains);
+    for(unsigned index = 0; index < noOfTrains; ++index) {
+        origins[index] = stationPartitions[stationOrigins[index]];
+        destinations[index] = stationPartitions[stationDestinations[index]];
+    }
+
+    return partitions;
+}
+
+unsigned ParallelSimulation::getPartition(const Event &event) const {
+    // events up to departure belong to the origin station
+    if(event.type < EventType::arrival) {
+        return mOrigins[event.train];
+    }
+    return mDestinations[event.train];
+}
+
+void ParallelSimulation::work(const unsigned &index) {
+    Partition &partition = *mPartitions[index];
+
+    while(!mFinished) {
+        partition.processUntil(mWindowEnd);
+        synchronize();
+
+        deliver(index);
+        synchronize();
+
+        // the first thread writes the log and sets up the next window
+        if(index == 0) {
+            writeLogs();
+            ++mWindows;
+            mFinished = !nextWindow();
+        }
+        synchronize();
+    }
+
+    // ensure all departed trains are arrived and disassembled
+    partition.finishRunningTrains();
+    synchronize();
+
+    if(index == 0) {
+        writeLogs();
+    }
+}
+
+void ParallelSimulation::synchronize() {
+    std::unique_lock<std::mutex> lock(mMutex);
+    unsigned generation = mGeneration;
+
+    // the last thread to arrive releases the others
+    if(++mWaiting == mPartitions.size()) {
+        mWaiting = 0;
+        ++mGeneration;
+        mCondition.notify_all();
+    } else {
+        mCondition.wait(lock, [this, generation] {
+            return generation != mGeneration;
+        });
+    }
+}
+
+void ParallelSimulation::deliver(const unsigned &index) {
+    Partition &receiver = *mPartitions[index];
+
+    for(const std::unique_ptr<Partition> &sender : mPartitions) {
+        std::vector<Event> &outbox = sender->getOutbox(index);
+        for(const Event &event : outbox) {
+            receiver.Simulation::scheduleEvent(event);
+        }
+        outbox.clear();
+    }
+}
+
+void ParallelSimulation::writeLogs() {
+    std::vector<LogEntry> entries;
+    for(const std::unique_ptr<Partition> &partition : mPartitions) {
+        std::vector<LogEntry> &captured = partition->getCapturedLog();
+        std::move(captured.begin(), captured.end(),
+                  std::back_inserter(entries));
+        captured.clear();
+    }
+
+    // every event has a unique time and train number, sort entries by event
+    std::stable_sort(entries.begin(), entries.end(),
+                     [](const LogEntry &left, const LogEntry &right) {
+                         return left.time < right.time ||
+                                (left.time == right.time &&
+                                 left.trainNumber < right.trainNumber);
+                     });
+
+    for(LogEntry &entry : entries) {
+        if(entry.record) {
+            mController->writeRecord(mSim, std::move(entry.text));
+        } else {
+            mController->writeLog(mSim, std::move(entry.text));
+        }
+    }
+}
+
+bool ParallelSimulation::nextWindow() {
+    // find the earliest event in any partition
+    bool found = false;
+    int earliest = 0;
+    for(const std::unique_ptr<Partition> &partition : mPartitions) {
+        if(!partition->done()) {
+            int next = partition->getNextEventTime().getTotalTime();
+            if(!found || next < earliest) {
+                earliest = next;
+                found = true;
+            }
+        }
+    }
+
+    if(!found || earliest >= mEndTime) {
+        return false;
+    }
+
+    // no partition can receive an event before the end of the window
+    mWindowEnd = std::min(earliest + mLookahead, mEndTime);
+    return true;
+}
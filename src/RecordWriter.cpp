@@ -0,0 +1,144 @@
+/*
+ * RecordWriter.cpp
+ * Project
+ * Albin Ågren
+ */
+
+#include "RecordWriter.h"
+#include "Train.h"
+#include "Station.h"
+#include "Vehicle.h"
+
+#include <string>
+#include <charconv>
+
+RecordWriter::RecordWriter(): mFormat(RecordFormat::jsonl), mRecords(0),
+                              mBytes(0) {
+}
+
+RecordWriter::~RecordWriter() {
+    close();
+}
+
+bool RecordWriter::open(const std::string &path, const RecordFormat &format) {
+    close();
+    mFile.open(path, std::ios::binary);
+    if(mFile.fail()) {
+        return false;
+    }
+    mFormat = format;
+    mRecords = 0;
+    mBytes = 0;
+    mBuffer.reserve(BUFFER_SIZE);
+
+    // the columns follow the order the fields are formatted in
+    if(mFormat == RecordFormat::csv) {
+        mBuffer += "event,time,train,origin,destination,scheduled_departure,"
+                   "departure,scheduled_arrival,arrival,speed,top_speed,"
+                   "delay,departure_delay,vehicles\n";
+        mBytes += mBuffer.size();
+    }
+    return true;
+}
+
+void RecordWriter::close() {
+    if(mFile.is_open()) {
+        flush();
+        mFile.close();
+    }
+}
+
+void RecordWriter::format(std::string &record, const char *event,
+                          const Time &time, const Train *train) const {
+    bool json = mFormat == RecordFormat::jsonl;
+
+    if(json) {
+        record += "{\"event\":\"";
+    }
+    record += event;
+    if(json) {
+        record += '"';
+    }
+    appendName(record, "time");
+    appendInteger(record, time.getTotalTime());
+    appendName(record, "train");
+    appendInteger(record, train->getTrainNumber());
+    appendName(record, "origin");
+    appendInteger(record, train->getOrigin()->getId());
+    appendName(record, "destination");
+    appendInteger(record, train->getDestination()->getId());
+    appendName(record, "scheduled_departure");
+    appendInteger(record, train->getOrigDeparture().getTotalTime());
+    appendName(record, "departure");
+    appendInteger(record, train->getCurrentDeparture().getTotalTime());
+    appendName(record, "scheduled_arrival");
+    appendInteger(record, train->getOrigArrival().getTotalTime());
+    appendName(record, "arrival");
+    appendInteger(record, train->getCurrentArrival().getTotalTime());
+    appendName(record, "speed");
+    appendDecimal(record, train->getSpeed());
+    appendName(record, "top_speed");
+    appendDecimal(record, train->getTopSpeed());
+    appendName(record, "delay");
+    appendInteger(record, train->getDelay().getTotalTime());
+    appendName(record, "departure_delay");
+    appendInteger(record, train->getDepartureDelay().getTotalTime());
+
+    // the vehicle ids are a JSON array, or one CSV field separated by ';'
+    appendName(record, "vehicles");
+    if(json) {
+        record += '[';
+    }
+    const char separator = json ? ',' : ';';
+    bool first = true;
+    for(const Vehicle *vehicle : train->getVehicles()) {
+        if(!first) {
+            record += separator;
+        }
+        appendInteger(record, vehicle->getId());
+        first = false;
+    }
+    if(json) {
+        record += "]}";
+    }
+    record += '\n';
+}
+
+void RecordWriter::write(const std::string &record) {
+    mBuffer += record;
+    mBytes += record.size();
+    ++mRecords;
+    if(mBuffer.size() >= BUFFER_SIZE) {
+        flush();
+    }
+}
+
+void RecordWriter::flush() {
+    if(mFile.is_open() && !mBuffer.empty()) {
+        mFile.write(mBuffer.data(), mBuffer.size());
+        mFile.flush();
+    }
+    mBuffer.clear();
+}
+
+void RecordWriter::appendName(std::string &record, const char *name) const {
+    if(mFormat == RecordFormat::jsonl) {
+        record += ",\"";
+        record += name;
+        record += "\":";
+    } else {
+        record += ',';
+    }
+}
+
+void RecordWriter::appendInteger(std::string &record, const long long &value) {
+    char digits[24];
+    std::to_chars_result result = std::to_chars(digits, digits + 24, value);
+    record.append(digits, result.ptr);
+}
+
+void RecordWriter::appendDecimal(std::string &record, const double &value) {
+    char digits[32];
+    std::to_chars_result result = std::to_chars(digits, digits + 32, value);
+    record.append(digits, result.ptr);
+}
@@ -0,0 +1,124 @@
+/*
+ * Router.cpp
+ * Project
+ * Albin Ågren
+ */
+
+#include "Router.h"
+#include "DistanceTable.h"
+
+#include <vector>
+#include <queue>
+#include <limits>
+#include <functional>
+#include <algorithm>
+#include <utility>
+#include <cmath>
+
+void Router::build(const unsigned &stations, const std::vector<Link> &links) {
+    mStations = stations;
+    mCache.clear();
+
+    // count the links of each station and place them in rows
+    mOffsets.assign(stations + 1, 0);
+    for(const Link &link : links) {
+        ++mOffsets[link.station0 + 1];
+        ++mOffsets[link.station1 + 1];
+    }
+    for(unsigned i = 0; i < stations; ++i) {
+        mOffsets[i + 1] += mOffsets[i];
+    }
+
+    std::vector<std::size_t> next(mOffsets.begin(), mOffsets.end() - 1);
+    mNeighbours.assign(2 * links.size(), 0);
+    mLengths.assign(2 * links.size(), 0);
+    for(const Link &link : links) {
+        mNeighbours[next[link.station0]] = link.station1;
+        mLengths[next[link.station0]++] = link.distance;
+        mNeighbours[next[link.station1]] = link.station0;
+        mLengths[next[link.station1]++] = link.distance;
+    }
+}
+
+double Router::getDistance(const unsigned &from, const unsigned &to) {
+    if(from >= mStations || to >= mStations) {
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+    double distance = getTree(from).distances[to];
+    return std::isinf(distance) ? std::numeric_limits<double>::quiet_NaN()
+                                : distance;
+}
+
+std::vector<unsigned> Router::getRoute(const unsigned &from,
+                                       const unsigned &to) {
+    std::vector<unsigned> route;
+    if(std::isnan(getDistance(from, to))) {
+        return route;
+    }
+
+    // follow the tree back from the destination
+    const Tree &tree = getTree(from);
+    for(unsigned station = to; station != from;
+        station = tree.previous[station]) {
+        route.push_back(station);
+    }
+    route.push_back(from);
+    std::reverse(route.begin(), route.end());
+
+    return route;
+}
+
+std::size_t Router::getMemoryUsage() const {
+    std::size_t bytes = mOffsets.capacity() * sizeof(std::size_t) +
+                        mNeighbours.capacity() * sizeof(unsigned) +
+                        mLengths.capacity() * sizeof(double);
+    for(const auto &entry : mCache) {
+        bytes += entry.second.distances.capacity() * sizeof(double) +
+                 entry.second.previous.capacity() * sizeof(unsigned);
+    }
+    return bytes;
+}
+
+const Router::Tree &Router::getTree(const unsigned &from) {
+    auto it = mCache.find(from);
+    if(it != mCache.end()) {
+        return it->second;
+    }
+
+    // make room for the new routes
+    if((mCache.size() + 1) * mStations > MAX_CACHED_ENTRIES) {
+        mCache.clear();
+    }
+
+    Tree &tree = mCache[from];
+    tree.distances.assign(mStations, std::numeric_limits<double>::infinity());
+    tree.previous.assign(mStations, from);
+    ++mSearches;
+
+    // Dijkstra's algorithm with a binary heap of (distance, station)
+    using Entry = std::pair<double, unsigned>;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> heap;
+    tree.distances[from] = 0;
+    heap.push({ 0, from });
+    while(!heap.empty()) {
+        Entry entry = heap.top();
+        heap.pop();
+        unsigned station = entry.second;
+
+        // skip stations already reached by a shorter route
+        if(entry.first > tree.distances[station]) {
+            continue;
+        }
+        for(std::size_t i = mOffsets[station]; i < mOffsets[station + 1];
+            ++i) {
+            double distance = entry.first + mLengths[i];
+            if(distance < tree.distances[mNeighbours[i]]) {
+                tree.distances[mNeighbours[i]] = distance;
+                tree.previous[mNeighbours[i]] = station;
+                heap.push({ distance, mNeighbours[i] });
+            }
+        }
+    }
+
+    return tree;
+}
@@ -0,0 +1,127 @@
+/*
+ * Scenario.cpp
+ * Project
+ * Albin Ågren
+ */
+
+#include "Scenario.h"
+#include "MyTime.h"
+
+#include <vector>
+#include <string>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+Scenario::Scenario(const std::string &directory):
+                                        mStations(readStations(directory)),
+                                        mDistances(readDistances(directory)),
+                                        mTrains(readTrains(directory)) { }
+
+std::vector<StationData> Scenario::readStations(const std::string &directory) {
+    std::ifstream inFile(directory + "TrainStations.txt");
+
+    // throw exception if file failed to open
+    if(inFile.fail()) {
+        throw std::runtime_error("station file failed to open");
+    }
+
+    std::vector<StationData> stations;
+    std::string tmpStr;
+    // read station name
+    while(inFile >> tmpStr) {
+        StationData station;
+        station.name = tmpStr;
+
+        // get vehicle information
+        std::getline(inFile, tmpStr);
+
+        std::string vehicleStr;     // string to hold vehicle data
+        // parse all vehicles
+        while(!tmpStr.empty()) {
+            // get substring representing single vehicle
+            vehicleStr = tmpStr.substr(tmpStr.find('(') + 1,
+                                       tmpStr.find(')') - 1);
+            tmpStr = tmpStr.substr(tmpStr.find(')') + 1);
+
+            VehicleData vehicle = { 0, 0, 0, 0 };
+            std::stringstream ss(vehicleStr);
+            ss >> vehicle.id >> vehicle.type;   // use sstream to convert
+
+            // read the parameters of the vehicle type
+            switch(vehicle.type) {
+                case 0:
+                case 2:
+                case 4:
+                case 5:
+                    ss >> vehicle.param0 >> vehicle.param1;
+                    break;
+                case 1:
+                case 3:
+                    ss >> vehicle.param0;
+                    break;
+                default:
+                    // if type out of range, throw error
+                    throw std::runtime_error("datafile corrupted");
+            }
+            station.vehicles.push_back(vehicle);
+        }
+        stations.push_back(station);
+    }
+    inFile.close();
+
+    return stations;
+}
+
+std::vector<DistanceData> Scenario::readDistances(
+                                            const std::string &directory) {
+    std::ifstream inFile(directory + "TrainMap.txt");
+
+    // throw exception if file failed to open
+    if(inFile.fail()) {
+        throw std::runtime_error("map file failed to open");
+    }
+
+    std::vector<DistanceData> distances;
+    DistanceData distance;
+    // get all distances
+    while(inFile >> distance.station0) {
+        inFile >> distance.station1;
+        inFile >> distance.distance;
+        distances.push_back(distance);
+    }
+    inFile.close();
+
+    return distances;
+}
+
+std::vector<TrainData> Scenario::readTrains(const std::string &directory) {
+    std::ifstream inFile(directory + "Trains.txt");
+
+    // throw exception if file failed to open
+    if(inFile.fail()) {
+        throw std::runtime_error("train file failed to open");
+    }
+
+    std::vector<TrainData> trains;
+    std::string tmpStr;
+    // get line representing single train
+    while(std::getline(inFile, tmpStr)) {
+        std::stringstream ss(tmpStr);
+        TrainData train;
+        int type;
+
+        // get id, origin, destination, departure time and arrival time
+        ss >> train.trainNumber >> train.origin >> train.destination
+           >> train.departure >> train.arrival >> train.topSpeed;
+
+        // get the required vehicles
+        while(ss >> type) {
+            train.requiredVehicles.push_back(type);
+        }
+        trains.push_back(train);
+    }
+    inFile.close();
+
+    return trains;
+}
@@ -6,39 +6,161 @@
 
 #include "Simulation.h"
 #include "Event.h"
+#include "EventQueue.h"
+#include "BinaryIO.h"
 
-#include <queue>
 #include <vector>
 #include <memory>
+#include <string>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <cstdint>
+
+Simulation::Simulation(const QueueType &queueType): mCurrentTime(Time(0, 0)),
+                                                    mCurrentEvent(),
+                                                    mController(nullptr) {
+    // create the requested event queue implementation
+    mEventQueue = makeQueue(queueType);
+
+    // room for the counters of the first day and the one after, so counting
+    // trains that arrive past midnight does not allocate
+    mEventsPerDay.reserve(2);
+    mAllocationsPerDay.reserve(2);
+}
+
+void Simulation::scheduleEvent(const Event &event) {
+    unsigned long allocations = mEventQueue->getAllocations();
 
-void Simulation::scheduleEvent(const std::shared_ptr<Event> &event) {
     // add event to queue
-    mEventQueue.push(event);
+    mEventQueue->push(event);
+
+    countEvent(mEventQueue->getAllocations() - allocations);
+}
+
+std::vector<Event> Simulation::takeEvents() {
+    std::vector<Event> events;
+
+    // pop all events in the order they would have been processed
+    while(!mEventQueue->empty()) {
+        events.push_back(mEventQueue->top());
+        mEventQueue->pop();
+    }
+    return events;
 }
 
 void Simulation::processNextEvent() {
     // get next event from queue and pop it
-    std::shared_ptr<Event> nextEvent = mEventQueue.top();
-    mEventQueue.pop();
+    mCurrentEvent = mEventQueue->top();
+    mEventQueue->pop();
 
     // set the time
-    mCurrentTime = nextEvent->getTime();
+    mCurrentTime = mCurrentEvent.getTime();
 
     // process the event
-    nextEvent->processEvent();
+    processEvent(mCurrentEvent, this, mController);
+    ++mEventsProcessed;
 }
 
 void Simulation::finishRunningTrains() {
-    std::shared_ptr<Event> nextEvent;
-
     // pop all events, process those for departed trains
-    while(!mEventQueue.empty()) {
-        nextEvent = mEventQueue.top();
+    while(!mEventQueue->empty()) {
+        mCurrentEvent = mEventQueue->top();
+        mEventQueue->pop();
+
         // only process events for departed trains
-        if(nextEvent->getType() > 2) {
-            mCurrentTime = nextEvent->getTime();
-            nextEvent->processEvent();
+        if(mCurrentEvent.type >= EventType::arrival) {
+            mCurrentTime = mCurrentEvent.getTime();
+            processEvent(mCurrentEvent, this, mController);
+            ++mEventsProcessed;
         }
-        mEventQueue.pop();
+    }
+}
+
+void Simulation::captureLog(const std::string &entry, const bool &record) {
+    // tag the entry with the event being processed
+    mCapturedLog.push_back({ mCurrentEvent.time, mCurrentEvent.trainNumber,
+                             entry, record });
+}
+
+void Simulation::addCounters(const Simulation &other) {
+    if(mEventsPerDay.size() < other.mEventsPerDay.size()) {
+        mEventsPerDay.resize(other.mEventsPerDay.size(), 0);
+        mAllocationsPerDay.resize(other.mAllocationsPerDay.size(), 0);
+    }
+    for(std::size_t day = 0; day < other.mEventsPerDay.size(); ++day) {
+        mEventsPerDay[day] += other.mEventsPerDay[day];
+        mAllocationsPerDay[day] += other.mAllocationsPerDay[day];
+    }
+    mEventsProcessed += other.mEventsProcessed;
+}
+
+void Simulation::countEvent(const unsigned long &allocations) {
+    // grow the per day counters to cover the current day
+    std::size_t day = mCurrentTime.getDay();
+    if(mEventsPerDay.size() <= day) {
+        mEventsPerDay.resize(day + 1, 0);
+        mAllocationsPerDay.resize(day + 1, 0);
+    }
+
+    ++mEventsPerDay[day];
+    mAllocationsPerDay[day] += allocations;
+}
+
+SimulationState Simulation::saveState() const {
+    return { mCurrentTime, mCurrentEvent,
+             std::shared_ptr<const EventQueue>(mEventQueue->clone()),
+             mAllocationsPerDay, mEventsPerDay, mEventsProcessed };
+}
+
+void Simulation::restoreState(const SimulationState &state) {
+    mCurrentTime = state.time;
+    mCurrentEvent = state.currentEvent;
+    mEventQueue = state.queue->clone();
+    mAllocationsPerDay = state.allocationsPerDay;
+    mEventsPerDay = state.eventsPerDay;
+    mEventsProcessed = state.eventsProcessed;
+}
+
+void Simulation::writeState(std::ostream &os, const SimulationState &state) {
+    writeBinary(os, state.time.getTotalTime());
+    writeEvent(os, state.currentEvent);
+    writeBinaryVector(os, state.allocationsPerDay);
+    writeBinaryVector(os, state.eventsPerDay);
+    writeBinary(os, static_cast<std::uint64_t>(state.eventsProcessed));
+    writeBinary(os, static_cast<std::uint8_t>(state.queue->getType()));
+    state.queue->writeState(os);
+}
+
+void Simulation::readState(std::istream &is, const std::size_t &trains) {
+    std::uint64_t processed;
+    std::uint8_t queueType;
+    mCurrentTime = Time::fromMinutes(readBinaryMinutes(is));
+    mCurrentEvent = readEvent(is, trains);
+    readBinaryVector(is, mAllocationsPerDay);
+    readBinaryVector(is, mEventsPerDay);
+    if(mAllocationsPerDay.size() != mEventsPerDay.size()) {
+        throw std::runtime_error("checkpoint holds damaged counters");
+    }
+    readBinary(is, processed);
+    mEventsProcessed = processed;
+
+    readBinary(is, queueType);
+    if(queueType > calendar) {
+        throw std::runtime_error("checkpoint holds an unknown event queue");
+    }
+    mEventQueue = makeQueue(static_cast<QueueType>(queueType));
+    mEventQueue->readState(is, trains);
+}
+
+std::unique_ptr<EventQueue> Simulation::makeQueue(const QueueType &queueType) {
+    switch(queueType) {
+        case quaternaryHeap:
+            return std::make_unique<HeapEventQueue<4>>();
+        case calendar:
+            return std::make_unique<CalendarEventQueue>();
+        case binaryHeap:
+        default:
+            return std::make_unique<HeapEventQueue<2>>();
     }
 }
@@ -1,42 +1,169 @@
 /*
- * Train.cpp
+ * Station.cpp
  * Project
  * Albin Ågren
  */
 
 #include "Station.h"
 #include "Vehicle.h"
+#include "BinaryIO.h"
 
 #include <string>
 #include <vector>
+#include <array>
 #include <memory>
-#include <map>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <cstdint>
 #include <algorithm>
 
-void Station::setDistance(const std::string &stationName, const double &distance) {
-    // insert a key-value pair representing the distance to another station
-    mDistances.insert(std::pair<std::string, double>(stationName, distance));
+std::vector<Vehicle *> Station::getVehicles() const {
+    std::vector<Vehicle *> vehicles;
+    vehicles.reserve(getNoOfVehicles());
+    forEachVehicle([&vehicles](Vehicle *vehicle) {
+        vehicles.push_back(vehicle);
+    });
+    return vehicles;
+}
+
+void Station::setVehicles(const std::vector<Vehicle *> &vehicles) {
+    for(PoolQueue &queue : mVehicles) {
+        queue.entries.clear();
+        queue.front = 0;
+    }
+    for(Vehicle *vehicle : vehicles) {
+        pushVehicle(vehicle);
+    }
+}
+
+std::size_t Station::getNoOfVehicles() const {
+    std::size_t vehicles = 0;
+    for(const PoolQueue &queue : mVehicles) {
+        vehicles += queue.entries.size() - queue.front;
+    }
+    return vehicles;
+}
+
+std::size_t Station::getNoOfVehicles(const int &type) const {
+    if(type < 0 || type >= VEHICLE_TYPES) {
+        return 0;
+    }
+    return mVehicles[type].entries.size() - mVehicles[type].front;
 }
 
 void Station::attachVehicle(Vehicle *const vehicle) {
-    // add vehicle to vector and set vehicle station member pointer
-    mVehicles.push_back(vehicle);
+    // add vehicle to the queue of its type and set vehicle station pointer
+    pushVehicle(vehicle);
     vehicle->setStation(this);
 }
 
 bool Station::detachVehicle(const int &type, Vehicle **vehicle) {
-    // use find_if with lambda to find vehicles of matching type
-    auto it = std::find_if(mVehicles.begin(), mVehicles.end(), 
-                           [type](Vehicle *vehicle)
-                                { return vehicle->getType() == type; });
-
-    // if vehicle found, remove it from the member vector and return true
-    if(it != mVehicles.end()) {
-        *vehicle = *it;
-        (*it)->setStation(nullptr);     // unset the vehicle station pointer
-        mVehicles.erase(it);
+    // if a vehicle of the type is available, take the oldest and return true
+    if(getNoOfVehicles(type) > 0) {
+        PoolQueue &queue = mVehicles[type];
+        *vehicle = queue.entries[queue.front++].vehicle;
+        (*vehicle)->setStation(nullptr);    // unset the vehicle station pointer
+
+        // start over at the beginning once the queue is empty
+        if(queue.front == queue.entries.size()) {
+            queue.entries.clear();
+            queue.front = 0;
+        }
         return true;
     } else {
         return false;
     }
 }
+
+bool Station::detachVehicle(Vehicle *const vehicle) {
+    const PoolQueue &queue = mVehicles[vehicle->getType()];
+    for(std::size_t i = queue.front; i < queue.entries.size(); ++i) {
+        if(queue.entries[i].vehicle == vehicle) {
+            removeEntry(vehicle->getType(), i);
+            return true;
+        }
+    }
+    return false;
+}
+
+void Station::removeEntry(const int &type, const std::size_t &position) {
+    PoolQueue &queue = mVehicles[type];
+    queue.entries[position].vehicle->setStation(nullptr);
+
+    // the oldest vehicle is dropped from the front, others keep the order
+    if(position == queue.front) {
+        ++queue.front;
+    } else {
+        queue.entries.erase(queue.entries.begin() + position);
+    }
+
+    // start over at the beginning once the queue is empty
+    if(queue.front == queue.entries.size()) {
+        queue.entries.clear();
+        queue.front = 0;
+    }
+}
+
+void Station::pushVehicle(Vehicle *const vehicle) {
+    PoolQueue &queue = mVehicles[vehicle->getType()];
+
+    // rather than grow a full vector, drop the detached entries if they are
+    // at least half of it
+    if(queue.entries.size() == queue.entries.capacity() &&
+       queue.front >= queue.entries.size() / 2 && queue.front > 0) {
+        queue.entries.erase(queue.entries.begin(),
+                            queue.entries.begin() + queue.front);
+        queue.front = 0;
+    }
+    if(queue.entries.size() == queue.entries.capacity()) {
+        ++mAllocations;
+    }
+    queue.entries.push_back({ mAttached++, vehicle });
+}
+
+void Station::writeState(std::ostream &os) const {
+    // the detached entries before the front are left out
+    for(const PoolQueue &queue : mVehicles) {
+        writeBinary(os, static_cast<std::uint64_t>(queue.entries.size() -
+                                                   queue.front));
+        for(std::size_t i = queue.front; i < queue.entries.size(); ++i) {
+            writeBinary(os, static_cast<std::uint64_t>(
+                                                queue.entries[i].attached));
+            writeBinary(os, static_cast<std::uint32_t>(
+                                    queue.entries[i].vehicle->getTableRow()));
+        }
+    }
+    writeBinary(os, static_cast<std::uint64_t>(mAttached));
+    writeBinary(os, static_cast<std::uint64_t>(mAllocations));
+}
+
+void Station::readState(std::istream &is,
+                        const std::vector<std::unique_ptr<Vehicle>> &vehicles) {
+    for(int type = 0; type < VEHICLE_TYPES; ++type) {
+        PoolQueue &queue = mVehicles[type];
+        queue.entries.clear();
+        queue.front = 0;
+
+        std::uint64_t size;
+        readBinary(is, size);
+        for(std::uint64_t i = 0; i < size; ++i) {
+            std::uint64_t attached;
+            std::uint32_t row;
+            readBinary(is, attached);
+            readBinary(is, row);
+            if(row >= vehicles.size() || vehicles[row]->getType() != type) {
+                throw std::runtime_error(
+                                    "checkpoint refers to unknown vehicle");
+            }
+            vehicles[row]->setStation(this);
+            queue.entries.push_back({ attached, vehicles[row].get() });
+        }
+    }
+
+    std::uint64_t attached, allocations;
+    readBinary(is, attached);
+    readBinary(is, allocations);
+    mAttached = attached;
+    mAllocations = allocations;
+}
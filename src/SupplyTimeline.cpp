@@ -0,0 +1,182 @@
+/*
+ * SupplyTimeline.cpp
+ * Project
+ * Albin Ågren
+ */
+
+#include "SupplyTimeline.h"
+#include "Station.h"
+#include "Train.h"
+
+#include <vector>
+#include <array>
+#include <memory>
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+namespace {
+
+// Struct representing a train taking or leaving vehicles of one type
+struct Change {
+    unsigned row;
+    int time;
+    int vehicles;
+};
+
+}   // namespace
+
+void SupplyTimeline::build(
+                        const std::vector<std::unique_ptr<Station>> &stations,
+                        const std::vector<std::unique_ptr<Train>> &trains) {
+    mStations = stations.size();
+    std::size_t rows = mStations * Station::VEHICLE_TYPES;
+    mInitial.assign(rows, 0);
+    for(const std::unique_ptr<Station> &station : stations) {
+        for(int type = 0; type < Station::VEHICLE_TYPES; ++type) {
+            mInitial[getRow(station->getId(), type)] =
+                                            station->getNoOfVehicles(type);
+        }
+    }
+
+    // gather the changes in one pass over the trains
+    std::vector<Change> gathered;
+    gathered.reserve(2 * trains.size());
+    int earliest = std::numeric_limits<int>::max();
+    int latest = std::numeric_limits<int>::min();
+    for(const std::unique_ptr<Train> &train : trains) {
+        std::array<int, Station::VEHICLE_TYPES> needs;
+        needs.fill(0);
+        for(const int &type : train->getRequiredVehicles()) {
+            if(type >= 0 && type < Station::VEHICLE_TYPES) {
+                ++needs[type];
+            }
+        }
+
+        int assembly = (train->getOrigDeparture() - Time(0, 30))
+                                                            .getTotalTime();
+        int disassembly = (train->getOrigArrival() + Time(0, 20))
+                                                            .getTotalTime();
+        unsigned origin = static_cast<unsigned>(
+                                    getRow(train->getOrigin()->getId(), 0));
+        unsigned destination = static_cast<unsigned>(
+                                getRow(train->getDestination()->getId(), 0));
+        for(int type = 0; type < Station::VEHICLE_TYPES; ++type) {
+            if(needs[type] > 0) {
+                gathered.push_back({ origin + type, assembly, -needs[type] });
+                gathered.push_back({ destination + type, disassembly,
+                                     needs[type] });
+            }
+        }
+        earliest = std::min({ earliest, assembly, disassembly });
+        latest = std::max({ latest, assembly, disassembly });
+    }
+    if(trains.empty()) {
+        earliest = latest = 0;
+    }
+
+    // the times are minutes over a few days, so the changes are counted
+    // into place by time and then, keeping that order, by row
+    std::vector<Change> changes(gathered.size());
+    std::vector<std::size_t> counts(latest - earliest + 2, 0);
+    for(const Change &change : gathered) {
+        ++counts[change.time - earliest + 1];
+    }
+    for(std::size_t i = 1; i < counts.size(); ++i) {
+        counts[i] += counts[i - 1];
+    }
+    for(const Change &change : gathered) {
+        changes[counts[change.time - earliest]++] = change;
+    }
+
+    counts.assign(rows + 1, 0);
+    for(const Change &change : changes) {
+        ++counts[change.row + 1];
+    }
+    for(std::size_t row = 0; row < rows; ++row) {
+        counts[row + 1] += counts[row];
+    }
+    std::vector<std::size_t> starts(counts);
+    for(const Change &change : changes) {
+        gathered[counts[change.row]++] = change;
+    }
+
+    // walk each row, one entry per time, taking the vehicles before leaving
+    // any so the lowest count of the minute is kept
+    mTimes.clear();
+    mInventory.clear();
+    mLowest.clear();
+    mTimes.reserve(gathered.size());
+    mInventory.reserve(gathered.size());
+    mLowest.reserve(gathered.size());
+    mOffsets.assign(rows + 1, 0);
+    for(std::size_t row = 0; row < rows; ++row) {
+        int inventory = mInitial[row];
+        int lowest = inventory;
+        std::size_t last = starts[row + 1];
+        for(std::size_t i = starts[row]; i < last;) {
+            int time = gathered[i].time;
+            int taken = 0, left = 0;
+            for(; i < last && gathered[i].time == time; ++i) {
+                (gathered[i].vehicles < 0 ? taken : left) +=
+                                                        gathered[i].vehicles;
+            }
+            lowest = std::min(lowest, inventory + taken);
+            inventory += taken + left;
+            mTimes.push_back(time);
+            mInventory.push_back(inventory);
+            mLowest.push_back(lowest);
+        }
+        mOffsets[row + 1] = mTimes.size();
+    }
+}
+
+int SupplyTimeline::getInventory(const unsigned &station, const int &type,
+                                 const Time &time) const {
+    std::size_t row = getRow(station, type);
+    std::vector<int>::const_iterator first = mTimes.begin() + mOffsets[row];
+    std::vector<int>::const_iterator last = mTimes.begin() +
+                                            mOffsets[row + 1];
+
+    // the last change at or before the time holds the count
+    std::vector<int>::const_iterator change =
+                            std::upper_bound(first, last, time.getTotalTime());
+    if(change == first) {
+        return mInitial[row];
+    }
+    return mInventory[change - mTimes.begin() - 1];
+}
+
+bool SupplyTimeline::getEarliestShortage(const unsigned &station,
+                                         const int &type, Time &time) const {
+    std::size_t row = getRow(station, type);
+    std::vector<int>::const_iterator first = mLowest.begin() + mOffsets[row];
+    std::vector<int>::const_iterator last = mLowest.begin() +
+                                            mOffsets[row + 1];
+
+    // the lowest count never rises, so the first below zero is searched for
+    std::vector<int>::const_iterator shortage = std::partition_point(
+                    first, last, [](const int &lowest) { return lowest >= 0; });
+    if(shortage == last) {
+        return false;
+    }
+    time = Time::fromMinutes(mTimes[shortage - mLowest.begin()]);
+    return true;
+}
+
+int SupplyTimeline::getLowestInventory(const unsigned &station,
+                                       const int &type) const {
+    std::size_t row = getRow(station, type);
+    if(mOffsets[row] == mOffsets[row + 1]) {
+        return mInitial[row];
+    }
+    return mLowest[mOffsets[row + 1] - 1];
+}
+
+std::size_t SupplyTimeline::getRow(const unsigned &station,
+                                   const int &type) const {
+    if(station >= mStations || type < 0 || type >= Station::VEHICLE_TYPES) {
+        throw std::out_of_range("unknown station or vehicle type");
+    }
+    return static_cast<std::size_t>(station) * Station::VEHICLE_TYPES + type;
+}
@@ -0,0 +1,835 @@
+/*
+ * TimeWarpSimulation.cpp
+ * Project
+ * Albin Ågren
+ */
+
+#include "TimeWarpSimulation.h"
+#include "ParallelSimulation.h"
+#include "MyTime.h"
+#include "Event.h"
+#include "Simulation.h"
+#include "Controller.h"
+#include "Station.h"
+#include "Train.h"
+#include "Vehicle.h"
+
+#include <vector>
+#include <deque>
+#include <set>
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <algorithm>
+#include <iterator>
+#include <utility>
+#include <cstddef>
+
+namespace {
+
+// Orders events as a sequential run processes them, events of the same
+// train at the same time follow the order of the lifecycle
+bool before(const Event &left, const Event &right) {
+    if(left.time != right.time) {
+        return left.time < right.time;
+    }
+    if(left.trainNumber != right.trainNumber) {
+        return left.trainNumber < right.trainNumber;
+    }
+    return left.type < right.type;
+}
+
+struct EventOrder {
+    bool operator()(const Event &left, const Event &right) const {
+        return before(left, right);
+    }
+};
+
+}   // namespace
+
+/**
+ * Class for the simulation of one process, executes the events of its own
+ * stations ahead of the other processes and keeps what is needed to undo
+ * them until they are committed
+ *
+ * A train and its vehicles are only touched by the process holding the
+ * train's next event. When a departure is undone after its arrival was sent,
+ * the train stays with the destination until the arrival is cancelled there,
+ * so restoring its state is deferred until the train is returned
+ */
+class TimeWarpSimulation::Process : public Simulation {
+public:
+    /**
+     * Constructor
+     *
+     * @param parent, a pointer to the time warp simulation owning the process
+     * @param controller, a pointer to the controller owning the trains
+     * @param index, the index of the process
+     */
+    Process(TimeWarpSimulation *parent, Controller *controller,
+            const unsigned &index): mParent(parent),
+                                    mController(controller),
+                                    mIndex(index),
+                                    mCurrent(nullptr) {
+        setController(controller);
+        setCaptureLog(true);
+    }
+
+    // Virtual destructor
+    virtual ~Process() { }
+
+    /**
+     * Function for taking over an event scheduled by another simulation
+     *
+     * @param event, the event
+     */
+    void adoptEvent(const Event &event) { mPending.insert(event); }
+
+    /**
+     * Function for scheduling an event produced by the executing event,
+     * events for other processes are sent to them right away
+     *
+     * @param event, the event to be scheduled
+     */
+    void scheduleEvent(const Event &event) override;
+
+    /**
+     * Function for receiving a message, called by the sending thread
+     *
+     * @param message, the message
+     */
+    void receive(const Message &message);
+
+    /**
+     * Function for handling all received messages
+     */
+    void drain();
+
+    /**
+     * Function for executing the next pending event if possible
+     *
+     * @param endTime, the end time in minutes of the simulation
+     * @return, a bool indicating if an event was executed
+     */
+    bool step(const int &endTime);
+
+    /**
+     * Function for discerning if the process has pending events
+     *
+     * @return, a bool indicating if there are pending events
+     */
+    bool hasPending() const { return !mPending.empty(); }
+
+    /**
+     * Function for getting the earliest pending event
+     *
+     * @return, a reference to the earliest pending event
+     */
+    const Event &getNext() const { return *mPending.begin(); }
+
+    /**
+     * Function for committing executed events before the GVT
+     *
+     * @param gvt, the earliest event that can still be rolled back to
+     * @param all, a bool indicating if all executed events are committed
+     */
+    void commit(const Event &gvt, const bool &all);
+
+    /**
+     * Function for finishing the departed trains of the process once all
+     * events before the end time are committed
+     */
+    void finish();
+
+    /**
+     * Function for getting the log entries of committed events
+     *
+     * @return, a reference to the vector of committed log entries
+     */
+    std::vector<LogEntry> &getCommittedLog() { return mCommittedLog; }
+
+    unsigned long getExecuted() const { return mExecuted; }
+
+    unsigned long getCommitted() const { return mCommitted; }
+
+    unsigned long getRolledBack() const { return mRolledBack; }
+
+    unsigned long getRollbacks() const { return mRollbacks; }
+
+    unsigned long getAntiMessages() const { return mAntiMessages; }
+
+// Private member functions
+private:
+    // Struct representing the state of a vehicle before an event
+    struct VehicleState {
+        Vehicle *vehicle;
+        std::size_t history;
+        std::size_t logged;
+        Station *station;
+        Train *train;
+    };
+
+    // Struct representing an executed event and what is needed to undo it
+    struct Record {
+        Record(const Event &executed, const Train &before): event(executed),
+                                                            train(before),
+                                                            station(nullptr) { }
+
+        Event event;
+
+        Train train;        // the train before the event
+
+        Station *station;   // the station whose pool the event changes
+
+        std::vector<Vehicle *> pool;
+
+        std::vector<VehicleState> vehicles;
+
+        std::vector<Event> children, sent;
+
+        std::vector<LogEntry> log;
+    };
+
+    /**
+     * Function for executing an event and saving the state it changes
+     *
+     * @param event, the event
+     */
+    void execute(const Event &event);
+
+    /**
+     * Function for undoing all executed events from an event and onwards
+     *
+     * @param event, the earliest event to undo
+     */
+    void rollback(const Event &event);
+
+    /**
+     * Function for undoing an executed event
+     *
+     * @param record, the record of the executed event
+     */
+    void undo(Record &record);
+
+    /**
+     * Function for handling a received message
+     *
+     * @param message, the message
+     */
+    void handle(const Message &message);
+
+    /**
+     * Function for returning a train whose arrival was cancelled, once its
+     * vehicles are restored to their state at the arrival
+     *
+     * @param arrival, the cancelled arrival
+     */
+    void returnTrain(const Event &arrival);
+
+    /**
+     * Function for discerning if an event touches a vehicle whose state is
+     * waiting for a train to return
+     *
+     * @param event, the event
+     * @return, a bool indicating if the event has to wait
+     */
+    bool isBlocked(const Event &event) const;
+
+    /**
+     * Function for restoring a vehicle to a saved state
+     *
+     * @param state, the saved state
+     */
+    static void restore(const VehicleState &state);
+
+// Private data members
+private:
+    // Struct representing a vehicle state restore waiting for a train
+    struct DeferredVehicle {
+        VehicleState state;
+        unsigned holder;    // the train the vehicle is waiting for
+        Event event;        // the undone event the state was saved before
+    };
+
+    TimeWarpSimulation *mParent;
+
+    Controller *mController;
+
+    unsigned mIndex;
+
+    std::set<Event, EventOrder> mPending;
+
+    std::deque<Record> mProcessed;
+
+    Record *mCurrent;
+
+    std::mutex mInboxMutex;
+
+    std::vector<Message> mInbox;
+
+    // Trains sent away whose state waits for them to be returned
+    std::set<unsigned> mAway;
+
+    std::map<unsigned, std::unique_ptr<Train>> mDeferredTrains;
+
+    std::map<Vehicle *, DeferredVehicle> mDeferredVehicles;
+
+    // Cancelled arrivals whose trains are waiting for their vehicles
+    std::vector<Event> mReturning;
+
+    std::vector<LogEntry> mCommittedLog;
+
+    Time mCommittedTime;
+
+    unsigned long mExecuted = 0, mCommitted = 0, mRolledBack = 0,
+                  mRollbacks = 0, mAntiMessages = 0;
+
+    // Executed events kept before the process waits for a GVT computation
+    static constexpr std::size_t MAX_RECORDS = 16384;
+};
+
+void TimeWarpSimulation::Process::scheduleEvent(const Event &event) {
+    // events produced while finishing are processed sequentially
+    if(mCurrent == nullptr) {
+        Simulation::scheduleEvent(event);
+        return;
+    }
+
+    unsigned target = mParent->getPartition(event);
+    if(target == mIndex) {
+        mPending.insert(event);
+        mCurrent->children.push_back(event);
+    } else {
+        mCurrent->sent.push_back(event);
+        mParent->send(target, { event, positive });
+    }
+}
+
+void TimeWarpSimulation::Process::receive(const Message &message) {
+    std::lock_guard<std::mutex> lock(mInboxMutex);
+    mInbox.push_back(message);
+}
+
+void TimeWarpSimulation::Process::drain() {
+    std::vector<Message> messages;
+    {
+        std::lock_guard<std::mutex> lock(mInboxMutex);
+        messages.swap(mInbox);
+    }
+
+    for(const Message &message : messages) {
+        handle(message);
+    }
+}
+
+bool TimeWarpSimulation::Process::step(const int &endTime) {
+    if(mPending.empty() || mProcessed.size() >= MAX_RECORDS) {
+        return false;
+    }
+
+    // wait for trains and vehicles that are on their way back
+    Event next = *mPending.begin();
+    if(next.time >= endTime || mAway.count(next.train) > 0 ||
+       isBlocked(next)) {
+        return false;
+    }
+
+    mPending.erase(mPending.begin());
+    execute(next);
+    return true;
+}
+
+void TimeWarpSimulation::Process::commit(const Event &gvt, const bool &all) {
+    while(!mProcessed.empty() && (all || before(mProcessed.front().event, gvt))) {
+        Record &record = mProcessed.front();
+        std::move(record.log.begin(), record.log.end(),
+                  std::back_inserter(mCommittedLog));
+        mCommittedTime = record.event.getTime();
+
+        // count the events it scheduled on the day they were scheduled
+        setTime(mCommittedTime);
+        std::size_t scheduled = record.children.size() + record.sent.size();
+        for(std::size_t i = 0; i < scheduled; ++i) {
+            countEvent(0);
+        }
+
+        mProcessed.pop_front();
+        ++mCommitted;
+    }
+}
+
+void TimeWarpSimulation::Process::finish() {
+    // continue from the last committed event
+    if(mCommitted > 0) {
+        setTime(mCommittedTime);
+    }
+
+    for(const Event &event : mPending) {
+        queueEvent(event);
+    }
+    mPending.clear();
+
+    // ensure all departed trains are arrived and disassembled
+    finishRunningTrains();
+
+    std::vector<LogEntry> &captured = getCapturedLog();
+    std::move(captured.begin(), captured.end(),
+              std::back_inserter(mCommittedLog));
+    captured.clear();
+}
+
+void TimeWarpSimulation::Process::execute(const Event &event) {
+    Train *train = mController->getTrain(event.train);
+    mProcessed.emplace_back(event, *train);
+    Record &record = mProcessed.back();
+
+    // save the station pool and the vehicles the event can move
+    if(event.type == EventType::assembly) {
+        record.station = train->getOrigin();
+        record.pool = record.station->getVehicles();
+        for(Vehicle *vehicle : record.pool) {
+            record.vehicles.push_back({ vehicle, vehicle->getHistorySize(),
+                                        vehicle->getLoggedHistory(),
+                                        vehicle->getStation(),
+                                        vehicle->getTrain() });
+        }
+
+        // a train that failed assembly keeps the vehicles it found, and
+        // logging it again moves their log cursors
+        if(mController->isLoggingNewHistory()) {
+            for(Vehicle *vehicle : train->getVehicles()) {
+                record.vehicles.push_back({ vehicle,
+                                            vehicle->getHistorySize(),
+                                            vehicle->getLoggedHistory(),
+                                            vehicle->getStation(),
+                                            vehicle->getTrain() });
+            }
+        }
+    } else if(event.type == EventType::disassembly) {
+        record.station = train->getDestination();
+        record.pool = record.station->getVehicles();
+        for(Vehicle *vehicle : train->getVehicles()) {
+            record.vehicles.push_back({ vehicle, vehicle->getHistorySize(),
+                                        vehicle->getLoggedHistory(),
+                                        vehicle->getStation(),
+                                        vehicle->getTrain() });
+        }
+    } else if(mController->isLoggingNewHistory()) {
+        // logging the event moves the log cursors of the train's vehicles
+        for(Vehicle *vehicle : train->getVehicles()) {
+            record.vehicles.push_back({ vehicle, vehicle->getHistorySize(),
+                                        vehicle->getLoggedHistory(),
+                                        vehicle->getStation(),
+                                        vehicle->getTrain() });
+        }
+    }
+
+    // process the event through the sequential simulation
+    mCurrent = &record;
+    queueEvent(event);
+    processNextEvent();
+    mCurrent = nullptr;
+
+    // only keep the vehicles assembly took from the pool
+    if(event.type == EventType::assembly) {
+        Station *station = record.station;
+        record.vehicles.erase(std::remove_if(record.vehicles.begin(),
+                                             record.vehicles.end(),
+                                             [station](const VehicleState &s) {
+                                                 return s.vehicle->getStation()
+                                                        == station;
+                                             }),
+                              record.vehicles.end());
+    }
+
+    record.log.swap(getCapturedLog());
+    ++mExecuted;
+}
+
+void TimeWarpSimulation::Process::rollback(const Event &event) {
+    ++mRollbacks;
+    while(!mProcessed.empty() && !before(mProcessed.back().event, event)) {
+        undo(mProcessed.back());
+        mProcessed.pop_back();
+    }
+}
+
+void TimeWarpSimulation::Process::undo(Record &record) {
+    // withdraw the events produced by the event
+    for(const Event &child : record.children) {
+        mPending.erase(child);
+    }
+    for(const Event &sent : record.sent) {
+        mParent->send(mParent->getPartition(sent), { sent, negative });
+        mAway.insert(sent.train);
+        ++mAntiMessages;
+    }
+
+    // restore the train, unless it is with another process
+    unsigned index = record.event.train;
+    bool away = mAway.count(index) > 0;
+    if(away) {
+        mDeferredTrains[index] = std::make_unique<Train>(record.train);
+    } else {
+        *mController->getTrain(index) = record.train;
+    }
+
+    if(record.station != nullptr) {
+        record.station->setVehicles(record.pool);
+    }
+
+    // vehicles travelling with a train are restored when it returns
+    for(const VehicleState &state : record.vehicles) {
+        auto it = mDeferredVehicles.find(state.vehicle);
+        if(it != mDeferredVehicles.end()) {
+            it->second.state = state;
+            it->second.event = record.event;
+        } else if(away) {
+            mDeferredVehicles.insert({ state.vehicle,
+                                       { state, index, record.event } });
+        } else {
+            restore(state);
+        }
+    }
+
+    mPending.insert(record.event);
+    uncountProcessed();
+    ++mRolledBack;
+}
+
+void TimeWarpSimulation::Process::handle(const Message &message) {
+    const Event &event = message.event;
+
+    switch(message.type) {
+        case positive:
+            // an arrival in the past of the process is a straggler
+            if(!mProcessed.empty() &&
+               before(event, mProcessed.back().event)) {
+                rollback(event);
+            }
+            mPending.insert(event);
+            break;
+        case negative:
+            // annihilate the cancelled arrival, undoing it if executed
+            if(mPending.erase(event) == 0) {
+                rollback(event);
+                mPending.erase(event);
+            }
+            returnTrain(event);
+            break;
+        case returned: {
+            unsigned index = event.train;
+            auto train = mDeferredTrains.find(index);
+            if(train != mDeferredTrains.end()) {
+                *mController->getTrain(index) = *train->second;
+                mDeferredTrains.erase(train);
+            }
+
+            for(auto it = mDeferredVehicles.begin();
+                it != mDeferredVehicles.end();) {
+                if(it->second.holder == index) {
+                    restore(it->second.state);
+                    it = mDeferredVehicles.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+            mAway.erase(index);
+
+            // trains waiting for these vehicles can be returned now
+            std::vector<Event> returning;
+            returning.swap(mReturning);
+            for(const Event &arrival : returning) {
+                returnTrain(arrival);
+            }
+            break;
+        }
+    }
+}
+
+void TimeWarpSimulation::Process::returnTrain(const Event &arrival) {
+    // restores saved before older events are applied later, when the trains
+    // they wait for are returned in turn, and so are the restores the
+    // arrival itself saved
+    Train *train = mController->getTrain(arrival.train);
+    for(Vehicle *vehicle : train->getVehicles()) {
+        auto it = mDeferredVehicles.find(vehicle);
+        if(it != mDeferredVehicles.end() &&
+           !before(it->second.event, arrival)) {
+            mReturning.push_back(arrival);
+            return;
+        }
+    }
+
+    mParent->send(mParent->mOrigins[arrival.train], { arrival, returned });
+}
+
+bool TimeWarpSimulation::Process::isBlocked(const Event &event) const {
+    if(mDeferredVehicles.empty()) {
+        return false;
+    }
+
+    // assembly takes vehicles from the pool, other events use the train's
+    Train *train = mController->getTrain(event.train);
+    std::vector<Vehicle *> vehicles = event.type == EventType::assembly
+                                      ? train->getOrigin()->getVehicles()
+                                      : train->getVehicles();
+    for(Vehicle *vehicle : vehicles) {
+        if(mDeferredVehicles.count(vehicle) > 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void TimeWarpSimulation::Process::restore(const VehicleState &state) {
+    state.vehicle->truncateHistory(state.history);
+    state.vehicle->setLoggedHistory(state.logged);
+    state.vehicle->setStation(state.station);
+    state.vehicle->setTrain(state.train);
+}
+
+TimeWarpSimulation::TimeWarpSimulation(Simulation *sim, Controller *controller,
+                                       const unsigned &threads):
+                                                        mSim(sim),
+                                                        mController(controller),
+                                                        mEndTime(0),
+                                                        mFinished(false),
+                                                        mHasGvt(false),
+                                                        mGvtRequested(false),
+                                                        mIdle(0),
+                                                        mSent(0),
+                                                        mSinceGvt(0),
+                                                        mWaiting(0),
+                                                        mGeneration(0),
+                                                        mExecuted(0),
+                                                        mCommitted(0),
+                                                        mRolledBack(0),
+                                                        mRollbacks(0),
+                                                        mAntiMessages(0),
+                                                        mGvtRounds(0) {
+    unsigned processes = ParallelSimulation::assignStations(controller,
+                                                            threads, mOrigins,
+                                                            mDestinations);
+
+    for(unsigned index = 0; index < processes; ++index) {
+        mProcesses.push_back(std::make_unique<Process>(this, controller,
+                                                       index));
+    }
+}
+
+TimeWarpSimulation::~TimeWarpSimulation() = default;
+
+void TimeWarpSimulation::run(const Time &endTime) {
+    mEndTime = endTime.getTotalTime();
+    mFinished = false;
+    mGvtRequested = false;
+    mIdle = 0;
+    mSent = 0;
+    mSinceGvt = 0;
+    mGvtRounds = 0;
+
+    // waiting trains are not saved with the events, so every retry is an
+    // event that can be rolled back
+    bool waitForVehicles = mController->isWaitingForVehicles();
+    mController->setWaitForVehicles(false);
+
+    // nor are the plan cursors, and the vehicles kept for a plan depend on
+    // trains at other stations, so the plan is not followed
+    bool followPlan = mController->isFollowingPlan();
+    mController->setFollowPlan(false);
+
+    // move the scheduled events to the processes of their stations
+    for(const std::unique_ptr<Process> &process : mProcesses) {
+        process->setTime(mSim->getTime());
+    }
+    for(const Event &event : mSim->takeEvents()) {
+        mProcesses[getPartition(event)]->adoptEvent(event);
+    }
+
+    // the calling thread executes the first process
+    std::vector<std::thread> workers;
+    for(unsigned index = 1; index < mProcesses.size(); ++index) {
+        workers.emplace_back(&TimeWarpSimulation::work, this, index);
+    }
+    work(0);
+    for(std::thread &worker : workers) {
+        worker.join();
+    }
+
+    // collect the metrics, the simulation ends at the last committed event
+    mExecuted = mCommitted = mRolledBack = mRollbacks = mAntiMessages = 0;
+    Time lastTime = mSim->getTime();
+    for(const std::unique_ptr<Process> &process : mProcesses) {
+        mExecuted += process->getExecuted();
+        mCommitted += process->getCommitted();
+        mRolledBack += process->getRolledBack();
+        mRollbacks += process->getRollbacks();
+        mAntiMessages += process->getAntiMessages();
+
+        if(lastTime < process->getTime()) {
+            lastTime = process->getTime();
+        }
+        mSim->addCounters(*process);
+    }
+    mSim->setTime(lastTime);
+    mController->setWaitForVehicles(waitForVehicles);
+    mController->setFollowPlan(followPlan);
+}
+
+double TimeWarpSimulation::getRollbackRate() const {
+    return mExecuted == 0 ? 0 : static_cast<double>(mRolledBack) / mExecuted;
+}
+
+double TimeWarpSimulation::getEfficiency() const {
+    return mExecuted == 0 ? 1 : static_cast<double>(mCommitted) / mExecuted;
+}
+
+unsigned TimeWarpSimulation::getPartition(const Event &event) const {
+    // events up to departure belong to the origin station
+    if(event.type < EventType::arrival) {
+        return mOrigins[event.train];
+    }
+    return mDestinations[event.train];
+}
+
+void TimeWarpSimulation::send(const unsigned &target,
+                              const Message &message) {
+    mProcesses[target]->receive(message);
+    ++mSent;
+}
+
+void TimeWarpSimulation::work(const unsigned &index) {
+    Process &process = *mProcesses[index];
+    bool idle = false;
+
+    while(true) {
+        process.drain();
+
+        if(mGvtRequested) {
+            idle = false;
+            if(computeGvt(index)) {
+                break;
+            }
+            continue;
+        }
+
+        if(process.step(mEndTime)) {
+            if(idle) {
+                idle = false;
+                --mIdle;
+            }
+            if(++mSinceGvt >= GVT_INTERVAL) {
+                mGvtRequested = true;
+            }
+        } else {
+            // when every process is waiting only the GVT can tell why
+            if(!idle) {
+                idle = true;
+                if(++mIdle == mProcesses.size()) {
+                    mGvtRequested = true;
+                }
+            }
+            std::this_thread::yield();
+        }
+    }
+
+    process.finish();
+    synchronize();
+
+    if(index == 0) {
+        writeLogs();
+    }
+}
+
+bool TimeWarpSimulation::computeGvt(const unsigned &index) {
+    Process &process = *mProcesses[index];
+    synchronize();
+
+    // handle messages until none are in transit
+    bool quiet;
+    do {
+        process.drain();
+        synchronize();
+        quiet = mSent == 0;
+        synchronize();
+        if(index == 0) {
+            mSent = 0;
+        }
+        synchronize();
+    } while(!quiet);
+
+    // the GVT is the earliest pending event in any process
+    if(index == 0) {
+        mHasGvt = false;
+        for(const std::unique_ptr<Process> &other : mProcesses) {
+            if(other->hasPending() &&
+               (!mHasGvt || before(other->getNext(), mGvt))) {
+                mGvt = other->getNext();
+                mHasGvt = true;
+            }
+        }
+        mFinished = !mHasGvt || mGvt.time >= mEndTime;
+
+        mGvtRequested = false;
+        mIdle = 0;
+        mSinceGvt = 0;
+        ++mGvtRounds;
+    }
+    synchronize();
+
+    process.commit(mGvt, !mHasGvt);
+    synchronize();
+
+    if(index == 0) {
+        writeLogs();
+    }
+    synchronize();
+
+    return mFinished;
+}
+
+void TimeWarpSimulation::synchronize() {
+    std::unique_lock<std::mutex> lock(mMutex);
+    unsigned generation = mGeneration;
+
+    // the last thread to arrive releases the others
+    if(++mWaiting == mProcesses.size()) {
+        mWaiting = 0;
+        ++mGeneration;
+        mCondition.notify_all();
+    } else {
+        mCondition.wait(lock, [this, generation] {
+            return generation != mGeneration;
+        });
+    }
+}
+
+void TimeWarpSimulation::writeLogs() {
+    std::vector<LogEntry> entries;
+    for(const std::unique_ptr<Process> &process : mProcesses) {
+        std::vector<LogEntry> &committed = process->getCommittedLog();
+        std::move(committed.begin(), committed.end(),
+                  std::back_inserter(entries));
+        committed.clear();
+    }
+
+    // every event has a unique time and train number, sort entries by event
+    std::stable_sort(entries.begin(), entries.end(),
+                     [](const LogEntry &left, const LogEntry &right) {
+                         return left.time < right.time ||
+                                (left.time == right.time &&
+                                 left.trainNumber < right.trainNumber);
+                     });
+
+    for(LogEntry &entry : entries) {
+        if(entry.record) {
+            mController->writeRecord(mSim, std::move(entry.text));
+        } else {
+            mController->writeLog(mSim, std::move(entry.text));
+        }
+    }
+}
@@ -7,11 +7,15 @@
 #include "Train.h"
 #include "Vehicle.h"
 #include "Station.h"
+#include "BinaryIO.h"
 
 #include <string>
 #include <memory>
 #include <vector>
+#include <istream>
 #include <ostream>
+#include <stdexcept>
+#include <cstdint>
 #include <algorithm>
 
 void Train::addDelay(const Time &delay) {
@@ -46,6 +50,49 @@ bool Train::detachVehicle(Vehicle **vehicle) {
     }
 }
 
+void Train::writeState(std::ostream &os) const {
+    writeBinary(os, mTopSpeed);
+    writeBinary(os, mSpeed);
+    writeBinaryVector(os, mRequiredVehicles);
+    std::vector<std::uint32_t> rows;
+    rows.reserve(mVehicles.size());
+    for(const Vehicle *vehicle : mVehicles) {
+        rows.push_back(static_cast<std::uint32_t>(vehicle->getTableRow()));
+    }
+    writeBinaryVector(os, rows);
+    for(const Time &time : { mCurrentDeparture, mCurrentArrival, mDelay,
+                             mDepartureDelay }) {
+        writeBinary(os, time.getTotalTime());
+    }
+    writeBinaryString(os, mStatus);
+    writeBinary(os, static_cast<std::uint8_t>(mIgnore));
+}
+
+void Train::readState(std::istream &is,
+                      const std::vector<std::unique_ptr<Vehicle>> &vehicles) {
+    readBinary(is, mTopSpeed);
+    readBinary(is, mSpeed);
+    readBinaryVector(is, mRequiredVehicles);
+    std::vector<std::uint32_t> rows;
+    readBinaryVector(is, rows);
+    mVehicles.clear();
+    for(const std::uint32_t &row : rows) {
+        if(row >= vehicles.size()) {
+            throw std::runtime_error("checkpoint refers to unknown vehicle");
+        }
+        vehicles[row]->setTrain(this);
+        mVehicles.push_back(vehicles[row].get());
+    }
+    for(Time *time : { &mCurrentDeparture, &mCurrentArrival, &mDelay,
+                       &mDepartureDelay }) {
+        *time = Time::fromMinutes(readBinaryMinutes(is));
+    }
+    std::uint8_t ignore;
+    readBinaryString(is, mStatus);
+    readBinary(is, ignore);
+    mIgnore = ignore != 0;
+}
+
 std::ostream &operator<<(std::ostream &os, const Train *const train) {
     os << "Train " << train->getTrainNumber()
        << " (" << train->getStatus() << ") from " 
@@ -8,12 +8,22 @@
 #include "MyTime.h"
 #include "Simulation.h"
 #include "Controller.h"
+#include "ParallelSimulation.h"
+#include "TimeWarpSimulation.h"
+#include "Scenario.h"
+#include "Ensemble.h"
 
 #include <iostream>
 #include <string>
 #include <exception>
 #include <stdexcept>
 #include <memory>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <utility>
+#include <thread>
+#include <cctype>
 
 int UserInterface::getMenuOption(int numberOfOptions) {
     std::string userInput;
@@ -56,10 +66,15 @@ void UserInterface::runStartMenu() {
                   << "2. Change end time [" << mEndTime.getFormattedTime()
                   << "]" << std::endl
                   << "3. Start simulation" << std::endl
+                  << "4. Change worker threads [" << mThreads << "]"
+                  << std::endl
+                  << "5. Change parallel mode ["
+                  << (mOptimistic ? "Optimistic" : "Conservative") << "]"
+                  << std::endl
                   << "0. Exit" << std::endl;
 
         // perform chosen action
-        switch(getMenuOption(3)) {
+        switch(getMenuOption(5)) {
             case 1:
                 std::cout << "Changing start time" << std::endl;
                 mStartTime = changeTimeSetting();
@@ -83,12 +98,407 @@ void UserInterface::runStartMenu() {
                 runSimulationMenu();
                 done = true;
                 break;
+            case 4:
+                changeThreads();
+                break;
+            case 5:
+                mOptimistic = !mOptimistic;
+                break;
             case 0:
                 done = true;
         }
     }
 }
 
+int UserInterface::runBatch(const std::vector<std::string> &arguments) {
+    OutputFormat format = OutputFormat::text;
+    mBatch = true;
+    mLogLevel = off;
+
+    // read the options, each takes a value
+    for(std::size_t i = 0; i < arguments.size(); i += 2) {
+        const std::string &option = arguments[i];
+        if(option == "--help" || i + 1 >= arguments.size()) {
+            printUsage();
+            return 2;
+        }
+        const std::string &value = arguments[i + 1];
+
+        bool valid = true;
+        if(option == "--start") {
+            valid = parseTime(value, mStartTime);
+        } else if(option == "--end") {
+            valid = parseTime(value, mEndTime);
+        } else if(option == "--log") {
+            if(value == "off") {
+                mLogLevel = off;
+            } else if(value == "low") {
+                mLogLevel = low;
+            } else if(value == "high") {
+                mLogLevel = high;
+            } else {
+                valid = false;
+            }
+        } else if(option == "--history") {
+            if(value == "full") {
+                mHistoryDetail = HistoryDetail::full;
+            } else if(value == "incremental") {
+                mHistoryDetail = HistoryDetail::incremental;
+            } else {
+                valid = false;
+            }
+        } else if(option == "--plan") {
+            if(value == "on") {
+                mFollowPlan = true;
+            } else if(value == "off") {
+                mFollowPlan = false;
+            } else {
+                valid = false;
+            }
+        } else if(option == "--shortages") {
+            if(value == "on") {
+                mShortages = true;
+            } else if(value == "off") {
+                mShortages = false;
+            } else {
+                valid = false;
+            }
+        } else if(option == "--sink") {
+            if(value == "console") {
+                mLogSink = LogSink::console;
+            } else if(value == "file") {
+                mLogSink = LogSink::file;
+            } else if(value == "both") {
+                mLogSink = LogSink::both;
+            } else if(value == "none") {
+                mLogSink = LogSink::none;
+            } else {
+                valid = false;
+            }
+        } else if(option == "--records") {
+            mRecordPath = value;
+        } else if(option == "--record-format") {
+            if(value == "jsonl") {
+                mRecordFormat = RecordFormat::jsonl;
+            } else if(value == "csv") {
+                mRecordFormat = RecordFormat::csv;
+            } else {
+                valid = false;
+            }
+        } else if(option == "--checkpoint") {
+            mCheckpointPath = value;
+        } else if(option == "--checkpoint-every") {
+            valid = parseTime(value, mCheckpointInterval) &&
+                    mCheckpointInterval > Time(0, 0);
+        } else if(option == "--resume") {
+            mResumePath = value;
+        } else if(option == "--data") {
+            mDirectory = value;
+            // allow the directory to be given without trailing separator
+            if(!mDirectory.empty() && mDirectory.back() != '/') {
+                mDirectory += '/';
+            }
+        } else if(option == "--threads") {
+            try {
+                int threads = std::stoi(value);
+                valid = threads >= 1 && threads <= MAX_THREADS;
+                mThreads = valid ? threads : mThreads;
+            } catch(const std::exception &) {
+                valid = false;
+            }
+        } else if(option == "--mode") {
+            valid = value == "conservative" || value == "optimistic";
+            mOptimistic = value == "optimistic";
+        } else if(option == "--queue") {
+            if(value == "binary") {
+                mQueueType = binaryHeap;
+            } else if(value == "quaternary") {
+                mQueueType = quaternaryHeap;
+            } else if(value == "calendar") {
+                mQueueType = calendar;
+            } else {
+                valid = false;
+            }
+        } else if(option == "--format") {
+            if(value == "text") {
+                format = OutputFormat::text;
+            } else if(value == "json") {
+                format = OutputFormat::json;
+            } else if(value == "csv") {
+                format = OutputFormat::csv;
+            } else {
+                valid = false;
+            }
+        } else {
+            valid = false;
+        }
+
+        if(!valid) {
+            std::cerr << "Invalid option: " << option << " " << value
+                      << std::endl;
+            printUsage();
+            return 2;
+        }
+    }
+    if(mStartTime > mEndTime) {
+        std::cerr << "Start time can not be after end time" << std::endl;
+        return 2;
+    }
+    if(mFollowPlan && mOptimistic && mThreads > 1) {
+        std::cerr << "The vehicle plan is not followed in optimistic mode"
+                  << std::endl;
+        return 2;
+    }
+    if(!mCheckpointPath.empty() && mThreads > 1) {
+        std::cerr << "Checkpoints are only written with one thread"
+                  << std::endl;
+        return 2;
+    }
+
+    using Clock = std::chrono::steady_clock;
+    Clock::time_point start = Clock::now();
+    if(!performSetup()) {
+        return 1;
+    }
+    Clock::time_point setupDone = Clock::now();
+    unsigned long setupEvents = mSim->getEventsProcessed();
+
+    completeSimulation();
+    mController->closeRecords();
+    Clock::time_point simulationDone = Clock::now();
+
+    // the text format keeps the statistics of the interactive menu
+    if(format == OutputFormat::text) {
+        printStatistics();
+    }
+    TrainStatistics statistics = mController->getStatistics(mEndTime);
+
+    double setupSeconds = std::chrono::duration<double>(
+                                            setupDone - start).count();
+    double simulationSeconds = std::chrono::duration<double>(
+                                            simulationDone - setupDone).count();
+    unsigned long events = mSim->getEventsProcessed() - setupEvents;
+    double eventRate = simulationSeconds > 0 ? events / simulationSeconds : 0;
+    std::string mode = mThreads == 1 ? "sequential"
+                     : mOptimistic ? "optimistic" : "conservative";
+
+    // print the summary as name and value pairs in the chosen format
+    std::vector<std::pair<std::string, std::string>> summary = {
+        { "start", mStartTime.getFormattedTime() },
+        { "end", mEndTime.getFormattedTime() },
+        { "mode", mode },
+        { "threads", std::to_string(mThreads) },
+        { "trains_on_time", std::to_string(statistics.onTime) },
+        { "trains_delayed", std::to_string(statistics.delayed) },
+        { "trains_failed", std::to_string(statistics.failed) },
+        { "departure_delay_minutes",
+          std::to_string(statistics.departureDelay.getTotalTime()) },
+        { "arrival_delay_minutes",
+          std::to_string(statistics.arrivalDelay.getTotalTime()) },
+        { "events", std::to_string(events) },
+        { "distance_table_bytes",
+          std::to_string(mController->getDistanceTable().getMemoryUsage()) },
+        { "setup_seconds", std::to_string(setupSeconds) },
+        { "simulation_seconds", std::to_string(simulationSeconds) },
+        { "events_per_second", std::to_string(eventRate) }
+    };
+
+    switch(format) {
+        case OutputFormat::text:
+            std::cout << std::endl << "Summary:" << std::endl;
+            for(const auto &entry : summary) {
+                std::cout << entry.first << ": " << entry.second << std::endl;
+            }
+            break;
+        case OutputFormat::json:
+            std::cout << "{";
+            for(std::size_t i = 0; i < summary.size(); ++i) {
+                // only the times and the mode are strings
+                bool quoted = i < 3;
+                std::cout << (i > 0 ? ", " : "") << "\"" << summary[i].first
+                          << "\": " << (quoted ? "\"" : "")
+                          << summary[i].second << (quoted ? "\"" : "");
+            }
+            std::cout << "}" << std::endl;
+            break;
+        case OutputFormat::csv:
+            for(std::size_t i = 0; i < summary.size(); ++i) {
+                std::cout << (i > 0 ? "," : "") << summary[i].first;
+            }
+            std::cout << std::endl;
+            for(std::size_t i = 0; i < summary.size(); ++i) {
+                std::cout << (i > 0 ? "," : "") << summary[i].second;
+            }
+            std::cout << std::endl;
+            break;
+    }
+    return 0;
+}
+
+int UserInterface::runEnsemble(const std::vector<std::string> &arguments) {
+    unsigned long long replicas = 100, seed = 1, maxDelay = 30;
+
+    // default to the hardware threads, which may not be known
+    unsigned long long threads = std::thread::hardware_concurrency();
+    threads = std::max<unsigned long long>(threads, 1);
+    threads = std::min<unsigned long long>(threads, MAX_THREADS);
+    double probability = 0.2;
+    Time endTime(23, 59);
+    std::string directory = "../resources/Project/";
+
+    // read the options, each takes a value
+    for(std::size_t i = 0; i < arguments.size(); i += 2) {
+        const std::string &option = arguments[i];
+        if(option == "--help" || i + 1 >= arguments.size()) {
+            printEnsembleUsage();
+            return 2;
+        }
+        const std::string &value = arguments[i + 1];
+
+        bool valid = true;
+        if(option == "--replicas") {
+            valid = parseNumber(value, replicas) && replicas >= 1 &&
+                    replicas <= MAX_REPLICAS;
+        } else if(option == "--threads") {
+            valid = parseNumber(value, threads) && threads >= 1 &&
+                    threads <= MAX_THREADS;
+        } else if(option == "--seed") {
+            valid = parseNumber(value, seed);
+        } else if(option == "--probability") {
+            try {
+                std::size_t end;
+                probability = std::stod(value, &end);
+                valid = end == value.size() && probability >= 0 &&
+                        probability <= 1;
+            } catch(const std::exception &) {
+                valid = false;
+            }
+        } else if(option == "--max-delay") {
+            valid = parseNumber(value, maxDelay) &&
+                    maxDelay <= static_cast<unsigned long long>(
+                                                    Time::MINUTES_PER_DAY);
+        } else if(option == "--end") {
+            valid = parseTime(value, endTime);
+        } else if(option == "--data") {
+            directory = value;
+            // allow the directory to be given without trailing separator
+            if(!directory.empty() && directory.back() != '/') {
+                directory += '/';
+            }
+        } else {
+            valid = false;
+        }
+
+        if(!valid) {
+            std::cerr << "Invalid option: " << option << " " << value
+                      << std::endl;
+            printEnsembleUsage();
+            return 2;
+        }
+    }
+
+    try {
+        Scenario scenario(directory);
+        Ensemble ensemble(scenario, probability, static_cast<int>(maxDelay));
+        ensemble.run(static_cast<unsigned>(replicas),
+                     static_cast<unsigned>(threads), seed, endTime);
+        ensemble.printResults();
+    } catch(std::exception &e) {
+        std::cout << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+bool UserInterface::parseTime(const std::string &str, Time &time) {
+    std::size_t colon = str.find(':');
+    if(colon == std::string::npos) {
+        return false;
+    }
+
+    // convert hours and minutes and confirm validity
+    try {
+        std::size_t hourEnd, minuteEnd;
+        int hours = std::stoi(str.substr(0, colon), &hourEnd);
+        int minutes = std::stoi(str.substr(colon + 1), &minuteEnd);
+        if(hourEnd != colon || minuteEnd != str.size() - colon - 1 ||
+           hours < 0 || hours > 23 || minutes < 0 || minutes > 59) {
+            return false;
+        }
+        time = Time(hours, minutes);
+    } catch(const std::exception &) {
+        return false;
+    }
+    return true;
+}
+
+bool UserInterface::parseNumber(const std::string &str,
+                                unsigned long long &value) {
+    // stoull would take a sign and wrap a negative number around
+    if(str.empty() || !std::isdigit(static_cast<unsigned char>(str[0]))) {
+        return false;
+    }
+    try {
+        std::size_t end;
+        value = std::stoull(str, &end);
+        return end == str.size();
+    } catch(const std::exception &) {
+        return false;
+    }
+}
+
+void UserInterface::printEnsembleUsage() {
+    std::cerr << "Usage: Project-Project --ensemble [options]" << std::endl
+              << "  --replicas N         replicas to run (1-" << MAX_REPLICAS
+              << ") [100]" << std::endl
+              << "  --threads N          worker threads (1-" << MAX_THREADS
+              << ") [hardware threads]" << std::endl
+              << "  --seed N             seed of the first replica [1]"
+              << std::endl
+              << "  --probability P      chance a train is delayed (0-1) "
+              << "[0.2]" << std::endl
+              << "  --max-delay MINUTES  longest random delay [30]"
+              << std::endl
+              << "  --end HH:MM          end time [23:59]" << std::endl
+              << "  --data DIR           data directory "
+              << "[../resources/Project/]" << std::endl;
+}
+
+void UserInterface::printUsage() {
+    std::cerr << "Usage: Project-Project --batch [options]" << std::endl
+              << "  --start HH:MM        start time [00:00]" << std::endl
+              << "  --end HH:MM          end time [23:59]" << std::endl
+              << "  --log off|low|high   log level [off]" << std::endl
+              << "  --history full|incremental  vehicle history at level high "
+              << "[full]" << std::endl
+              << "  --sink console|file|both|none  log destination [both]"
+              << std::endl
+              << "  --plan on|off        assemble trains by the vehicle plan "
+              << "[off]" << std::endl
+              << "  --shortages on|off   print predicted vehicle shortages "
+              << "[off]" << std::endl
+              << "  --records FILE       write a record of every train event"
+              << std::endl
+              << "  --record-format jsonl|csv  record format [jsonl]"
+              << std::endl
+              << "  --checkpoint FILE    write checkpoints to resume the run "
+              << "from" << std::endl
+              << "  --checkpoint-every HH:MM  simulated time between "
+              << "checkpoints [01:00]" << std::endl
+              << "  --resume FILE        continue the run of a checkpoint"
+              << std::endl
+              << "  --data DIR           data and log directory "
+              << "[../resources/Project/]" << std::endl
+              << "  --threads N          worker threads (1-" << MAX_THREADS
+              << ") [1]" << std::endl
+              << "  --mode conservative|optimistic  parallel mode "
+              << "[conservative]" << std::endl
+              << "  --queue binary|quaternary|calendar  event queue [binary]"
+              << std::endl
+              << "  --format text|json|csv  summary format [text]"
+              << std::endl;
+}
+
 void UserInterface::runSimulationMenu() {
     bool done = false;
 
@@ -118,9 +528,12 @@ void UserInterface::runSimulationMenu() {
                   << "6. Train menu" << std::endl
                   << "7. Station menu" << std::endl
                   << "8. Vehicle menu" << std::endl
+                  << "9. Save snapshot [" << mSnapshots.size() << " saved]"
+                  << std::endl
+                  << "10. Restore snapshot" << std::endl
                   << "0. Exit" << std::endl;
 
-        switch(getMenuOption(8)) {
+        switch(getMenuOption(10)) {
             case 1:
                 std::cout << "Changing interval" << std::endl;
                 mInterval = changeTimeSetting();
@@ -148,6 +561,12 @@ void UserInterface::runSimulationMenu() {
             case 8:
                 runVehicleMenu();
                 break;
+            case 9:
+                saveSnapshot();
+                break;
+            case 10:
+                restoreSnapshot();
+                break;
             case 0:
                 done = true;
         }
@@ -277,12 +696,12 @@ void UserInterface::runVehicleMenu() {
 
 bool UserInterface::performSetup() {
     // unique_ptrs to manage the simulation objects
-    mSim = std::make_unique<Simulation>();
+    mSim = std::make_unique<Simulation>(mQueueType);
 
     // try block for all operations that require a file to open
     try {
         // allocate a new controller object
-        mController = std::make_unique<Controller>(mSim.get());
+        mController = std::make_unique<Controller>(mSim.get(), mDirectory);
 
         // attempt to load the data from file
         mController->loadStations();
@@ -294,22 +713,58 @@ bool UserInterface::performSetup() {
         return false;
     }
 
-    // have the controller schedule initial assembly events for all trains
-    mController->scheduleAssemblyEvents();
+    // predict the shortages from the timetable before any train runs
+    if(mShortages) {
+        mController->buildSupplyTimeline();
+        printShortages();
+    }
 
-    // run the sim quietly until the user defined start time
-    while(mSim->getNextEventTime() < mStartTime) {
-        mSim->processNextEvent();
+    // plan the vehicles of all trains before any is assembled
+    if(mFollowPlan) {
+        mController->planVehicles();
+        mController->setFollowPlan(true);
     }
 
-    // set ignore flag on departed train to prevent them from being logged
-    mController->ignoreDepartedTrains();
+    // continue a run from its checkpoint, which was written after the start
+    if(!mResumePath.empty()) {
+        try {
+            mController->loadCheckpoint(mResumePath);
+        } catch(std::runtime_error &re) {
+            std::cout << "Error: " << re.what() << std::endl;
+            return false;
+        }
+    } else {
+        // have the controller schedule initial assembly events for all
+        // trains
+        mController->scheduleAssemblyEvents();
+
+        // run the sim quietly until the user defined start time
+        while(mSim->getNextEventTime() < mStartTime) {
+            mSim->processNextEvent();
+        }
+
+        // settle the trains waiting for vehicles before they are looked at
+        mController->resumeRetries(mStartTime);
 
-    // set the sim time to the chosen start time
-    mSim->setTime(mStartTime);
+        // set ignore flag on departed train to prevent them from being
+        // logged
+        mController->ignoreDepartedTrains();
+
+        // set the sim time to the chosen start time
+        mSim->setTime(mStartTime);
+    }
 
-    // set the log level to low as default
-    mController->setLogLevel(low);
+    // set the log level, low unless chosen on the command line
+    mController->setLogLevel(mLogLevel);
+    mController->setHistoryDetail(mHistoryDetail);
+    mController->setLogSink(mLogSink);
+
+    // record the events from the start time on, like the log
+    if(!mRecordPath.empty() &&
+       !mController->openRecords(mRecordPath, mRecordFormat)) {
+        std::cout << "Error: record file failed to open" << std::endl;
+        return false;
+    }
 
     return true;
 }
@@ -347,6 +802,9 @@ void UserInterface::runInterval() {
    if(stopTime >= mEndTime) {
         mSim->finishRunningTrains();
     }
+
+    // let the log catch up before the menu is printed
+    mController->flushLog();
 }
 
 void UserInterface::runNextEvent() {
@@ -356,28 +814,118 @@ void UserInterface::runNextEvent() {
    if(mSim->getTime() >= mEndTime) {
         mSim->finishRunningTrains();
     }
+    mController->flushLog();
 }
 
 void UserInterface::completeSimulation() {
+    // divide the remaining events between the worker threads, which do not
+    // note their changes for snapshots
+    if(mThreads > 1) {
+        mController->stopTrackingChanges();
+    }
+    if(mThreads > 1 && mOptimistic) {
+        TimeWarpSimulation timeWarp(mSim.get(), mController.get(), mThreads);
+        timeWarp.run(mEndTime);
+        mController->resumeRetries(mEndTime);
+        mController->flushLog();
+        if(mBatch) {
+            return;
+        }
+
+        std::cout << std::endl << "Time warp: "
+                  << timeWarp.getEventsExecuted() << " events executed, "
+                  << timeWarp.getEventsRolledBack() << " rolled back in "
+                  << timeWarp.getRollbacks() << " rollbacks, "
+                  << timeWarp.getAntiMessages() << " anti-messages, "
+                  << "efficiency " << timeWarp.getEfficiency() * 100 << "%"
+                  << std::endl;
+        return;
+    } else if(mThreads > 1) {
+        ParallelSimulation parallel(mSim.get(), mController.get(), mThreads);
+        parallel.run(mEndTime);
+        mController->resumeRetries(mEndTime);
+        mController->flushLog();
+        return;
+    }
+
+    // write a checkpoint between the events of each interval, the run goes
+    // on while it is written
+    Time nextCheckpoint = mSim->getTime() + mCheckpointInterval;
     while(!mSim->done() && mSim->getNextEventTime() < mEndTime) {
+        if(!mCheckpointPath.empty() &&
+           mSim->getNextEventTime() >= nextCheckpoint) {
+            mController->saveCheckpoint(mCheckpointPath);
+            while(nextCheckpoint <= mSim->getNextEventTime()) {
+                nextCheckpoint += mCheckpointInterval;
+            }
+        }
         mSim->processNextEvent();
     }
     // ensure all departed trains are arrived and disassembled
     mSim->finishRunningTrains();
+    mController->resumeRetries(mEndTime);
+    mController->flushLog();
+
+    if(!mCheckpointPath.empty() && !mController->waitForCheckpoint()) {
+        std::cerr << "Error: " << mController->getCheckpointWriter()
+                                                        .getError()
+                  << std::endl;
+    }
+}
+
+void UserInterface::saveSnapshot() {
+    mSnapshots.push_back(mController->saveSnapshot());
+    std::cout << "Snapshot " << mSnapshots.size() << " saved at ["
+              << mSim->getTime() << "]" << std::endl;
+}
+
+void UserInterface::restoreSnapshot() {
+    if(mSnapshots.empty()) {
+        std::cout << "No snapshots saved." << std::endl;
+        return;
+    }
+
+    std::cout << "Restore snapshot" << std::endl;
+    for(std::size_t i = 0; i < mSnapshots.size(); ++i) {
+        std::cout << i + 1 << ". [" << mSnapshots[i].simulation.time << "]"
+                  << std::endl;
+    }
+    std::cout << "0. Return" << std::endl;
+
+    int choice = getMenuOption(static_cast<int>(mSnapshots.size()));
+    if(choice > 0) {
+        mController->restoreSnapshot(mSnapshots[choice - 1]);
+        std::cout << "Restored snapshot " << choice << ", current time: ["
+                  << mSim->getTime() << "]" << std::endl;
+    }
+}
+
+void UserInterface::changeThreads() {
+    std::cout << "Enter number of worker threads (1-" << MAX_THREADS << "):"
+              << std::endl;
+
+    // zero threads is treated as one
+    mThreads = std::max(1, getMenuOption(MAX_THREADS));
 }
 
 void UserInterface::changeLogLevel() {
     std::cout << "Change log level [" << mController->getLogLevelAsString()
               << "]" << std::endl
               << "1. Low" << std::endl << "2. High" << std::endl
+              << "3. High, new vehicle history only" << std::endl
               << "0. Return" << std::endl;
 
-    switch(getMenuOption(2)) {
+    switch(getMenuOption(3)) {
         case 1:
             mController->setLogLevel(low);
             break;
         case 2:
             mController->setLogLevel(high);
+            mController->setHistoryDetail(HistoryDetail::full);
+            break;
+        case 3:
+            mController->setLogLevel(high);
+            mController->setHistoryDetail(HistoryDetail::incremental);
             break;
         default:    // do nothing
             break;
@@ -386,6 +934,17 @@ void UserInterface::changeLogLevel() {
 
 void UserInterface::printStatistics() {
     mController->printStatistics(mEndTime);
+
+    // print how often the event queue had to allocate memory
+    const std::vector<unsigned long> &events = mSim->getEventsPerDay();
+    const std::vector<unsigned long> &allocations =
+                                                mSim->getAllocationsPerDay();
+    std::cout << std::endl << "Event queue allocations per day:" << std::endl;
+    for(std::size_t day = 0; day < events.size(); ++day) {
+        std::cout << "Day " << day << ": " << allocations[day]
+                  << " allocations for " << events[day] << " events"
+                  << std::endl;
+    }
 }
 
 void UserInterface::findTrainByNumber() {
@@ -406,9 +965,7 @@ void UserInterface::findTrainByNumber() {
                 std::cout << vehiclePtr->getInfo() << std::endl;
 
                 // print vehicle history
-                for(const std::string &event : vehiclePtr->getHistory()) {
-                    std::cout << event << std::endl;
-                }
+                vehiclePtr->writeHistory(std::cout);
             }
         }
     } else {
@@ -438,9 +995,7 @@ void UserInterface::findTrainByVehicleId() {
                     std::cout << vehiclePtr->getInfo() << std::endl;
 
                     // print vehicle history
-                    for(const std::string &event : vehiclePtr->getHistory()) {
-                        std::cout << event << std::endl;
-                    }
+                    vehiclePtr->writeHistory(std::cout);
                 }
             }
         } else {
@@ -458,6 +1013,32 @@ void UserInterface::printStationNames() {
     }
 }
 
+void UserInterface::printShortages() {
+    const SupplyTimeline &timeline = mController->getSupplyTimeline();
+    std::vector<std::string> names = mController->getStationNames();
+    unsigned shortages = 0;
+
+    std::cout << "Predicted shortages:" << std::endl;
+    for(unsigned station = 0; station < timeline.getNoOfStations();
+        ++station) {
+        for(int type = 0; type < Station::VEHICLE_TYPES; ++type) {
+            Time time;
+            if(!timeline.getEarliestShortage(station, type, time)) {
+                continue;
+            }
+            std::cout << names[station] << ", "
+                      << mController->getVehicleTypeNameByTypeNumber(type)
+                      << ": short from " << time << ", lowest "
+                      << timeline.getLowestInventory(station, type)
+                      << std::endl;
+            ++shortages;
+        }
+    }
+    if(shortages == 0) {
+        std::cout << "none" << std::endl;
+    }
+}
+
 void UserInterface::findStationByName() {
     std::string userInput;
     Station *station;
@@ -466,19 +1047,25 @@ void UserInterface::findStationByName() {
     std::getline(std::cin, userInput);
 
     if(mController->findStation(userInput, &station)) {
-        std::cout << station->getName() << std::endl << "Connected vehicles:"
+        // sum the pool from the vehicle table
+        FleetTotals pool = mController->getVehicleTable()
+                                    .getStationTotals(station->getId());
+        std::cout << station->getName() << std::endl << "Pool: "
+                  << pool.vehicles << " vehicles, " << pool.seats
+                  << " seats, " << pool.beds << " beds, "
+                  << pool.cargoCapacity << " tons, " << pool.cargoArea
+                  << " m2, " << pool.cargoVolume << " m3, " << pool.power
+                  << " kw" << std::endl << "Connected vehicles:"
                   << std::endl;
 
-        for(const Vehicle *vehiclePtr : station->getVehicles()) {
+        station->forEachVehicle([this](const Vehicle *vehiclePtr) {
             std::cout << vehiclePtr->getInfo() << std::endl;
 
             if(mController->getLogLevel() == high) {
                 // print vehicle history
-                for(const std::string &event : vehiclePtr->getHistory()) {
-                    std::cout << event << std::endl;
-                }
+                vehiclePtr->writeHistory(std::cout);
             }
-        }
+        });
     } else {
         std::cout << "Station not found, check name." << std::endl;
     }
@@ -505,9 +1092,7 @@ void UserInterface::findVehicleById() {
         // print entire history if high log level
         if(mController->getLogLevel() == high) {
             std::cout << "Full history: " << std::endl;
-            for(const std::string &event : vehicle->getHistory()) {
-                std::cout << event << std::endl;
-            }
+            vehicle->writeHistory(std::cout);
         }
     } else {
         std::cout << "Vehicle not found, check id." << std::endl;
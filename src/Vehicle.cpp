@@ -6,15 +6,53 @@
 
 #include "Vehicle.h"
 #include "MyTime.h"
+#include "HistoryJournal.h"
 
 #include <string>
 #include <sstream>
 #include <vector>
+#include <ostream>
+#include <algorithm>
 
-void Vehicle::addHistory(const std::string &event, const Time &time) {
-    // create a string with the timestamp and the event description
-    std::string tmpStr = time.getFormattedTime() + " " + event;
-    mHistory.push_back(tmpStr);     // add event to member vector
+void Vehicle::addHistory(const HistoryAction &action, const int &subject,
+                         const Time &time) {
+    if(mJournal) {
+        // chain a record for the event to the latest one
+        mLastRecord = mJournal->append(mLastRecord, action, subject, time);
+        ++mHistorySize;
+    }
+}
+
+std::vector<std::string> Vehicle::getHistory() const {
+    if(!mJournal) {
+        return std::vector<std::string>();
+    }
+    return mJournal->render(mLastRecord, mHistorySize);
+}
+
+void Vehicle::writeHistory(std::ostream &os) const {
+    if(mJournal) {
+        mJournal->write(os, mLastRecord, mHistorySize);
+    }
+}
+
+void Vehicle::writeNewHistory(std::ostream &os) {
+    if(mJournal && mLoggedHistory < mHistorySize) {
+        // positions count from one, like the events in the full history
+        os << "New history, events " << mLoggedHistory + 1 << " to "
+           << mHistorySize << ":" << std::endl;
+        mJournal->write(os, mLastRecord, mHistorySize - mLoggedHistory);
+        mLoggedHistory = mHistorySize;
+    }
+}
+
+void Vehicle::truncateHistory(const std::size_t &size) {
+    if(mJournal && size < mHistorySize) {
+        // step back past the forgotten records
+        mLastRecord = mJournal->getPrevious(mLastRecord, mHistorySize - size);
+        mHistorySize = size;
+        mLoggedHistory = std::min(mLoggedHistory, size);
+    }
 }
 
 std::string Coach::getInfo() const {
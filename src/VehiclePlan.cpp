@@ -0,0 +1,260 @@
+/*
+ * VehiclePlan.cpp
+ * Project
+ * Albin Ågren
+ */
+
+#include "VehiclePlan.h"
+#include "MinCostFlow.h"
+#include "Station.h"
+#include "Train.h"
+#include "Vehicle.h"
+
+#include <vector>
+#include <array>
+#include <deque>
+#include <memory>
+#include <algorithm>
+
+namespace {
+
+// Struct representing the assembly or disassembly of a train at a station,
+// the events are ordered as the simulation orders them
+struct PlanEvent {
+    int time;
+    int trainNumber;
+    unsigned train;
+    unsigned station;
+    bool assembly;
+};
+
+using Needs = std::array<unsigned, Station::VEHICLE_TYPES>;
+
+// Plans one vehicle type and leaves out the trains it can not fully supply,
+// returns the number of trains left out
+unsigned planType(const int &type, const unsigned &stations,
+                  const std::vector<PlanEvent> &events,
+                  const std::vector<Needs> &pools,
+                  const std::vector<Needs> &needs,
+                  std::vector<char> &active, unsigned long &phases) {
+    // the source, a node holding each station's pool, the events of the
+    // trains that need the type and the sink
+    std::vector<unsigned> nodes(events.size(), VehiclePlan::NONE);
+    unsigned count = 1 + stations;
+    for(std::size_t i = 0; i < events.size(); ++i) {
+        if(active[events[i].train] && needs[events[i].train][type] > 0) {
+            nodes[i] = count++;
+        }
+    }
+    unsigned sink = count++;
+
+    MinCostFlow flow(count);
+    flow.reserve(4 * stations + 3 * (count - stations));
+    for(unsigned station = 0; station < stations; ++station) {
+        if(pools[station][type] > 0) {
+            flow.addArc(0, 1 + station, pools[station][type], 0);
+            flow.addArc(1 + station, sink, MinCostFlow::UNLIMITED, 0);
+        }
+    }
+
+    // vehicles wait at a station from one event to the next and trains
+    // carry them from assembly to disassembly, the pool reaches every
+    // assembly and every disassembly reaches the sink directly, which keeps
+    // the paths the solver follows short
+    std::vector<unsigned> last(stations);
+    for(unsigned station = 0; station < stations; ++station) {
+        last[station] = 1 + station;
+    }
+    std::vector<unsigned> assemblies(needs.size(), VehiclePlan::NONE);
+    std::vector<unsigned> arcs;
+    std::vector<unsigned> trains;
+    for(std::size_t i = 0; i < events.size(); ++i) {
+        if(nodes[i] == VehiclePlan::NONE) {
+            continue;
+        }
+        const PlanEvent &event = events[i];
+        unsigned start = 1 + event.station;
+        flow.addArc(last[event.station], nodes[i], MinCostFlow::UNLIMITED, 0);
+        if(event.assembly) {
+            if(pools[event.station][type] > 0 && last[event.station] != start) {
+                flow.addArc(start, nodes[i], MinCostFlow::UNLIMITED, 0);
+            }
+            assemblies[event.train] = nodes[i];
+        } else {
+            arcs.push_back(flow.addArc(assemblies[event.train], nodes[i],
+                                       needs[event.train][type], -1));
+            trains.push_back(event.train);
+            flow.addArc(nodes[i], sink, MinCostFlow::UNLIMITED, 0);
+        }
+        last[event.station] = nodes[i];
+    }
+
+    flow.solve(0, sink);
+    phases += flow.getPhases();
+
+    unsigned excluded = 0;
+    for(std::size_t i = 0; i < arcs.size(); ++i) {
+        if(flow.getFlow(arcs[i]) < needs[trains[i]][type]) {
+            active[trains[i]] = false;
+            ++excluded;
+        }
+    }
+    return excluded;
+}
+
+}   // namespace
+
+void VehiclePlan::build(const std::vector<std::unique_ptr<Station>> &stations,
+                        const std::vector<std::unique_ptr<Train>> &trains,
+                        const std::size_t &vehicles) {
+    mRounds = 0;
+    mPhases = 0;
+    mPlanned = 0;
+
+    // count the vehicles of each type each train needs, trains needing
+    // none or an unknown type are not planned
+    std::vector<Needs> needs(trains.size(), Needs());
+    std::vector<char> active(trains.size(), false);
+    std::vector<PlanEvent> events;
+    events.reserve(2 * trains.size());
+    for(unsigned i = 0; i < trains.size(); ++i) {
+        const Train *train = trains[i].get();
+        bool known = !train->getRequiredVehicles().empty();
+        for(const int &type : train->getRequiredVehicles()) {
+            if(type < 0 || type >= Station::VEHICLE_TYPES) {
+                known = false;
+                break;
+            }
+            ++needs[i][type];
+        }
+
+        int assembly = (train->getOrigDeparture() - Time(0, 30))
+                                                            .getTotalTime();
+        int disassembly = (train->getOrigArrival() + Time(0, 20))
+                                                            .getTotalTime();
+        if(!known || disassembly <= assembly) {
+            continue;
+        }
+        active[i] = true;
+        events.push_back({ assembly, train->getTrainNumber(), i,
+                           train->getOrigin()->getId(), true });
+        events.push_back({ disassembly, train->getTrainNumber(), i,
+                           train->getDestination()->getId(), false });
+    }
+    std::sort(events.begin(), events.end(),
+              [](const PlanEvent &left, const PlanEvent &right) {
+        if(left.time != right.time) {
+            return left.time < right.time;
+        }
+        if(left.trainNumber != right.trainNumber) {
+            return left.trainNumber < right.trainNumber;
+        }
+        return left.train < right.train;
+    });
+
+    std::vector<Needs> pools(stations.size(), Needs());
+    for(const std::unique_ptr<Station> &station : stations) {
+        for(int type = 0; type < Station::VEHICLE_TYPES; ++type) {
+            pools[station->getId()][type] = station->getNoOfVehicles(type);
+        }
+    }
+
+    // plan the types until every train left is fully supplied by each
+    while(mRounds < MAX_ROUNDS) {
+        ++mRounds;
+        unsigned excluded = 0;
+        for(int type = 0; type < Station::VEHICLE_TYPES; ++type) {
+            excluded += planType(type, stations.size(), events, pools, needs,
+                                 active, mPhases);
+        }
+        if(excluded == 0) {
+            break;
+        }
+    }
+
+    // hand out the vehicles in time order, each station's oldest first
+    std::vector<std::deque<unsigned>> queues(stations.size() *
+                                             Station::VEHICLE_TYPES);
+    for(const std::unique_ptr<Station> &station : stations) {
+        std::size_t first = station->getId() * Station::VEHICLE_TYPES;
+        station->forEachVehicle([&queues, &first](const Vehicle *vehicle) {
+            queues[first + vehicle->getType()].push_back(
+                                                    vehicle->getTableRow());
+        });
+    }
+
+    std::vector<std::size_t> starts(trains.size(), 0);
+    std::vector<unsigned> assigned;
+    std::vector<unsigned> order;
+    for(const PlanEvent &event : events) {
+        if(!active[event.train]) {
+            continue;
+        }
+        const Train *train = trains[event.train].get();
+        std::size_t first = event.station * Station::VEHICLE_TYPES;
+        if(event.assembly) {
+            // a train the earlier trains left short is not planned
+            for(int type = 0; type < Station::VEHICLE_TYPES; ++type) {
+                if(queues[first + type].size() < needs[event.train][type]) {
+                    active[event.train] = false;
+                }
+            }
+            if(!active[event.train]) {
+                continue;
+            }
+            starts[event.train] = assigned.size();
+            for(const int &type : train->getRequiredVehicles()) {
+                assigned.push_back(queues[first + type].front());
+                queues[first + type].pop_front();
+            }
+            order.push_back(event.train);
+        } else {
+            std::size_t count = train->getRequiredVehicles().size();
+            for(std::size_t i = 0; i < count; ++i) {
+                unsigned vehicle = assigned[starts[event.train] + i];
+                int type = train->getRequiredVehicles()[i];
+                queues[first + type].push_back(vehicle);
+            }
+        }
+    }
+
+    // lay out the vehicles of each train and the trains of each vehicle
+    mTrainOffsets.assign(trains.size() + 1, 0);
+    mVehicleOffsets.assign(vehicles + 1, 0);
+    for(const unsigned &train : order) {
+        std::size_t count = trains[train]->getRequiredVehicles().size();
+        mTrainOffsets[train + 1] = count;
+        for(std::size_t i = 0; i < count; ++i) {
+            ++mVehicleOffsets[assigned[starts[train] + i] + 1];
+        }
+    }
+    for(std::size_t i = 0; i < trains.size(); ++i) {
+        mTrainOffsets[i + 1] += mTrainOffsets[i];
+    }
+    for(std::size_t i = 0; i < vehicles; ++i) {
+        mVehicleOffsets[i + 1] += mVehicleOffsets[i];
+    }
+
+    mTrainVehicles.assign(mTrainOffsets.back(), 0);
+    mVehicleTrains.assign(mVehicleOffsets.back(), 0);
+    std::vector<std::size_t> next(mVehicleOffsets.begin(),
+                                  mVehicleOffsets.end() - 1);
+    for(const unsigned &train : order) {
+        std::size_t count = trains[train]->getRequiredVehicles().size();
+        for(std::size_t i = 0; i < count; ++i) {
+            unsigned vehicle = assigned[starts[train] + i];
+            mTrainVehicles[mTrainOffsets[train] + i] = vehicle;
+            mVehicleTrains[next[vehicle]++] = train;
+        }
+    }
+    mPlanned = order.size();
+}
+
+unsigned VehiclePlan::getTrain(const std::size_t &vehicle,
+                               const unsigned &position) const {
+    if(vehicle + 1 >= mVehicleOffsets.size()) {
+        return NONE;
+    }
+    std::size_t i = mVehicleOffsets[vehicle] + position;
+    return i < mVehicleOffsets[vehicle + 1] ? mVehicleTrains[i] : NONE;
+}
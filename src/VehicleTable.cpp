@@ -0,0 +1,117 @@
+/*
+ * VehicleTable.cpp
+ * Project
+ * Albin Ågren
+ */
+
+#include "VehicleTable.h"
+
+#include <vector>
+#include <stdexcept>
+
+void VehicleTable::reserve(const std::size_t &vehicles) {
+    mIds.reserve(vehicles);
+    mTypes.reserve(vehicles);
+    mSeats.reserve(vehicles);
+    mInternet.reserve(vehicles);
+    mBeds.reserve(vehicles);
+    mCargoCapacity.reserve(vehicles);
+    mCargoArea.reserve(vehicles);
+    mCargoVolume.reserve(vehicles);
+    mTopSpeed.reserve(vehicles);
+    mPower.reserve(vehicles);
+    mFuelConsumption.reserve(vehicles);
+    mTrains.reserve(vehicles);
+    mStations.reserve(vehicles);
+}
+
+std::size_t VehicleTable::addVehicle(const int &id, const int &type,
+                                     const int &param0, const int &param1) {
+    // if type out of range, throw error
+    if(type < 0 || type > 5) {
+        throw std::runtime_error("datafile corrupted");
+    }
+
+    // place the parameters in the columns of the type, as the vehicle
+    // classes do
+    mIds.push_back(id);
+    mTypes.push_back(type);
+    mSeats.push_back(type == 0 ? param0 : 0);
+    mInternet.push_back(type == 0 && param1);
+    mBeds.push_back(type == 1 ? param0 : 0);
+    mCargoCapacity.push_back(type == 2 ? param0 : 0);
+    mCargoArea.push_back(type == 2 ? param1 : 0);
+    mCargoVolume.push_back(type == 3 ? param0 : 0);
+    mTopSpeed.push_back(type == 4 || type == 5 ? param0 : 0);
+    mPower.push_back(type == 4 ? param1 : 0);
+    mFuelConsumption.push_back(type == 5 ? param1 : 0);
+    mTrains.push_back(NONE);
+    mStations.push_back(NONE);
+
+    return mIds.size() - 1;
+}
+
+FleetTotals VehicleTable::getTotals() const {
+    FleetTotals totals = { static_cast<unsigned>(mIds.size()),
+                           0, 0, 0, 0, 0, 0 };
+    for(std::size_t i = 0; i < mIds.size(); ++i) {
+        totals.seats += mSeats[i];
+        totals.beds += mBeds[i];
+        totals.cargoCapacity += mCargoCapacity[i];
+        totals.cargoArea += mCargoArea[i];
+        totals.cargoVolume += mCargoVolume[i];
+        totals.power += mPower[i];
+    }
+    return totals;
+}
+
+std::vector<FleetTotals> VehicleTable::getTotalsPerStation(
+                                        const unsigned &stations) const {
+    std::vector<FleetTotals> totals(stations, { 0, 0, 0, 0, 0, 0, 0 });
+    for(std::size_t i = 0; i < mIds.size(); ++i) {
+        // skip vehicles out on a train
+        if(mStations[i] < 0 || mStations[i] >= static_cast<int>(stations)) {
+            continue;
+        }
+        FleetTotals &station = totals[mStations[i]];
+        ++station.vehicles;
+        station.seats += mSeats[i];
+        station.beds += mBeds[i];
+        station.cargoCapacity += mCargoCapacity[i];
+        station.cargoArea += mCargoArea[i];
+        station.cargoVolume += mCargoVolume[i];
+        station.power += mPower[i];
+    }
+    return totals;
+}
+
+std::size_t VehicleTable::getMemoryUsage() const {
+    return (mIds.capacity() + mSeats.capacity() + mBeds.capacity() +
+            mCargoCapacity.capacity() + mCargoArea.capacity() +
+            mCargoVolume.capacity() + mPower.capacity() +
+            mFuelConsumption.capacity() + mTrains.capacity() +
+            mStations.capacity()) * sizeof(int) +
+           mTypes.capacity() + mInternet.capacity() +
+           mTopSpeed.capacity() * sizeof(double);
+}
+
+FleetTotals VehicleTable::sumWhere(const std::vector<int> &location,
+                                   const int &value) const {
+    long long vehicles = 0, seats = 0, beds = 0, capacity = 0, area = 0,
+              volume = 0, power = 0;
+
+    // mask every row rather than branch, so the loop runs on vector lanes
+    for(std::size_t i = 0; i < mIds.size(); ++i) {
+        int match = -static_cast<int>(location[i] == value);
+        vehicles -= match;
+        seats += mSeats[i] & match;
+        beds += mBeds[i] & match;
+        capacity += mCargoCapacity[i] & match;
+        area += mCargoArea[i] & match;
+        volume += mCargoVolume[i] & match;
+        power += mPower[i] & match;
+    }
+
+    return { static_cast<unsigned>(vehicles), seats, beds, capacity, area,
+             volume, power };
+}
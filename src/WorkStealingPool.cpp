@@ -0,0 +1,122 @@
+/*
+ * WorkStealingPool.cpp
+ * Project
+ * Albin Ågren
+ */
+
+#include "WorkStealingPool.h"
+
+#include <vector>
+#include <deque>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <utility>
+
+WorkStealingPool::WorkStealingPool(const unsigned &threads): mQueued(0),
+                                                             mPending(0),
+                                                             mNext(0),
+                                                             mStopping(false),
+                                                             mSteals(0) {
+    unsigned workers = threads > 0 ? threads : 1;
+    for(unsigned i = 0; i < workers; ++i) {
+        mWorkers.push_back(std::make_unique<Worker>());
+    }
+    for(unsigned i = 0; i < workers; ++i) {
+        mThreads.emplace_back(&WorkStealingPool::work, this, i);
+    }
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    wait();
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mStopping = true;
+    }
+    mTaskAvailable.notify_all();
+    for(std::thread &thread : mThreads) {
+        thread.join();
+    }
+}
+
+void WorkStealingPool::submit(Task task) {
+    unsigned index;
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        index = mNext;
+        mNext = (mNext + 1) % mWorkers.size();
+        ++mPending;
+    }
+
+    // push before counting it as queued, so a worker woken for it finds it
+    {
+        std::lock_guard<std::mutex> lock(mWorkers[index]->mutex);
+        mWorkers[index]->tasks.push_back(std::move(task));
+    }
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        ++mQueued;
+    }
+    mTaskAvailable.notify_one();
+}
+
+void WorkStealingPool::wait() {
+    std::unique_lock<std::mutex> lock(mMutex);
+    mAllDone.wait(lock, [this] { return mPending == 0; });
+}
+
+void WorkStealingPool::work(const unsigned &index) {
+    Task task;
+    while(true) {
+        {
+            // sleep until a task is queued anywhere or the pool stops
+            std::unique_lock<std::mutex> lock(mMutex);
+            mTaskAvailable.wait(lock, [this] {
+                return mQueued > 0 || mStopping;
+            });
+            if(mQueued == 0) {
+                return;
+            }
+            --mQueued;
+        }
+
+        // a task is reserved for this worker, so one is bound to be found
+        while(!take(index, task)) {
+            std::this_thread::yield();
+        }
+        task(index);
+        task = nullptr;
+
+        std::lock_guard<std::mutex> lock(mMutex);
+        if(--mPending == 0) {
+            mAllDone.notify_all();
+        }
+    }
+}
+
+bool WorkStealingPool::take(const unsigned &index, Task &task) {
+    // newest task of the own deque first
+    {
+        Worker &own = *mWorkers[index];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if(!own.tasks.empty()) {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            return true;
+        }
+    }
+
+    // otherwise the oldest task of another worker
+    for(unsigned i = 1; i < mWorkers.size(); ++i) {
+        Worker &victim = *mWorkers[(index + i) % mWorkers.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if(!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            ++mSteals;
+            return true;
+        }
+    }
+    return false;
+}
@@ -1,7 +1,25 @@
 #include "UserInterface.h"
 
-int main() {
+#include <string>
+#include <vector>
+
+/*
+ * Runs the interactive user interface, or with
+ *   --batch [options]
+ * the simulation without prompts, see UserInterface::runBatch, or with
+ *   --ensemble [options]
+ * a Monte Carlo ensemble of the scenario with random departure delays, see
+ * UserInterface::runEnsemble
+ */
+int main(int argc, char *argv[]) {
     UserInterface ui;
+    if(argc > 1 && std::string(argv[1]) == "--ensemble") {
+        return ui.runEnsemble(std::vector<std::string>(argv + 2,
+                                                       argv + argc));
+    }
+    if(argc > 1 && std::string(argv[1]) == "--batch") {
+        return ui.runBatch(std::vector<std::string>(argv + 2, argv + argc));
+    }
     ui.runStartMenu();
     return 0;
 }
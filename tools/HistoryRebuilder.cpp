@@ -0,0 +1,125 @@
+/*
+ * HistoryRebuilder.cpp
+ * Project
+ * Albin Ågren
+ *
+ * Rebuilds the full history of every vehicle from a log written at the high
+ * level with only new vehicle history. Each vehicle line in the log may be
+ * followed by the events added since the vehicle was last logged, headed by
+ * their positions in its history. The events are appended in order and a gap
+ * or overlap in the positions is reported as an error. Prints the history of
+ * the chosen vehicle, or of every vehicle in id order.
+ *
+ * Usage: HistoryRebuilder <log file> [vehicle id]
+ */
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <map>
+#include <stdexcept>
+#include <cstdlib>
+
+namespace {
+
+// Finds the id of a vehicle line, "[Type] id: N, ...", or returns false
+bool parseVehicleLine(const std::string &line, int &id) {
+    const std::string marker = "] id: ";
+    std::size_t position = line.find(marker);
+    if(line.empty() || line[0] != '[' || position == std::string::npos) {
+        return false;
+    }
+    try {
+        id = std::stoi(line.substr(position + marker.size()));
+    } catch(const std::exception &) {
+        return false;
+    }
+    return true;
+}
+
+// Finds the positions of a "New history, events A to B:" line, or returns
+// false
+bool parseHistoryLine(const std::string &line, std::size_t &first,
+                      std::size_t &last) {
+    const std::string marker = "New history, events ";
+    if(line.compare(0, marker.size(), marker) != 0) {
+        return false;
+    }
+    try {
+        std::size_t end;
+        first = std::stoul(line.substr(marker.size()), &end);
+        std::size_t to = line.find(" to ", marker.size() + end);
+        if(to == std::string::npos) {
+            return false;
+        }
+        last = std::stoul(line.substr(to + 4));
+    } catch(const std::exception &) {
+        return false;
+    }
+    return first >= 1 && last >= first;
+}
+
+}   // namespace
+
+int main(int argc, char *argv[]) {
+    if(argc < 2) {
+        std::cerr << "Usage: HistoryRebuilder <log file> [vehicle id]"
+                  << std::endl;
+        return 2;
+    }
+
+    std::ifstream log(argv[1]);
+    if(!log) {
+        std::cerr << "Error: log file failed to open" << std::endl;
+        return 1;
+    }
+
+    std::map<int, std::vector<std::string>> histories;
+    std::string line;
+    unsigned long lineNumber = 0;
+    int vehicle = 0;
+    bool afterVehicle = false;
+    while(std::getline(log, line)) {
+        ++lineNumber;
+        std::size_t first, last;
+        if(parseVehicleLine(line, vehicle)) {
+            afterVehicle = true;
+        } else if(afterVehicle && parseHistoryLine(line, first, last)) {
+            // the new events must continue the history rebuilt so far
+            std::vector<std::string> &history = histories[vehicle];
+            if(first != history.size() + 1) {
+                std::cerr << "Error: line " << lineNumber << ": vehicle "
+                          << vehicle << " continues at event " << first
+                          << " after " << history.size() << " events"
+                          << std::endl;
+                return 1;
+            }
+            for(std::size_t i = first; i <= last; ++i) {
+                if(!std::getline(log, line)) {
+                    std::cerr << "Error: log ends inside the history of "
+                              << "vehicle " << vehicle << std::endl;
+                    return 1;
+                }
+                ++lineNumber;
+                history.push_back(line);
+            }
+            afterVehicle = false;
+        } else {
+            afterVehicle = false;
+        }
+    }
+
+    // print the chosen vehicle, or all of them
+    for(const auto &entry : histories) {
+        if(argc > 2 && entry.first != std::atoi(argv[2])) {
+            continue;
+        }
+        std::cout << "Vehicle " << entry.first << ":" << std::endl;
+        for(const std::string &event : entry.second) {
+            std::cout << event << std::endl;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,351 @@
+/*
+ * ScenarioGenerator.cpp
+ * Project
+ * Albin Ågren
+ *
+ * Writes a synthetic scenario, TrainStations.txt, TrainMap.txt and
+ * Trains.txt in the formats read by the controller, for testing the
+ * simulation at scale. The same options and seed always give the same files.
+ *
+ * Usage: ScenarioGenerator <output directory> [--stations N] [--density D]
+ *        [--fleet N | --fleet N0,N1,N2,N3,N4,N5] [--trains N] [--seed S]
+ *        [--remote R]
+ *
+ * With --remote a share R of the trains run between any two stations, over
+ * the shortest route, instead of along a single link.
+ */
+
+#include "Router.h"
+#include "DistanceTable.h"
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <cmath>
+#include <stdexcept>
+#include <algorithm>
+
+namespace {
+
+// Number of vehicle types, coaches, sleepers, open and covered wagons,
+// electric and diesel locomotives
+constexpr int VEHICLE_TYPES = 6;
+
+/*
+ * Random number generator (splitmix64), used instead of the standard
+ * distributions so the output is the same with every standard library
+ */
+class Random {
+public:
+    explicit Random(const unsigned long long &seed): mState(seed) { }
+
+    unsigned long long next() {
+        unsigned long long value = (mState += 0x9e3779b97f4a7c15ull);
+        value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ull;
+        value = (value ^ (value >> 27)) * 0x94d049bb133111ebull;
+        return value ^ (value >> 31);
+    }
+
+    // Returns an integer between low and high, both included
+    long long between(const long long &low, const long long &high) {
+        return low + static_cast<long long>(next() % (high - low + 1));
+    }
+
+    // Returns a number between 0 and 1
+    double uniform() { return (next() >> 11) * (1.0 / (1ull << 53)); }
+
+private:
+    unsigned long long mState;
+};
+
+struct Options {
+    std::string directory;
+    unsigned long stations = 6;
+    double density = 1.0;
+    std::vector<unsigned long long> fleet;
+    unsigned long long trains = 129;
+    unsigned long long seed = 1;
+    double remote = 0;
+};
+
+struct Edge {
+    unsigned long station0, station1;
+    int distance;
+};
+
+std::string stationName(const unsigned long &index) {
+    return "Station" + std::to_string(index + 1);
+}
+
+std::string formatTime(const int &minutes) {
+    std::ostringstream ss;
+    ss << minutes / 600 << minutes / 60 % 10 << ":"
+       << minutes % 60 / 10 << minutes % 10;
+    return ss.str();
+}
+
+/*
+ * Writes the stations with their vehicle pools, each vehicle is placed at
+ * a random station and given parameters in the ranges of the shipped data
+ */
+void writeStations(const Options &options, Random &random) {
+    std::ofstream outFile(options.directory + "TrainStations.txt");
+    if(outFile.fail()) {
+        throw std::runtime_error("station file failed to open");
+    }
+
+    // count the vehicles of each type at each station
+    std::vector<std::vector<unsigned long long>> counts(
+            options.stations,
+            std::vector<unsigned long long>(VEHICLE_TYPES, 0));
+    for(int type = 0; type < VEHICLE_TYPES; ++type) {
+        for(unsigned long long i = 0; i < options.fleet[type]; ++i) {
+            ++counts[random.between(0, options.stations - 1)][type];
+        }
+    }
+
+    unsigned long long id = 1;
+    for(unsigned long station = 0; station < options.stations; ++station) {
+        outFile << stationName(station);
+
+        // the vehicle list follows the name after a single space
+        unsigned long long total = 0;
+        for(const unsigned long long &count : counts[station]) {
+            total += count;
+        }
+        if(total > 0) {
+            outFile << " ";
+        }
+        for(int type = 0; type < VEHICLE_TYPES; ++type) {
+            for(unsigned long long i = 0; i < counts[station][type]; ++i) {
+                outFile << "(" << id++ << " " << type << " ";
+                switch(type) {
+                    case 0:     // chairs, internet
+                        outFile << random.between(80, 105) << " "
+                                << random.between(0, 1);
+                        break;
+                    case 1:     // beds
+                        outFile << random.between(19, 28);
+                        break;
+                    case 2:     // load capacity, load area
+                        outFile << random.between(37, 58) << " "
+                                << random.between(29, 40);
+                        break;
+                    case 3:     // load volume
+                        outFile << random.between(97, 142);
+                        break;
+                    case 4:     // max speed, power
+                        outFile << random.between(215, 235) << " "
+                                << random.between(4500, 5000);
+                        break;
+                    case 5:     // max speed, fuel consumption
+                        outFile << random.between(215, 235) << " "
+                                << random.between(550, 650);
+                        break;
+                }
+                outFile << ")";
+            }
+        }
+        outFile << "\n";
+    }
+}
+
+/*
+ * Writes the distances, stations are linked in a ring so every station can
+ * be reached and any other pair is linked with the chosen density
+ */
+std::vector<Edge> writeDistances(const Options &options, Random &random) {
+    std::ofstream outFile(options.directory + "TrainMap.txt");
+    if(outFile.fail()) {
+        throw std::runtime_error("map file failed to open");
+    }
+
+    std::vector<Edge> edges;
+    for(unsigned long i = 0; i < options.stations; ++i) {
+        for(unsigned long j = i + 1; j < options.stations; ++j) {
+            bool ring = j == i + 1 || (i == 0 && j == options.stations - 1);
+            if(ring || random.uniform() < options.density) {
+                edges.push_back({ i, j,
+                                  static_cast<int>(random.between(30, 230)) });
+                outFile << stationName(i) << " " << stationName(j) << " "
+                        << edges.back().distance << "\n";
+            }
+        }
+    }
+    return edges;
+}
+
+/*
+ * Writes the trains, each runs along a random link, or between two random
+ * stations for the remote share, during the day with a timetable it can keep
+ * at 60 to 80 percent of its top speed
+ */
+void writeTrains(const Options &options, const std::vector<Edge> &edges,
+                 Random &random) {
+    std::ofstream outFile(options.directory + "Trains.txt");
+    if(outFile.fail()) {
+        throw std::runtime_error("train file failed to open");
+    }
+
+    // route remote trains over the links
+    Router router;
+    if(options.remote > 0) {
+        std::vector<Link> links;
+        for(const Edge &edge : edges) {
+            links.push_back({ static_cast<unsigned>(edge.station0),
+                              static_cast<unsigned>(edge.station1),
+                              static_cast<double>(edge.distance) });
+        }
+        router.build(options.stations, links);
+    }
+
+    for(unsigned long long number = 1; number <= options.trains; ++number) {
+        unsigned long origin, destination;
+        double distance;
+        if(options.remote > 0 && random.uniform() < options.remote) {
+            origin = random.between(0, options.stations - 1);
+            destination = random.between(0, options.stations - 2);
+            destination += destination >= origin;
+            distance = router.getDistance(origin, destination);
+        } else {
+            const Edge &edge = edges[random.between(0, edges.size() - 1)];
+            bool reverse = random.between(0, 1) == 1;
+            origin = reverse ? edge.station1 : edge.station0;
+            destination = reverse ? edge.station0 : edge.station1;
+            distance = edge.distance;
+        }
+        int topSpeed = random.between(160, 210);
+        double speed = topSpeed * (0.6 + 0.2 * random.uniform());
+        int travelTime = std::ceil(distance / speed * 60);
+
+        // depart early enough to be assembled and to arrive the same day,
+        // routes too long for a day run overnight
+        int departure = random.between(30, std::max(30, 24 * 60 - 1
+                                                        - travelTime));
+
+        outFile << number << " " << stationName(origin) << " "
+                << stationName(destination) << " "
+                << formatTime(departure) << " "
+                << formatTime(departure + travelTime) << " " << topSpeed;
+
+        // a locomotive with a few vehicles of one kind, sometimes with a
+        // second locomotive at the back
+        int locomotive = random.between(4, 5);
+        int type = random.between(0, 3);
+        int vehicles = random.between(0, 4);
+        outFile << " " << locomotive;
+        for(int i = 0; i < vehicles; ++i) {
+            outFile << " " << type;
+        }
+        if(random.between(0, 4) == 0) {
+            outFile << " " << locomotive;
+        }
+        outFile << "\n";
+    }
+}
+
+/*
+ * Reads the options, exits with a message on invalid input
+ */
+Options readOptions(int argc, char *argv[]) {
+    if(argc < 2 || std::string(argv[1]).rfind("--", 0) == 0) {
+        throw std::invalid_argument("missing output directory");
+    }
+
+    Options options;
+    options.directory = argv[1];
+    if(options.directory.back() != '/') {
+        options.directory += '/';
+    }
+
+    for(int i = 2; i < argc; i += 2) {
+        std::string option = argv[i];
+        if(i + 1 >= argc) {
+            throw std::invalid_argument("missing value for " + option);
+        }
+        std::string value = argv[i + 1];
+
+        if(option == "--stations") {
+            options.stations = std::stoul(value);
+        } else if(option == "--density") {
+            options.density = std::stod(value);
+        } else if(option == "--trains") {
+            options.trains = std::stoull(value);
+        } else if(option == "--remote") {
+            options.remote = std::stod(value);
+        } else if(option == "--seed") {
+            options.seed = std::stoull(value);
+        } else if(option == "--fleet") {
+            // a single size for all types or one size per type
+            std::stringstream ss(value);
+            std::string size;
+            options.fleet.clear();
+            while(std::getline(ss, size, ',')) {
+                options.fleet.push_back(std::stoull(size));
+            }
+            if(options.fleet.size() == 1) {
+                options.fleet.assign(VEHICLE_TYPES, options.fleet.front());
+            } else if(options.fleet.size() != VEHICLE_TYPES) {
+                throw std::invalid_argument("fleet needs 1 or 6 sizes");
+            }
+        } else {
+            throw std::invalid_argument("unknown option " + option);
+        }
+    }
+
+    if(options.stations < 2) {
+        throw std::invalid_argument("at least 2 stations are needed");
+    }
+    if(options.density < 0 || options.density > 1) {
+        throw std::invalid_argument("density must be between 0 and 1");
+    }
+    if(options.remote < 0 || options.remote > 1) {
+        throw std::invalid_argument("remote share must be between 0 and 1");
+    }
+
+    // by default enough vehicles that most trains can be assembled
+    if(options.fleet.empty()) {
+        options.fleet.assign(VEHICLE_TYPES, options.trains * 3 / 4 + 1);
+    }
+    return options;
+}
+
+}   // namespace
+
+int main(int argc, char *argv[]) {
+    try {
+        Options options = readOptions(argc, argv);
+
+        // separate streams so changing one file's options leaves the others
+        Random stationRandom(options.seed);
+        Random mapRandom(options.seed + 1);
+        Random trainRandom(options.seed + 2);
+
+        writeStations(options, stationRandom);
+        std::vector<Edge> edges = writeDistances(options, mapRandom);
+        writeTrains(options, edges, trainRandom);
+
+        unsigned long long vehicles = 0;
+        for(const unsigned long long &size : options.fleet) {
+            vehicles += size;
+        }
+        std::cout << "Wrote " << options.stations << " stations, "
+                  << edges.size() << " links, " << vehicles << " vehicles and "
+                  << options.trains << " trains to " << options.directory
+                  << std::endl;
+    } catch(std::invalid_argument &ia) {
+        std::cout << "Error: " << ia.what() << std::endl
+                  << "Usage: ScenarioGenerator <output directory> "
+                  << "[--stations N] [--density D]" << std::endl
+                  << "       [--fleet N | --fleet N0,N1,N2,N3,N4,N5] "
+                  << "[--trains N] [--seed S] [--remote R]" << std::endl;
+        return 2;
+    } catch(std::exception &e) {
+        std::cout << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}